@@ -5,18 +5,70 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <vector>
+
+namespace cfg_analyzer_helper
+{
+    // symbol id -> whether it derives epsilon, a worklist over the productions (each one is visited once per rhs symbol)
+    std::vector<uint8_t> compute_nullable(const cfg_model::IndexedGrammar &grammar);
+
+    // DeRemer & Pennello digraph traversal: on return sets[x] = sets[x] | union of sets[y] for every y reachable from x
+    // each edge is followed once, nodes of one strongly connected component end up with the same set
+    void propagate_over_digraph(const std::vector<std::vector<uint32_t>> &edges, std::vector<cfg_model::TerminalSet> &sets);
+
+    // strongly connected components of a digraph, listed so that every component comes after the components it has edges to
+    struct Condensation
+    {
+        std::vector<uint32_t> component_of;              // node -> component
+        std::vector<std::vector<uint32_t>> components;   // component -> nodes
+        std::vector<std::vector<uint32_t>> successors;   // component -> components it has edges to (sorted, no self edges)
+        std::vector<std::vector<uint32_t>> levels;       // level -> components, a component only depends on lower levels
+    };
+    Condensation condense_digraph(const std::vector<std::vector<uint32_t>> &edges);
+
+    // same result as propagate_over_digraph, computed component by component over the condensation
+    // the components of one level are independent and are spread over thread_count threads (0 means hardware concurrency)
+    void propagate_over_condensation(const std::vector<std::vector<uint32_t>> &edges, std::vector<cfg_model::TerminalSet> &sets, unsigned thread_count);
+}
 
 class CFGAnalyzer
 {
+public:
+    // how the FIRST/FOLLOW inclusion graphs are solved, the results are identical
+    enum class AnalysisMode
+    {
+        SEQUENTIAL, // single digraph traversal
+        PARALLEL,   // SCC condensation, components of the same topological level in parallel
+    };
+
 private:
+    AnalysisMode analysis_mode = AnalysisMode::SEQUENTIAL;
+    unsigned analysis_thread_count = 0;
+
     cfg_model::CFG cfg;
     cfg_model::FirstSet first_set;
     cfg_model::FollowSet follow_set;
 
+    // the analysis runs on symbol ids and terminal bitsets, the symbol-keyed sets above are filled from these at the end
+    cfg_model::IndexedGrammar grammar;
+    std::vector<uint32_t> terminal_bits;              // symbol id -> terminal bit, invalid_symbol_id for non-terminals
+    std::vector<uint8_t> nullable;                    // symbol id -> derives epsilon
+    std::vector<cfg_model::TerminalSet> first_bits;   // symbol id -> FIRST
+    std::vector<cfg_model::TerminalSet> follow_bits;  // symbol id -> FOLLOW
+
+    // FIRST of every production suffix rhs[dot..], slot = suffix_offsets[production] + dot
+    std::unordered_map<cfg_model::symbol, std::unordered_map<std::vector<cfg_model::symbol>, uint32_t>> production_indices;
+    std::vector<uint32_t> suffix_offsets;
+    std::vector<cfg_model::TerminalSet> suffix_first;
+    std::vector<uint8_t> suffix_nullable;
+
 public:
     CFGAnalyzer(const cfg_model::CFG &cfg);
     ~CFGAnalyzer();
 
+    // Select sequential or parallel propagation, thread_count is only used in parallel mode (0 means hardware concurrency)
+    void setAnalysisMode(AnalysisMode mode, unsigned thread_count = 0);
+
     // Compute the first set for the CFG
     void computeFirstSet();
 
@@ -28,6 +80,26 @@ public:
 
     // Get the follow set
     const cfg_model::FollowSet &getFollowSet() const;
+
+    // Get the id-level grammar the analysis runs on
+    const cfg_model::IndexedGrammar &getIndexedGrammar() const;
+
+    // Compute FIRST(β) and whether β derives epsilon for every suffix β of every production, needs the first set
+    void computeSuffixFirstSets();
+
+    // Get the index of the production lhs -> rhs (empty rhs for epsilon), invalid_symbol_id if it does not exist
+    uint32_t getProductionIndex(const cfg_model::symbol &lhs, const std::vector<cfg_model::symbol> &rhs) const;
+
+    // Get FIRST(rhs[dot..]) of a production as terminal bits, dot may be rhs.size() (the empty suffix)
+    const cfg_model::TerminalSet &getSuffixFirst(uint32_t production_index, size_t dot) const;
+
+    // Check whether rhs[dot..] of a production derives epsilon
+    bool isSuffixNullable(uint32_t production_index, size_t dot) const;
+
+    // terminal <-> bit mapping shared by every TerminalSet of this analyzer
+    size_t getTerminalCount() const;
+    uint32_t getTerminalBit(const cfg_model::symbol &terminal) const; // invalid_symbol_id if not a terminal
+    const cfg_model::symbol &getTerminalOfBit(size_t bit) const;
 };
 
 #endif // !CFG_ANALYZER_H
\ No newline at end of file
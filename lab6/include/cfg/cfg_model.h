@@ -6,6 +6,9 @@
 #include <unordered_set>
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
 #include <functional> // Required for std::hash
 
 namespace cfg_model
@@ -73,6 +76,53 @@ namespace std
 } // namespace std
 
 namespace cfg_model {
+    // dense integer ids for grammar symbols
+    using symbol_id = uint32_t;
+    constexpr symbol_id invalid_symbol_id = std::numeric_limits<symbol_id>::max();
+
+    // assigns each symbol a dense id once, string names are only needed at I/O boundaries
+    class SymbolInterner
+    {
+    public:
+        // get the id of a symbol, assigning the next free id if it is new
+        symbol_id intern(const symbol &s);
+        // get the id of a symbol, invalid_symbol_id if it is unknown
+        symbol_id id_of(const symbol &s) const;
+        bool contains(const symbol &s) const { return symbol_to_id.find(s) != symbol_to_id.end(); }
+        const symbol &symbol_of(symbol_id id) const { return id_to_symbol.at(id); }
+        const std::vector<symbol> &symbols() const { return id_to_symbol; }
+        size_t size() const { return id_to_symbol.size(); }
+        bool empty() const { return id_to_symbol.empty(); }
+
+    private:
+        std::vector<symbol> id_to_symbol;
+        std::unordered_map<symbol, symbol_id> symbol_to_id;
+    };
+
+    // dense integer ids for productions, what reduce actions and the semantic info refer to
+    using production_id = uint32_t;
+    constexpr production_id invalid_production_id = std::numeric_limits<production_id>::max();
+
+    // numbers each production once, epsilon productions have an empty rhs
+    class ProductionNumbering
+    {
+    public:
+        // get the id of a production, assigning the next free id if it is new
+        production_id number(const symbol &lhs, const std::vector<symbol> &rhs);
+        // get the id of a production, invalid_production_id if it is unknown
+        production_id id_of(const symbol &lhs, const std::vector<symbol> &rhs) const;
+        bool contains(const symbol &lhs, const std::vector<symbol> &rhs) const { return id_of(lhs, rhs) != invalid_production_id; }
+        const symbol &lhs_of(production_id id) const { return id_to_lhs.at(id); }
+        const std::vector<symbol> &rhs_of(production_id id) const { return id_to_rhs.at(id); }
+        size_t size() const { return id_to_lhs.size(); }
+        bool empty() const { return id_to_lhs.empty(); }
+
+    private:
+        std::vector<symbol> id_to_lhs;
+        std::vector<std::vector<symbol>> id_to_rhs;
+        std::unordered_map<symbol, std::unordered_map<std::vector<symbol>, production_id>> production_to_id;
+    };
+
     struct CFG
     {
         cfg_model::symbol start_symbol;
@@ -80,6 +130,108 @@ namespace cfg_model {
         std::unordered_set<cfg_model::symbol> non_terminals;
         std::unordered_map<cfg_model::symbol, std::unordered_set<std::vector<cfg_model::symbol>>> production_rules;
         std::unordered_set<cfg_model::symbol> epsilon_production_symbols;
+        // symbol ids, assigned by the loader in declaration order
+        // may be incomplete for hand-built or edited CFGs, cfg_model_helper::intern_cfg_symbols completes it
+        SymbolInterner symbol_interner;
+        // production ids, assigned by the loader in declaration order, completed like the symbol ids
+        // by cfg_model_helper::number_cfg_productions
+        ProductionNumbering production_numbering;
+    };
+
+    // id-level view of a CFG used by the analysis & table generation internals
+    struct IndexedProduction
+    {
+        symbol_id lhs = invalid_symbol_id;
+        std::vector<symbol_id> rhs; // empty for epsilon productions
+    };
+    struct IndexedGrammar
+    {
+        SymbolInterner interner;
+        symbol_id start_symbol = invalid_symbol_id;
+        symbol_id end_symbol = invalid_symbol_id;             // the terminal with special property END, if any
+        std::vector<uint8_t> is_terminal;                      // indexed by symbol id
+        std::vector<symbol_id> terminals;                      // ascending ids
+        std::vector<symbol_id> non_terminals;                  // ascending ids
+        std::vector<IndexedProduction> productions;            // ordered by (lhs, rhs)
+        std::vector<std::vector<uint32_t>> productions_by_lhs; // symbol id -> production indices
+    };
+
+    // fixed-size set of terminals, one bit per terminal index (not per symbol id)
+    class TerminalSet
+    {
+    public:
+        TerminalSet() = default;
+        explicit TerminalSet(size_t bit_count) : bit_count(bit_count), words((bit_count + 63) / 64, 0) {}
+
+        size_t size() const { return bit_count; }
+        void set(size_t bit) { words[bit >> 6] |= uint64_t(1) << (bit & 63); }
+        bool test(size_t bit) const { return (words[bit >> 6] >> (bit & 63)) & 1; }
+        void clear() { std::fill(words.begin(), words.end(), 0); }
+        bool any() const
+        {
+            for (const auto word : words)
+            {
+                if (word != 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        size_t count() const
+        {
+            size_t result = 0;
+            for (const auto word : words)
+            {
+                result += static_cast<size_t>(__builtin_popcountll(word));
+            }
+            return result;
+        }
+        // this |= other, returns true if a bit was added
+        bool union_with(const TerminalSet &other)
+        {
+            uint64_t added = 0;
+            for (size_t i = 0; i < words.size(); ++i)
+            {
+                uint64_t merged = words[i] | other.words[i];
+                added |= merged ^ words[i];
+                words[i] = merged;
+            }
+            return added != 0;
+        }
+        // (this & other) is not empty
+        bool intersects(const TerminalSet &other) const
+        {
+            for (size_t i = 0; i < words.size(); ++i)
+            {
+                if ((words[i] & other.words[i]) != 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        // call f(bit) for every set bit in ascending order
+        template <typename F>
+        void for_each(F &&f) const
+        {
+            for (size_t i = 0; i < words.size(); ++i)
+            {
+                uint64_t word = words[i];
+                while (word != 0)
+                {
+                    f(i * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+        bool operator==(const TerminalSet &other) const { return words == other.words; }
+        bool operator!=(const TerminalSet &other) const { return words != other.words; }
+        const std::vector<uint64_t> &data() const { return words; }
+
+    private:
+        size_t bit_count = 0;
+        std::vector<uint64_t> words;
     };
 
     // FIRST set & FOLLOW set
@@ -93,6 +245,39 @@ namespace cfg_model {
         std::unordered_map<cfg_model::symbol, std::unordered_set<cfg_model::symbol>> follow_set;
         cfg_model::symbol end_symbol;
     };
+
+    // what a grammar reduction removed, see cfg_reducer_helper::reduce_cfg
+    struct CFGReductionReport
+    {
+        std::unordered_set<cfg_model::symbol> unproductive_non_terminals; // derive no terminal string
+        std::unordered_set<cfg_model::symbol> unreachable_non_terminals;  // productive, but never reached from the start symbol
+        std::unordered_set<cfg_model::symbol> unreachable_terminals;      // not used by any remaining production
+        size_t removed_production_count = 0;                              // epsilon productions included
+
+        bool empty() const
+        {
+            return unproductive_non_terminals.empty() && unreachable_non_terminals.empty() && unreachable_terminals.empty() && removed_production_count == 0;
+        }
+    };
+    struct CFGReductionResult
+    {
+        CFG reduced_cfg;
+        CFGReductionReport report;
+    };
 } // namespace cfg_model
 
+namespace cfg_model_helper
+{
+    // intern every symbol of the CFG that has no id yet
+    // new symbols are added in a fixed order (start symbol, terminals, non-terminals, each sorted by name)
+    void intern_cfg_symbols(cfg_model::CFG &cfg);
+
+    // number every production of the CFG that has no id yet
+    // new productions are added sorted by lhs name then rhs names, epsilon productions included
+    void number_cfg_productions(cfg_model::CFG &cfg);
+
+    // build the id-level view of a CFG, symbols missing from its interner are interned as above
+    cfg_model::IndexedGrammar build_indexed_grammar(const cfg_model::CFG &cfg);
+} // namespace cfg_model_helper
+
 #endif // !CFG_MODEL_H
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef CFG_REDUCER_H
+#define CFG_REDUCER_H
+
+#include "cfg_model.h"
+#include <string>
+
+namespace cfg_reducer_helper
+{
+    // remove useless symbols: first the non-terminals that derive no terminal string, then everything
+    // (non-terminals and terminals) that can no longer be reached from the start symbol
+    // terminals with a special property (e.g. END) are always kept, the start symbol must stay productive
+    cfg_model::CFGReductionResult reduce_cfg(const cfg_model::CFG &cfg);
+
+    // one-line summary of a reduction report, for logging
+    std::string describe_reduction(const cfg_model::CFGReductionReport &report);
+}
+
+#endif // !CFG_REDUCER_H
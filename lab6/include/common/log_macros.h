@@ -0,0 +1,72 @@
+#ifndef LOG_MACROS_H
+#define LOG_MACROS_H
+
+#include "spdlog/spdlog.h"
+
+// project logging layer over spdlog
+// 1. levels below LAB_LOG_ACTIVE_LEVEL are compiled out, their arguments are still type-checked and
+//    count as used, but never evaluated
+// 2. enabled levels first ask the default logger whether the level is on, arguments are only
+//    evaluated (fmt::join, to_string, ...) if the message will actually be written
+// use these macros in hot loops, plain spdlog calls are fine for one-off messages and errors
+
+// compile-time minimum level, release builds drop trace & debug unless told otherwise
+// override with -DLAB_LOG_ACTIVE_LEVEL=<0..6> (same values as SPDLOG_LEVEL_*)
+#ifndef LAB_LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define LAB_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#else
+#define LAB_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
+#define LAB_LOG_AT(level, ...)                  \
+    do                                          \
+    {                                           \
+        if (spdlog::should_log(level))          \
+        {                                       \
+            spdlog::log(level, __VA_ARGS__);    \
+        }                                       \
+    } while (0)
+
+#define LAB_LOG_DISABLED(level, ...)            \
+    do                                          \
+    {                                           \
+        if (false)                              \
+        {                                       \
+            spdlog::log(level, __VA_ARGS__);    \
+        }                                       \
+    } while (0)
+
+#if LAB_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LAB_LOG_TRACE(...) LAB_LOG_AT(spdlog::level::trace, __VA_ARGS__)
+#else
+#define LAB_LOG_TRACE(...) LAB_LOG_DISABLED(spdlog::level::trace, __VA_ARGS__)
+#endif
+
+#if LAB_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LAB_LOG_DEBUG(...) LAB_LOG_AT(spdlog::level::debug, __VA_ARGS__)
+#else
+#define LAB_LOG_DEBUG(...) LAB_LOG_DISABLED(spdlog::level::debug, __VA_ARGS__)
+#endif
+
+#if LAB_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define LAB_LOG_INFO(...) LAB_LOG_AT(spdlog::level::info, __VA_ARGS__)
+#else
+#define LAB_LOG_INFO(...) LAB_LOG_DISABLED(spdlog::level::info, __VA_ARGS__)
+#endif
+
+#if LAB_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define LAB_LOG_WARN(...) LAB_LOG_AT(spdlog::level::warn, __VA_ARGS__)
+#else
+#define LAB_LOG_WARN(...) LAB_LOG_DISABLED(spdlog::level::warn, __VA_ARGS__)
+#endif
+
+// true if a debug message would be written, for guarding whole blocks that only exist to log
+#if LAB_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LAB_LOG_DEBUG_ENABLED() spdlog::should_log(spdlog::level::debug)
+#else
+#define LAB_LOG_DEBUG_ENABLED() false
+#endif
+
+#endif // !LOG_MACROS_H
@@ -0,0 +1,304 @@
+#ifndef ACCEPTED_STRING_ENUMERATOR_H
+#define ACCEPTED_STRING_ENUMERATOR_H
+
+#include "compiled_dfa.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+// counting, enumeration and sampling of the strings accepted by a DFA
+// everything works on a compiled DFA and never recurses, so the length bound only costs memory linearly
+namespace accepted_string_enumerator_helper
+{
+    // counts saturate at this value instead of overflowing
+    constexpr uint64_t saturated_count = std::numeric_limits<uint64_t>::max();
+
+    inline uint64_t saturating_add(uint64_t a, uint64_t b) {
+        return a > saturated_count - b ? saturated_count : a + b;
+    }
+
+    // table[k][state] = number of strings of length exactly k that lead from state to an accepting state
+    template<typename T>
+    std::vector<std::vector<uint64_t>> build_suffix_count_table(const dfa_model::CompiledDFA<T>& compiled_dfa, int max_length);
+
+    // result[k] = number of accepted strings of length exactly k, for k in [0, max_length]
+    template<typename T>
+    std::vector<uint64_t> count_accepted_strings(const dfa_model::CompiledDFA<T>& compiled_dfa, int max_length);
+
+    // symbol ids sorted by symbol value, this is the order used for shortlex enumeration
+    template<typename T>
+    std::vector<uint32_t> sorted_symbol_ids(const dfa_model::CompiledDFA<T>& compiled_dfa);
+
+    // draw an accepted string of the given length uniformly at random, std::nullopt if there is none
+    // once counts saturate the draw is only approximately uniform
+    template<typename T, typename RandomEngine>
+    std::optional<std::vector<T>> sample_accepted_string(const dfa_model::CompiledDFA<T>& compiled_dfa,
+                                                         const std::vector<std::vector<uint64_t>>& suffix_count_table,
+                                                         int length,
+                                                         RandomEngine& random_engine);
+}
+
+namespace dfa_model {
+
+// lazily streams the accepted strings of length [0, max_length] in shortlex order
+// (shorter strings first, equal lengths ordered by symbol value)
+template<typename T>
+class AcceptedStringEnumerator
+{
+public:
+    AcceptedStringEnumerator(std::shared_ptr<const CompiledDFA<T>> compiled_dfa, int max_length);
+
+    // produce the next accepted string, false once the enumeration is exhausted
+    bool next(std::vector<T>& output);
+
+    // input iterator over the remaining strings, iterating consumes the enumerator
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::vector<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::vector<T>*;
+        using reference = const std::vector<T>&;
+
+        iterator() = default;
+        explicit iterator(AcceptedStringEnumerator* enumerator) : enumerator(enumerator) { advance(); }
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+        iterator& operator++() { advance(); return *this; }
+        bool operator==(const iterator& other) const { return enumerator == other.enumerator; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        AcceptedStringEnumerator* enumerator = nullptr;
+        std::vector<T> current;
+
+        void advance() {
+            if (enumerator != nullptr && !enumerator->next(current)) {
+                enumerator = nullptr;
+            }
+        }
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+private:
+    // one level of the explicit depth-first stack
+    struct Frame
+    {
+        uint32_t state;
+        size_t next_symbol; // index into sorted_symbols
+    };
+
+    std::shared_ptr<const CompiledDFA<T>> compiled_dfa;
+    int max_length;
+    std::vector<std::vector<uint64_t>> suffix_count_table;
+    std::vector<uint32_t> sorted_symbols;
+
+    int current_length = -1; // the length currently being enumerated
+    std::vector<Frame> stack;
+    std::vector<T> prefix;
+
+    // move on to the next length that has accepted strings, false if there is none
+    bool start_next_length();
+};
+
+}
+
+template<typename T>
+std::vector<std::vector<uint64_t>> accepted_string_enumerator_helper::build_suffix_count_table(const dfa_model::CompiledDFA<T>& compiled_dfa, int max_length)
+{
+    try {
+        if (max_length < 0) {
+            return {};
+        }
+        std::vector<std::vector<uint64_t>> table(static_cast<size_t>(max_length) + 1, std::vector<uint64_t>(compiled_dfa.state_count, 0));
+        for (uint32_t state = 0; state < compiled_dfa.state_count; ++state) {
+            table[0][state] = compiled_dfa.accepting[state] ? 1 : 0;
+        }
+        for (size_t k = 1; k < table.size(); ++k) {
+            for (uint32_t state = 0; state < compiled_dfa.state_count; ++state) {
+                uint64_t count = 0;
+                const uint32_t* row = compiled_dfa.transition_table.data() + static_cast<size_t>(state) * compiled_dfa.symbol_count;
+                for (uint32_t symbol = 0; symbol < compiled_dfa.symbol_count; ++symbol) {
+                    if (row[symbol] != dfa_model::CompiledDFA<T>::dead_state) {
+                        count = saturating_add(count, table[k - 1][row[symbol]]);
+                    }
+                }
+                table[k][state] = count;
+            }
+        }
+        return table;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error building suffix count table: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+template<typename T>
+std::vector<uint64_t> accepted_string_enumerator_helper::count_accepted_strings(const dfa_model::CompiledDFA<T>& compiled_dfa, int max_length)
+{
+    std::vector<uint64_t> counts(max_length < 0 ? 0 : static_cast<size_t>(max_length) + 1, 0);
+    if (compiled_dfa.initial_state == dfa_model::CompiledDFA<T>::dead_state) {
+        return counts;
+    }
+    auto table = build_suffix_count_table(compiled_dfa, max_length);
+    for (size_t k = 0; k < table.size(); ++k) {
+        counts[k] = table[k][compiled_dfa.initial_state];
+    }
+    return counts;
+}
+
+template<typename T>
+std::vector<uint32_t> accepted_string_enumerator_helper::sorted_symbol_ids(const dfa_model::CompiledDFA<T>& compiled_dfa)
+{
+    std::vector<uint32_t> symbol_ids(compiled_dfa.symbol_count);
+    for (uint32_t symbol = 0; symbol < compiled_dfa.symbol_count; ++symbol) {
+        symbol_ids[symbol] = symbol;
+    }
+    std::sort(symbol_ids.begin(), symbol_ids.end(), [&compiled_dfa](uint32_t a, uint32_t b) {
+        return compiled_dfa.symbols[a] < compiled_dfa.symbols[b];
+    });
+    return symbol_ids;
+}
+
+template<typename T, typename RandomEngine>
+std::optional<std::vector<T>> accepted_string_enumerator_helper::sample_accepted_string(const dfa_model::CompiledDFA<T>& compiled_dfa,
+                                                                                     const std::vector<std::vector<uint64_t>>& suffix_count_table,
+                                                                                     int length,
+                                                                                     RandomEngine& random_engine)
+{
+    try {
+        constexpr uint32_t dead_state = dfa_model::CompiledDFA<T>::dead_state;
+        if (length < 0 || static_cast<size_t>(length) >= suffix_count_table.size()) {
+            throw std::runtime_error("Requested length " + std::to_string(length) + " is outside the suffix count table");
+        }
+        if (compiled_dfa.initial_state == dead_state || suffix_count_table[length][compiled_dfa.initial_state] == 0) {
+            return std::nullopt;
+        }
+
+        std::vector<T> output;
+        output.reserve(length);
+        uint32_t state = compiled_dfa.initial_state;
+        for (int remaining = length; remaining > 0; --remaining) {
+            // pick the next symbol with probability proportional to the number of completions behind it
+            const uint32_t* row = compiled_dfa.transition_table.data() + static_cast<size_t>(state) * compiled_dfa.symbol_count;
+            uint64_t total = 0;
+            for (uint32_t symbol = 0; symbol < compiled_dfa.symbol_count; ++symbol) {
+                if (row[symbol] != dead_state) {
+                    total = saturating_add(total, suffix_count_table[remaining - 1][row[symbol]]);
+                }
+            }
+            uint64_t pick = std::uniform_int_distribution<uint64_t>(0, total - 1)(random_engine);
+            uint32_t chosen_symbol = dead_state;
+            for (uint32_t symbol = 0; symbol < compiled_dfa.symbol_count; ++symbol) {
+                if (row[symbol] == dead_state) {
+                    continue;
+                }
+                uint64_t weight = suffix_count_table[remaining - 1][row[symbol]];
+                if (weight == 0) {
+                    continue;
+                }
+                chosen_symbol = symbol;
+                if (pick < weight) {
+                    break;
+                }
+                pick -= weight;
+            }
+            output.push_back(compiled_dfa.symbols[chosen_symbol]);
+            state = row[chosen_symbol];
+        }
+        return output;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error sampling accepted string: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+template<typename T>
+dfa_model::AcceptedStringEnumerator<T>::AcceptedStringEnumerator(std::shared_ptr<const CompiledDFA<T>> compiled_dfa, int max_length)
+    : compiled_dfa(std::move(compiled_dfa)), max_length(max_length)
+{
+    if (!this->compiled_dfa) {
+        throw std::runtime_error("Error creating accepted string enumerator: compiled DFA is null");
+    }
+    suffix_count_table = accepted_string_enumerator_helper::build_suffix_count_table(*this->compiled_dfa, max_length);
+    sorted_symbols = accepted_string_enumerator_helper::sorted_symbol_ids(*this->compiled_dfa);
+}
+
+template<typename T>
+bool dfa_model::AcceptedStringEnumerator<T>::start_next_length()
+{
+    if (compiled_dfa->initial_state == CompiledDFA<T>::dead_state) {
+        return false;
+    }
+    while (current_length < max_length) {
+        ++current_length;
+        if (suffix_count_table[current_length][compiled_dfa->initial_state] == 0) {
+            continue;
+        }
+        stack.clear();
+        prefix.clear();
+        stack.push_back({compiled_dfa->initial_state, 0});
+        return true;
+    }
+    return false;
+}
+
+template<typename T>
+bool dfa_model::AcceptedStringEnumerator<T>::next(std::vector<T>& output)
+{
+    constexpr uint32_t dead_state = CompiledDFA<T>::dead_state;
+    while (true) {
+        if (stack.empty() && !start_next_length()) {
+            return false;
+        }
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            int remaining = current_length - static_cast<int>(prefix.size());
+            if (remaining == 0) {
+                // only live paths are pushed, so a full-length frame is always accepting
+                output = prefix;
+                stack.pop_back();
+                if (!prefix.empty()) {
+                    prefix.pop_back();
+                }
+                return true;
+            }
+            // find the next symbol whose target can still finish within the remaining length
+            const uint32_t* row = compiled_dfa->transition_table.data() + static_cast<size_t>(frame.state) * compiled_dfa->symbol_count;
+            bool pushed = false;
+            while (frame.next_symbol < sorted_symbols.size()) {
+                uint32_t symbol = sorted_symbols[frame.next_symbol++];
+                uint32_t target = row[symbol];
+                if (target == dead_state || suffix_count_table[remaining - 1][target] == 0) {
+                    continue;
+                }
+                prefix.push_back(compiled_dfa->symbols[symbol]);
+                stack.push_back({target, 0});
+                pushed = true;
+                break;
+            }
+            if (!pushed) {
+                stack.pop_back();
+                if (!prefix.empty()) {
+                    prefix.pop_back();
+                }
+            }
+        }
+    }
+}
+
+#endif // !ACCEPTED_STRING_ENUMERATOR_H
@@ -0,0 +1,208 @@
+#ifndef COMPACT_CONFLICT_TOLERANT_DFA_H
+#define COMPACT_CONFLICT_TOLERANT_DFA_H
+
+#include "dfa_model.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// compact conflict tolerant DFA
+// same information as dfa_model::ConflictTolerantDFA, but states and symbols are integer ids and
+// every state keeps its transitions in one sorted vector of (symbol id, target id) pairs,
+// a symbol with several targets simply appears several times in a row
+namespace dfa_model {
+
+template<typename T>
+struct CompactConflictTolerantDFA {
+    static constexpr uint32_t invalid_id = std::numeric_limits<uint32_t>::max();
+    using Transition = std::pair<uint32_t, uint32_t>; // (symbol id, target state id)
+    using TransitionIterator = typename std::vector<Transition>::const_iterator;
+
+    std::vector<std::string> state_names;                 // state id -> state name
+    std::unordered_map<std::string, uint32_t> state_ids;  // state name -> state id
+    std::vector<T> symbols;                               // symbol id -> symbol
+    std::unordered_map<T, uint32_t> symbol_ids;           // symbol -> symbol id
+    uint32_t initial_state = invalid_id;
+    std::vector<uint8_t> accepting;                       // 1 if the state is an accepting state
+    std::vector<std::vector<Transition>> transitions;     // per state, sorted by (symbol id, target id)
+
+    // add a state (or get the existing one), returns its id
+    uint32_t add_state(const std::string& state_name, bool is_accepting = false) {
+        auto it = state_ids.find(state_name);
+        if (it != state_ids.end()) {
+            if (is_accepting) {
+                accepting[it->second] = 1;
+            }
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(state_names.size());
+        state_ids.emplace(state_name, id);
+        state_names.push_back(state_name);
+        accepting.push_back(is_accepting ? 1 : 0);
+        transitions.emplace_back();
+        return id;
+    }
+
+    // add a symbol (or get the existing one), returns its id
+    uint32_t add_symbol(const T& symbol) {
+        auto it = symbol_ids.find(symbol);
+        if (it != symbol_ids.end()) {
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(symbols.size());
+        symbol_ids.emplace(symbol, id);
+        symbols.push_back(symbol);
+        return id;
+    }
+
+    uint32_t find_state(const std::string& state_name) const {
+        auto it = state_ids.find(state_name);
+        return it == state_ids.end() ? invalid_id : it->second;
+    }
+
+    uint32_t find_symbol(const T& symbol) const {
+        auto it = symbol_ids.find(symbol);
+        return it == symbol_ids.end() ? invalid_id : it->second;
+    }
+
+    // add a transition keeping the row sorted, returns false if the exact transition already exists
+    bool add_transition(uint32_t from_state, uint32_t symbol, uint32_t to_state) {
+        if (from_state >= transitions.size() || to_state >= transitions.size() || symbol >= symbols.size()) {
+            std::string error_msg = "Error adding transition to compact DFA: invalid state or symbol id";
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        std::vector<Transition>& row = transitions[from_state];
+        Transition transition{symbol, to_state};
+        auto it = std::lower_bound(row.begin(), row.end(), transition);
+        if (it != row.end() && *it == transition) {
+            return false;
+        }
+        row.insert(it, transition);
+        return true;
+    }
+
+    // all targets of (state, symbol), as a range of (symbol id, target id) pairs
+    std::pair<TransitionIterator, TransitionIterator> equal_range(uint32_t state, uint32_t symbol) const {
+        const std::vector<Transition>& row = transitions[state];
+        auto begin = std::lower_bound(row.begin(), row.end(), Transition{symbol, 0});
+        auto end = std::upper_bound(begin, row.end(), Transition{symbol, invalid_id});
+        return {begin, end};
+    }
+
+    bool check_transition(uint32_t from_state, uint32_t symbol, uint32_t to_state) const {
+        const std::vector<Transition>& row = transitions[from_state];
+        return std::binary_search(row.begin(), row.end(), Transition{symbol, to_state});
+    }
+
+    size_t count_transitions() const {
+        size_t count = 0;
+        for (const auto& row : transitions) {
+            count += row.size();
+        }
+        return count;
+    }
+
+    // symbols that lead to more than one target from the given state
+    std::vector<uint32_t> conflicting_symbols(uint32_t state) const {
+        std::vector<uint32_t> conflicts;
+        const std::vector<Transition>& row = transitions[state];
+        for (size_t i = 1; i < row.size(); ++i) {
+            if (row[i].first == row[i - 1].first && (conflicts.empty() || conflicts.back() != row[i].first)) {
+                conflicts.push_back(row[i].first);
+            }
+        }
+        return conflicts;
+    }
+};
+
+}
+
+namespace compact_conflict_tolerant_dfa_helper
+{
+    // convert the node-based conflict tolerant DFA into the compact form
+    template<typename T>
+    dfa_model::CompactConflictTolerantDFA<T> to_compact(const dfa_model::ConflictTolerantDFA<T>& dfa);
+
+    // convert the compact form back into the node-based conflict tolerant DFA
+    template<typename T>
+    dfa_model::ConflictTolerantDFA<T> from_compact(const dfa_model::CompactConflictTolerantDFA<T>& compact_dfa);
+}
+
+template<typename T>
+dfa_model::CompactConflictTolerantDFA<T> compact_conflict_tolerant_dfa_helper::to_compact(const dfa_model::ConflictTolerantDFA<T>& dfa)
+{
+    try {
+        dfa_model::CompactConflictTolerantDFA<T> compact_dfa;
+        for (const auto& state : dfa.states_set) {
+            compact_dfa.add_state(state, dfa.accepting_states.find(state) != dfa.accepting_states.end());
+        }
+        for (const auto& symbol : dfa.character_set) {
+            compact_dfa.add_symbol(symbol);
+        }
+        if (!dfa.initial_state.empty()) {
+            compact_dfa.initial_state = compact_dfa.find_state(dfa.initial_state);
+        }
+        // append everything first, then sort each row once
+        for (const auto& state_transitions : dfa.transitions) {
+            uint32_t from_state = compact_dfa.find_state(state_transitions.first);
+            for (const auto& char_state_pair : state_transitions.second) {
+                uint32_t symbol = compact_dfa.find_symbol(char_state_pair.first);
+                uint32_t to_state = compact_dfa.find_state(char_state_pair.second);
+                if (from_state == compact_dfa.invalid_id || symbol == compact_dfa.invalid_id || to_state == compact_dfa.invalid_id) {
+                    throw std::runtime_error("Transition references a state or character outside the DFA: " + state_transitions.first + " --> " + char_state_pair.second);
+                }
+                compact_dfa.transitions[from_state].emplace_back(symbol, to_state);
+            }
+        }
+        for (auto& row : compact_dfa.transitions) {
+            std::sort(row.begin(), row.end());
+            row.erase(std::unique(row.begin(), row.end()), row.end());
+        }
+        spdlog::debug("Compacted conflict tolerant DFA with {} states and {} transitions", compact_dfa.state_names.size(), compact_dfa.count_transitions());
+        return compact_dfa;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error compacting conflict tolerant DFA: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+template<typename T>
+dfa_model::ConflictTolerantDFA<T> compact_conflict_tolerant_dfa_helper::from_compact(const dfa_model::CompactConflictTolerantDFA<T>& compact_dfa)
+{
+    try {
+        dfa_model::ConflictTolerantDFA<T> dfa;
+        dfa.character_set.insert(compact_dfa.symbols.begin(), compact_dfa.symbols.end());
+        dfa.states_set.insert(compact_dfa.state_names.begin(), compact_dfa.state_names.end());
+        if (compact_dfa.initial_state != compact_dfa.invalid_id) {
+            dfa.initial_state = compact_dfa.state_names.at(compact_dfa.initial_state);
+        }
+        for (size_t state = 0; state < compact_dfa.state_names.size(); ++state) {
+            if (compact_dfa.accepting[state]) {
+                dfa.accepting_states.insert(compact_dfa.state_names[state]);
+            }
+            if (compact_dfa.transitions[state].empty()) {
+                continue;
+            }
+            auto& row = dfa.transitions[compact_dfa.state_names[state]];
+            for (const auto& transition : compact_dfa.transitions[state]) {
+                row.emplace(compact_dfa.symbols[transition.first], compact_dfa.state_names[transition.second]);
+            }
+        }
+        return dfa;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error expanding compact conflict tolerant DFA: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+#endif // !COMPACT_CONFLICT_TOLERANT_DFA_H
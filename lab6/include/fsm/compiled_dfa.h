@@ -0,0 +1,284 @@
+#ifndef COMPILED_DFA_H
+#define COMPILED_DFA_H
+
+#include "dfa_model.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// compiled DFA model
+// a dense, integer-indexed copy of dfa_model::DFA used by the hot simulation paths,
+// the string-keyed DFA stays the editable representation
+namespace dfa_model {
+
+template<typename T>
+struct CompiledDFA {
+    static constexpr uint32_t dead_state = std::numeric_limits<uint32_t>::max();
+    // byte-sized characters are looked up directly instead of hashed
+    static constexpr bool direct_symbol_lookup = std::is_integral<T>::value && sizeof(T) == 1;
+
+    uint32_t state_count = 0;
+    uint32_t symbol_count = 0;
+    uint32_t initial_state = dead_state;
+    std::vector<uint32_t> transition_table;  // state_count * symbol_count, dead_state if no transition
+    std::vector<uint8_t> accepting;          // 1 if the state is an accepting state
+    std::vector<std::string> state_names;    // state id -> original state name
+    std::vector<T> symbols;                  // symbol id -> original symbol
+    std::unordered_map<T, uint32_t> symbol_ids;               // used when direct lookup is not possible
+    std::array<uint32_t, 256> direct_symbol_ids{};            // used when direct lookup is possible
+
+    // get the symbol id of a character, dead_state if the character is unknown
+    uint32_t symbol_id(const T& input_char) const {
+        if constexpr (direct_symbol_lookup) {
+            return direct_symbol_ids[static_cast<uint8_t>(input_char)];
+        } else {
+            auto it = symbol_ids.find(input_char);
+            return it == symbol_ids.end() ? dead_state : it->second;
+        }
+    }
+
+    // single step, dead_state stays dead
+    uint32_t step(uint32_t state, const T& input_char) const {
+        uint32_t symbol = symbol_id(input_char);
+        if (state == dead_state || symbol == dead_state) {
+            return dead_state;
+        }
+        return transition_table[static_cast<size_t>(state) * symbol_count + symbol];
+    }
+
+    bool is_accepting(uint32_t state) const {
+        return state != dead_state && accepting[state] != 0;
+    }
+};
+
+}
+
+namespace compiled_dfa_helper
+{
+    // number of inputs walked side by side by one worker, so that the table loads of
+    // independent strings overlap instead of waiting on each other
+    constexpr size_t interleave_width = 8;
+
+    // compile a DFA into its dense form
+    template<typename T>
+    dfa_model::CompiledDFA<T> compile_dfa(const dfa_model::DFA<T>& dfa);
+
+    // simulate a single input on a compiled DFA, empty inputs are rejected
+    template<typename T>
+    bool simulate(const dfa_model::CompiledDFA<T>& compiled_dfa, const std::vector<T>& input);
+
+    // simulate inputs[begin, end) and write 0/1 into results[begin, end)
+    template<typename T>
+    void simulate_range(const dfa_model::CompiledDFA<T>& compiled_dfa, const std::vector<std::vector<T>>& inputs, size_t begin, size_t end, std::vector<uint8_t>& results);
+
+    // simulate a batch of inputs, optionally split across threads (0 means hardware concurrency)
+    template<typename T>
+    std::vector<bool> simulate_batch(const dfa_model::CompiledDFA<T>& compiled_dfa, const std::vector<std::vector<T>>& inputs, unsigned thread_count = 1);
+}
+
+template<typename T>
+dfa_model::CompiledDFA<T> compiled_dfa_helper::compile_dfa(const dfa_model::DFA<T>& dfa)
+{
+    try {
+        dfa_model::CompiledDFA<T> compiled_dfa;
+        std::unordered_map<std::string, uint32_t> state_ids;
+        auto intern_state = [&](const std::string& state) {
+            auto it = state_ids.find(state);
+            if (it != state_ids.end()) {
+                return it->second;
+            }
+            uint32_t id = static_cast<uint32_t>(compiled_dfa.state_names.size());
+            state_ids.emplace(state, id);
+            compiled_dfa.state_names.push_back(state);
+            return id;
+        };
+        auto intern_symbol = [&](const T& input_char) {
+            auto it = compiled_dfa.symbol_ids.find(input_char);
+            if (it != compiled_dfa.symbol_ids.end()) {
+                return;
+            }
+            compiled_dfa.symbol_ids.emplace(input_char, static_cast<uint32_t>(compiled_dfa.symbols.size()));
+            compiled_dfa.symbols.push_back(input_char);
+        };
+
+        // the initial state always gets id 0
+        if (!dfa.initial_state.empty()) {
+            compiled_dfa.initial_state = intern_state(dfa.initial_state);
+        }
+        for (const auto& state : dfa.states_set) {
+            intern_state(state);
+        }
+        for (const auto& input_char : dfa.character_set) {
+            intern_symbol(input_char);
+        }
+        // transitions may mention states/characters outside the declared sets, keep them reachable anyway
+        for (const auto& state_transitions : dfa.transitions) {
+            intern_state(state_transitions.first);
+            for (const auto& char_state_pair : state_transitions.second) {
+                intern_symbol(char_state_pair.first);
+                intern_state(char_state_pair.second);
+            }
+        }
+
+        compiled_dfa.state_count = static_cast<uint32_t>(compiled_dfa.state_names.size());
+        compiled_dfa.symbol_count = static_cast<uint32_t>(compiled_dfa.symbols.size());
+        compiled_dfa.transition_table.assign(static_cast<size_t>(compiled_dfa.state_count) * compiled_dfa.symbol_count, dfa_model::CompiledDFA<T>::dead_state);
+        compiled_dfa.accepting.assign(compiled_dfa.state_count, 0);
+
+        for (const auto& state_transitions : dfa.transitions) {
+            size_t row = static_cast<size_t>(state_ids.at(state_transitions.first)) * compiled_dfa.symbol_count;
+            for (const auto& char_state_pair : state_transitions.second) {
+                compiled_dfa.transition_table[row + compiled_dfa.symbol_ids.at(char_state_pair.first)] = state_ids.at(char_state_pair.second);
+            }
+        }
+        for (const auto& accepting_state : dfa.accepting_states) {
+            auto it = state_ids.find(accepting_state);
+            if (it != state_ids.end()) {
+                compiled_dfa.accepting[it->second] = 1;
+            }
+        }
+
+        if constexpr (dfa_model::CompiledDFA<T>::direct_symbol_lookup) {
+            compiled_dfa.direct_symbol_ids.fill(dfa_model::CompiledDFA<T>::dead_state);
+            for (const auto& symbol_id_pair : compiled_dfa.symbol_ids) {
+                compiled_dfa.direct_symbol_ids[static_cast<uint8_t>(symbol_id_pair.first)] = symbol_id_pair.second;
+            }
+        }
+
+        spdlog::debug("Compiled DFA with {} states and {} symbols", compiled_dfa.state_count, compiled_dfa.symbol_count);
+        return compiled_dfa;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error compiling DFA: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+template<typename T>
+bool compiled_dfa_helper::simulate(const dfa_model::CompiledDFA<T>& compiled_dfa, const std::vector<T>& input)
+{
+    if (input.empty()) {
+        return false;
+    }
+    uint32_t state = compiled_dfa.initial_state;
+    for (const auto& input_char : input) {
+        state = compiled_dfa.step(state, input_char);
+        if (state == dfa_model::CompiledDFA<T>::dead_state) {
+            return false;
+        }
+    }
+    return compiled_dfa.is_accepting(state);
+}
+
+template<typename T>
+void compiled_dfa_helper::simulate_range(const dfa_model::CompiledDFA<T>& compiled_dfa, const std::vector<std::vector<T>>& inputs, size_t begin, size_t end, std::vector<uint8_t>& results)
+{
+    constexpr uint32_t dead_state = dfa_model::CompiledDFA<T>::dead_state;
+    constexpr size_t idle_lane = std::numeric_limits<size_t>::max();
+
+    // every lane walks one input, a finished lane is refilled with the next pending input
+    std::array<size_t, interleave_width> lane_input;
+    std::array<size_t, interleave_width> lane_position;
+    std::array<uint32_t, interleave_width> lane_state;
+    size_t next_input = begin;
+    size_t active_lanes = 0;
+
+    auto refill_lane = [&](size_t lane) {
+        while (next_input < end) {
+            size_t input_index = next_input++;
+            if (inputs[input_index].empty() || compiled_dfa.initial_state == dead_state) {
+                results[input_index] = 0;
+                continue;
+            }
+            lane_input[lane] = input_index;
+            lane_position[lane] = 0;
+            lane_state[lane] = compiled_dfa.initial_state;
+            return true;
+        }
+        lane_input[lane] = idle_lane;
+        return false;
+    };
+
+    for (size_t lane = 0; lane < interleave_width; ++lane) {
+        if (refill_lane(lane)) {
+            ++active_lanes;
+        }
+    }
+
+    while (active_lanes > 0) {
+        for (size_t lane = 0; lane < interleave_width; ++lane) {
+            if (lane_input[lane] == idle_lane) {
+                continue;
+            }
+            const std::vector<T>& input = inputs[lane_input[lane]];
+            uint32_t state = compiled_dfa.step(lane_state[lane], input[lane_position[lane]]);
+            ++lane_position[lane];
+            bool finished = state == dead_state || lane_position[lane] == input.size();
+            if (!finished) {
+                lane_state[lane] = state;
+                continue;
+            }
+            results[lane_input[lane]] = compiled_dfa.is_accepting(state) ? 1 : 0;
+            if (!refill_lane(lane)) {
+                --active_lanes;
+            }
+        }
+    }
+}
+
+template<typename T>
+std::vector<bool> compiled_dfa_helper::simulate_batch(const dfa_model::CompiledDFA<T>& compiled_dfa, const std::vector<std::vector<T>>& inputs, unsigned thread_count)
+{
+    try {
+        // results are gathered byte-wise first, std::vector<bool> is not safe for concurrent writes
+        std::vector<uint8_t> results(inputs.size(), 0);
+
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        // do not spawn threads that would get less than one interleaved group each
+        size_t max_useful_threads = std::max<size_t>(1, inputs.size() / interleave_width);
+        size_t worker_count = std::min<size_t>(thread_count, max_useful_threads);
+
+        if (worker_count <= 1) {
+            simulate_range(compiled_dfa, inputs, 0, inputs.size(), results);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(worker_count);
+            size_t chunk_size = (inputs.size() + worker_count - 1) / worker_count;
+            for (size_t worker = 0; worker < worker_count; ++worker) {
+                size_t begin = worker * chunk_size;
+                size_t end = std::min(inputs.size(), begin + chunk_size);
+                if (begin >= end) {
+                    break;
+                }
+                workers.emplace_back([&compiled_dfa, &inputs, &results, begin, end]() {
+                    simulate_range(compiled_dfa, inputs, begin, end, results);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        std::vector<bool> accepted(results.begin(), results.end());
+        spdlog::debug("Simulated a batch of {} inputs with {} worker(s), {} accepted",
+                      inputs.size(), std::max<size_t>(1, worker_count), std::count(results.begin(), results.end(), 1));
+        return accepted;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error simulating DFA batch: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+#endif // !COMPILED_DFA_H
@@ -0,0 +1,280 @@
+#ifndef DFA_BUILDER_H
+#define DFA_BUILDER_H
+
+#include "dfa_model.h"
+#include "compiled_dfa.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// bulk DFA builder
+// states and symbols are interned once, transitions are appended to a flat vector without any check,
+// conflicts and invalid references are detected in a single validation pass when the DFA is built
+namespace dfa_model {
+
+template<typename T>
+class DFABuilder
+{
+public:
+    static constexpr uint32_t invalid_id = std::numeric_limits<uint32_t>::max();
+
+    DFABuilder() = default;
+
+    // reserve room for the expected automaton size
+    void reserve(size_t state_count, size_t transition_count);
+
+    // add a state (or get the existing one), returns its id
+    uint32_t add_state(const std::string& state_name, bool accepting = false);
+    // add a symbol (or get the existing one), returns its id
+    uint32_t add_symbol(const T& symbol);
+
+    void set_initial_state(uint32_t state_id) { initial_state = state_id; }
+    void set_accepting(uint32_t state_id, bool accepting = true);
+
+    // append a transition, validated only in build()
+    void add_transition(uint32_t from_state, uint32_t symbol, uint32_t to_state) {
+        transitions.push_back({from_state, symbol, to_state});
+    }
+
+    // lookups, invalid_id if not found
+    uint32_t find_state(const std::string& state_name) const;
+    uint32_t find_symbol(const T& symbol) const;
+
+    size_t state_count() const { return state_names.size(); }
+    size_t symbol_count() const { return symbols.size(); }
+    size_t transition_count() const { return transitions.size(); }
+    const std::string& state_name(uint32_t state_id) const { return state_names.at(state_id); }
+
+    // validate once and produce the DFA, throws if there are conflicts or invalid references
+    DFA<T> build() const;
+    // validate once and produce the compiled DFA directly
+    CompiledDFA<T> build_compiled() const;
+
+private:
+    struct Transition
+    {
+        uint32_t from_state;
+        uint32_t symbol;
+        uint32_t to_state;
+    };
+
+    std::vector<std::string> state_names;
+    std::unordered_map<std::string, uint32_t> state_ids;
+    std::vector<uint8_t> accepting_states;
+    std::vector<T> symbols;
+    std::unordered_map<T, uint32_t> symbol_ids;
+    uint32_t initial_state = invalid_id;
+    std::vector<Transition> transitions;
+
+    // sort, deduplicate and check the transitions, returns them ordered by (from_state, symbol)
+    std::vector<Transition> validated_transitions() const;
+};
+
+}
+
+template<typename T>
+void dfa_model::DFABuilder<T>::reserve(size_t state_count, size_t transition_count)
+{
+    state_names.reserve(state_count);
+    state_ids.reserve(state_count);
+    accepting_states.reserve(state_count);
+    transitions.reserve(transition_count);
+}
+
+template<typename T>
+uint32_t dfa_model::DFABuilder<T>::add_state(const std::string& state_name, bool accepting)
+{
+    auto it = state_ids.find(state_name);
+    if (it != state_ids.end()) {
+        if (accepting) {
+            accepting_states[it->second] = 1;
+        }
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(state_names.size());
+    state_ids.emplace(state_name, id);
+    state_names.push_back(state_name);
+    accepting_states.push_back(accepting ? 1 : 0);
+    return id;
+}
+
+template<typename T>
+uint32_t dfa_model::DFABuilder<T>::add_symbol(const T& symbol)
+{
+    auto it = symbol_ids.find(symbol);
+    if (it != symbol_ids.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(symbols.size());
+    symbol_ids.emplace(symbol, id);
+    symbols.push_back(symbol);
+    return id;
+}
+
+template<typename T>
+void dfa_model::DFABuilder<T>::set_accepting(uint32_t state_id, bool accepting)
+{
+    if (state_id >= accepting_states.size()) {
+        std::string error_msg = "Error setting accepting state: state id " + std::to_string(state_id) + " does not exist";
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    accepting_states[state_id] = accepting ? 1 : 0;
+}
+
+template<typename T>
+uint32_t dfa_model::DFABuilder<T>::find_state(const std::string& state_name) const
+{
+    auto it = state_ids.find(state_name);
+    return it == state_ids.end() ? invalid_id : it->second;
+}
+
+template<typename T>
+uint32_t dfa_model::DFABuilder<T>::find_symbol(const T& symbol) const
+{
+    auto it = symbol_ids.find(symbol);
+    return it == symbol_ids.end() ? invalid_id : it->second;
+}
+
+template<typename T>
+std::vector<typename dfa_model::DFABuilder<T>::Transition> dfa_model::DFABuilder<T>::validated_transitions() const
+{
+    if (state_names.empty()) {
+        throw std::runtime_error("DFA has an empty states set");
+    }
+    if (symbols.empty()) {
+        throw std::runtime_error("DFA has an empty character set");
+    }
+    if (initial_state >= state_names.size()) {
+        throw std::runtime_error("DFA has no valid initial state");
+    }
+    if (std::none_of(accepting_states.begin(), accepting_states.end(), [](uint8_t accepting) { return accepting != 0; })) {
+        throw std::runtime_error("DFA has an empty accepting states set");
+    }
+
+    std::vector<Transition> sorted_transitions = transitions;
+    std::sort(sorted_transitions.begin(), sorted_transitions.end(), [](const Transition& a, const Transition& b) {
+        if (a.from_state != b.from_state) return a.from_state < b.from_state;
+        if (a.symbol != b.symbol) return a.symbol < b.symbol;
+        return a.to_state < b.to_state;
+    });
+
+    // one pass: invalid references, then conflicts between neighbours
+    std::vector<Transition> unique_transitions;
+    unique_transitions.reserve(sorted_transitions.size());
+    size_t invalid_count = 0;
+    size_t conflict_count = 0;
+    std::string first_problem;
+    for (const auto& transition : sorted_transitions) {
+        if (transition.from_state >= state_names.size() || transition.to_state >= state_names.size() || transition.symbol >= symbols.size()) {
+            if (invalid_count++ == 0 && first_problem.empty()) {
+                first_problem = "transition references an unknown state or symbol (" + std::to_string(transition.from_state) + ", " +
+                                std::to_string(transition.symbol) + ", " + std::to_string(transition.to_state) + ")";
+            }
+            continue;
+        }
+        if (!unique_transitions.empty() && unique_transitions.back().from_state == transition.from_state && unique_transitions.back().symbol == transition.symbol) {
+            if (unique_transitions.back().to_state != transition.to_state) {
+                if (conflict_count++ == 0 && first_problem.empty()) {
+                    first_problem = "conflicting transitions from " + state_names[transition.from_state] + " to " +
+                                    state_names[unique_transitions.back().to_state] + " and " + state_names[transition.to_state];
+                }
+            }
+            continue; // duplicates are dropped
+        }
+        unique_transitions.push_back(transition);
+    }
+    if (invalid_count > 0 || conflict_count > 0) {
+        throw std::runtime_error("DFA validation failed with " + std::to_string(invalid_count) + " invalid transition(s) and " +
+                                 std::to_string(conflict_count) + " conflict(s), first: " + first_problem);
+    }
+    return unique_transitions;
+}
+
+template<typename T>
+dfa_model::DFA<T> dfa_model::DFABuilder<T>::build() const
+{
+    try {
+        std::vector<Transition> unique_transitions = validated_transitions();
+
+        DFA<T> dfa;
+        dfa.character_set.reserve(symbols.size());
+        dfa.character_set.insert(symbols.begin(), symbols.end());
+        dfa.states_set.reserve(state_names.size());
+        dfa.states_set.insert(state_names.begin(), state_names.end());
+        dfa.initial_state = state_names[initial_state];
+        for (size_t state = 0; state < state_names.size(); ++state) {
+            if (accepting_states[state]) {
+                dfa.accepting_states.insert(state_names[state]);
+            }
+        }
+        // transitions are grouped by source state, so each inner map is created once
+        dfa.transitions.reserve(state_names.size());
+        std::unordered_map<T, std::string>* current_row = nullptr;
+        uint32_t current_from = invalid_id;
+        for (const auto& transition : unique_transitions) {
+            if (transition.from_state != current_from) {
+                current_from = transition.from_state;
+                current_row = &dfa.transitions[state_names[current_from]];
+            }
+            current_row->emplace(symbols[transition.symbol], state_names[transition.to_state]);
+        }
+        spdlog::debug("Built DFA with {} states, {} characters and {} transitions", state_names.size(), symbols.size(), unique_transitions.size());
+        return dfa;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error building DFA: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+template<typename T>
+dfa_model::CompiledDFA<T> dfa_model::DFABuilder<T>::build_compiled() const
+{
+    try {
+        std::vector<Transition> unique_transitions = validated_transitions();
+
+        // builder ids are already dense, only the initial state has to be moved to id 0 to match compile_dfa
+        std::vector<uint32_t> state_remap(state_names.size());
+        for (uint32_t state = 0; state < state_names.size(); ++state) {
+            state_remap[state] = state;
+        }
+        std::swap(state_remap[0], state_remap[initial_state]);
+
+        CompiledDFA<T> compiled_dfa;
+        compiled_dfa.state_count = static_cast<uint32_t>(state_names.size());
+        compiled_dfa.symbol_count = static_cast<uint32_t>(symbols.size());
+        compiled_dfa.initial_state = 0;
+        compiled_dfa.symbols = symbols;
+        compiled_dfa.symbol_ids = symbol_ids;
+        compiled_dfa.state_names.resize(state_names.size());
+        compiled_dfa.accepting.resize(state_names.size());
+        for (uint32_t state = 0; state < state_names.size(); ++state) {
+            compiled_dfa.state_names[state_remap[state]] = state_names[state];
+            compiled_dfa.accepting[state_remap[state]] = accepting_states[state];
+        }
+        compiled_dfa.transition_table.assign(static_cast<size_t>(compiled_dfa.state_count) * compiled_dfa.symbol_count, CompiledDFA<T>::dead_state);
+        for (const auto& transition : unique_transitions) {
+            compiled_dfa.transition_table[static_cast<size_t>(state_remap[transition.from_state]) * compiled_dfa.symbol_count + transition.symbol] = state_remap[transition.to_state];
+        }
+        if constexpr (CompiledDFA<T>::direct_symbol_lookup) {
+            compiled_dfa.direct_symbol_ids.fill(CompiledDFA<T>::dead_state);
+            for (uint32_t symbol = 0; symbol < symbols.size(); ++symbol) {
+                compiled_dfa.direct_symbol_ids[static_cast<uint8_t>(symbols[symbol])] = symbol;
+            }
+        }
+        return compiled_dfa;
+    }
+    catch (const std::exception& e) {
+        std::string error_msg = "Error building compiled DFA: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+#endif // !DFA_BUILDER_H
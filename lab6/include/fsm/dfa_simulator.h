@@ -3,6 +3,7 @@
 
 #include <string>
 #include <set>
+#include <vector>
 #include "dfa_model.h"
 
 // more versatile DFA simulator with template
@@ -16,6 +17,17 @@ public:
 
     // simulate an array of characters with type T
     virtual bool SimulateString(const std::vector<T>& input) = 0;
+
+    // simulate a batch of inputs against the same DFA, result[i] tells whether inputs[i] is accepted
+    // thread_count splits the batch across threads, 0 means hardware concurrency; only simulators backed by a CompiledDFA honour it
+    // the default implementation ignores it and simply calls SimulateString once per input, on the calling thread
+    virtual std::vector<bool> SimulateBatch(const std::vector<std::vector<T>>& inputs, unsigned /*thread_count*/ = 1) {
+        std::vector<bool> accepted(inputs.size(), false);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            accepted[i] = SimulateString(inputs[i]);
+        }
+        return accepted;
+    }
 };
 
 
@@ -3,7 +3,10 @@
 
 #include "dfa_simulator.h"
 #include "dfa_model.h"
+#include "compiled_dfa.h"
 #include "spdlog/spdlog.h"
+#include "log_macros.h"
+#include <memory>
 #include <string>
 #include <set>
 #include <unordered_map>
@@ -15,6 +18,8 @@ class MultiTypeDFASimulator : public DFASimulator<T>
 {
 private:
     dfa_model::DFA<T> dfa;
+    // dense copy of the DFA for batch simulation, compiled on first use
+    std::shared_ptr<const dfa_model::CompiledDFA<T>> compiled_dfa;
 public:
     MultiTypeDFASimulator() = default;
     ~MultiTypeDFASimulator() override = default;
@@ -24,6 +29,9 @@ public:
 
     // simulate an array of characters with type T
     bool SimulateString(const std::vector<T>& input) override;
+
+    // simulate a batch of inputs without per-input logging
+    std::vector<bool> SimulateBatch(const std::vector<std::vector<T>>& inputs, unsigned thread_count = 1) override;
 };
 
 namespace multitype_dfa_simulator_helper
@@ -46,6 +54,7 @@ template<typename T>
 bool MultiTypeDFASimulator<T>::UpdateDFA(const dfa_model::DFA<T>& dfa) {
     try {
         this->dfa = dfa;
+        compiled_dfa.reset();
         return true;
     } catch (const std::exception &e) {
         std::string error_message = "Error updating DFA: ";
@@ -65,33 +74,33 @@ bool MultiTypeDFASimulator<T>::SimulateString(const std::vector<T>& input) {
             return false;
         }
         std::string current_state = dfa.initial_state;
-        spdlog::debug("Start multi-type string simulation");
-        spdlog::debug("Target string: {}", fmt::join(input, ", "));
-        spdlog::debug("Initial state: {}", current_state);
+        LAB_LOG_DEBUG("Start multi-type string simulation");
+        LAB_LOG_DEBUG("Target string: {}", fmt::join(input, ", "));
+        LAB_LOG_DEBUG("Initial state: {}", current_state);
 
         for (const auto &input_char : input) {
-            spdlog::debug("Current character: {}", input_char);
+            LAB_LOG_DEBUG("Current character: {}", input_char);
 
             // Check if the transition is valid
             if (!multitype_dfa_simulator_helper::CheckSingleCharInSingleState(dfa, current_state, input_char)) {
                 // note this is not considered an error, just a rejection
-                spdlog::debug("No transition from state {} on input '{}'", current_state, input_char);
-                spdlog::info("Rejected string: {}, reason: {}", fmt::join(input, ", "), "No transition for input character");
+                LAB_LOG_DEBUG("No transition from state {} on input '{}'", current_state, input_char);
+                LAB_LOG_INFO("Rejected string: {}, reason: {}", fmt::join(input, ", "), "No transition for input character");
                 return false;
             }
 
             // Perform single step simulation
             current_state = multitype_dfa_simulator_helper::SingleStepSimulate(dfa, current_state, input_char);
-            spdlog::debug("Transition to state: {}", current_state);
+            LAB_LOG_DEBUG("Transition to state: {}", current_state);
         }
 
         // Check if the final state is an accepting state
-        spdlog::debug("Final state: {}", current_state);
+        LAB_LOG_DEBUG("Final state: {}", current_state);
         if (multitype_dfa_simulator_helper::IsAcceptState(dfa, current_state)) {
-            spdlog::info("Accepted string: {}, reason: {}", fmt::join(input, ", "), "Final state is accepting");
+            LAB_LOG_INFO("Accepted string: {}, reason: {}", fmt::join(input, ", "), "Final state is accepting");
             return true;
         } else {
-            spdlog::info("Rejected string: {}, reason: {}", fmt::join(input, ", "), "Final state is not accepting");
+            LAB_LOG_INFO("Rejected string: {}, reason: {}", fmt::join(input, ", "), "Final state is not accepting");
             return false;
         }
     }
@@ -104,6 +113,22 @@ bool MultiTypeDFASimulator<T>::SimulateString(const std::vector<T>& input) {
     }
 }
 
+template<typename T>
+std::vector<bool> MultiTypeDFASimulator<T>::SimulateBatch(const std::vector<std::vector<T>>& inputs, unsigned thread_count) {
+    try {
+        if (!compiled_dfa) {
+            compiled_dfa = std::make_shared<const dfa_model::CompiledDFA<T>>(compiled_dfa_helper::compile_dfa(dfa));
+        }
+        return compiled_dfa_helper::simulate_batch(*compiled_dfa, inputs, thread_count);
+    }
+    catch (const std::exception &e) {
+        std::string error_message = "Error simulating batch: ";
+        error_message += e.what();
+        spdlog::error(error_message);
+        throw std::runtime_error(error_message);
+    }
+}
+
 template<typename T>
 bool multitype_dfa_simulator_helper::CheckSingleCharInSingleState(const dfa_model::DFA<T>& dfa, const std::string& state, const T& input_char) {
     // Check if the state exists in the DFA
@@ -2,11 +2,18 @@
 #define STANDARD_DFA_SIMULATOR_H
 
 #include "dfa_simulator.h"
+#include "compiled_dfa.h"
+#include "accepted_string_enumerator.h"
+#include <memory>
+#include <optional>
+#include <random>
 
 class StandardDFASimulator : public DFASimulator<char>
 {
 private:
     dfa_model::DFA<char> dfa;
+    // dense copy of the DFA for batch simulation and string generation, compiled on first use
+    mutable std::shared_ptr<const dfa_model::CompiledDFA<char>> compiled_dfa;
 
 public:
     StandardDFASimulator() = default;
@@ -18,9 +25,21 @@ public:
     // simulate an array of characters with type T
     bool SimulateString(const std::vector<char>& input) override;
 
+    // 批量模拟，不逐条记录日志
+    std::vector<bool> SimulateBatch(const std::vector<std::vector<char>>& inputs, unsigned thread_count = 1) override;
+
     // 生成所有符合规则的字符串
     std::set<std::string> GenerateAcceptedStrings(int max_length) const;
 
+    // 按长度统计接受的字符串数量，result[k]为长度恰好为k的数量，溢出时饱和为UINT64_MAX
+    std::vector<uint64_t> CountAcceptedStrings(int max_length) const;
+
+    // 按shortlex顺序惰性枚举长度不超过max_length的接受字符串
+    dfa_model::AcceptedStringEnumerator<char> EnumerateAcceptedStrings(int max_length) const;
+
+    // 按长度均匀随机采样一个接受字符串，不存在时返回std::nullopt
+    std::optional<std::string> SampleAcceptedString(int length, std::mt19937_64 &random_engine) const;
+
 private:
     // 检查单个字符在单个状态是否能转移
     bool CheckSingleCharInSingleState(const std::string &state, const char input_char) const;
@@ -31,8 +50,8 @@ private:
     // 检查单个状态是否为接受状态
     bool IsAcceptState(const std::string &state) const;
 
-    // 递归生成符合规则的字符串
-    void GenerateAcceptedStrings(const std::string &current_string, const std::string &current_state, int max_length, std::set<std::string> &accepted_strings) const;
+    // 获取编译后的DFA，必要时重新编译
+    std::shared_ptr<const dfa_model::CompiledDFA<char>> GetCompiledDFA() const;
 };
 
 #endif // !STANDARD_DFA_SIMULATOR_H
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef CFG_REDUCING_GENERATOR_H
+#define CFG_REDUCING_GENERATOR_H
+
+#include "cfg_model.h"
+#include "cfg_reducer.h"
+
+// grammar reduction shared by the LR and LL(1) table generators
+class CFGReducingGenerator
+{
+public:
+    // useless symbols are removed from the input grammar before generation, on by default
+    void set_reduce_cfg(bool enabled) { reduce_cfg_enabled = enabled; }
+    bool get_reduce_cfg() const { return reduce_cfg_enabled; }
+    // what the reduction removed from the grammar of the last generation call
+    const cfg_model::CFGReductionReport &get_last_reduction_report() const { return last_reduction_report; }
+
+protected:
+    CFGReducingGenerator() = default;
+    ~CFGReducingGenerator() = default;
+
+    // the grammar a generation call actually works on
+    cfg_model::CFG prepare_cfg(const cfg_model::CFG &cfg)
+    {
+        last_reduction_report = cfg_model::CFGReductionReport();
+        if (!reduce_cfg_enabled)
+        {
+            return cfg;
+        }
+        cfg_model::CFGReductionResult reduction = cfg_reducer_helper::reduce_cfg(cfg);
+        last_reduction_report = reduction.report;
+        return reduction.reduced_cfg;
+    }
+
+private:
+    bool reduce_cfg_enabled = true;
+    cfg_model::CFGReductionReport last_reduction_report;
+};
+
+#endif // !CFG_REDUCING_GENERATOR_H
@@ -0,0 +1,105 @@
+#ifndef COMPILED_LR_TABLE_H
+#define COMPILED_LR_TABLE_H
+
+#include "lr_parsing_model.h"
+#include "cfg_model.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// compiled LR parsing table
+// an integer-indexed copy of lr_parsing_model::LRParsingTable for the parser driver,
+// the string-keyed table stays the generators' output and the editable representation
+namespace lr_parsing_model
+{
+    // sparse rows packed into one array by row displacement (comb vector):
+    // cell (row, column) lives at base[row] + column if check there names the row, else it holds the row's default
+    struct CombVector
+    {
+        static constexpr uint32_t empty_slot = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> base;  // row -> offset of column 0 in values / check
+        std::vector<int32_t> values;
+        std::vector<uint32_t> check; // slot -> row owning it, empty_slot if none
+        // padded by the column count past the last base, so a lookup never goes out of bounds
+
+        int32_t find(uint32_t row, uint32_t column, int32_t fallback) const
+        {
+            size_t slot = static_cast<size_t>(base[row]) + column;
+            return check[slot] == row ? values[slot] : fallback;
+        }
+    };
+
+    struct CompiledLRTable
+    {
+        // actions are tagged int32: the low 2 bits are the kind, the rest is the shift target or the production id
+        enum ActionKind : int32_t
+        {
+            ERROR = 0,
+            SHIFT = 1,
+            REDUCE = 2,
+            ACCEPT = 3,
+        };
+        static constexpr int32_t error_action = ERROR;
+        static constexpr int32_t conflict_action = (1 << 2) | ERROR; // a cell with several actions, an error once reached
+        static constexpr int32_t accept_action = ACCEPT;
+        static constexpr uint32_t invalid_id = std::numeric_limits<uint32_t>::max();
+
+        static constexpr int32_t make_shift(uint32_t state) { return static_cast<int32_t>(state << 2) | SHIFT; }
+        static constexpr int32_t make_reduce(uint32_t production) { return static_cast<int32_t>(production << 2) | REDUCE; }
+        static constexpr ActionKind action_kind(int32_t action) { return static_cast<ActionKind>(action & 3); }
+        static constexpr uint32_t action_value(int32_t action) { return static_cast<uint32_t>(action) >> 2; }
+
+        // all a reduce needs: pop rhs_length entries, then goto on lhs
+        struct Production
+        {
+            uint32_t lhs;        // non-terminal id, invalid_id for productions the table never reduces
+            uint32_t rhs_length;
+        };
+
+        uint32_t state_count = 0;
+        uint32_t start_state = invalid_id;
+        uint32_t end_terminal = invalid_id;                              // the terminal with special property END
+        std::vector<std::string> state_names;                            // state id -> state name, the start state is 0
+        std::vector<cfg_model::symbol> terminals;                        // terminal id -> terminal, sorted by name
+        std::unordered_map<std::string, uint32_t> terminal_ids_by_name;  // token types are terminal names
+        std::vector<cfg_model::symbol> non_terminals;                    // non-terminal id -> non-terminal, sorted by name
+        std::unordered_map<cfg_model::symbol, uint32_t> non_terminal_ids;
+        std::vector<Production> productions;                             // grammar production id -> production, ids of reduce actions
+
+        std::vector<int32_t> default_actions; // state -> its most frequent reduce, or error_action
+        CombVector action_rows;               // rows are states, columns terminals, cells that differ from the default
+        std::vector<uint32_t> default_gotos;  // non-terminal -> its most frequent target state
+        CombVector goto_columns;              // rows are non-terminals, columns states, cells that differ from the default
+
+        int32_t action(uint32_t state, uint32_t terminal) const
+        {
+            return action_rows.find(state, terminal, default_actions[state]);
+        }
+
+        // the state after reducing to a non-terminal, only meaningful where the canonical goto exists
+        uint32_t goto_state(uint32_t state, uint32_t non_terminal) const
+        {
+            return static_cast<uint32_t>(goto_columns.find(non_terminal, state, static_cast<int32_t>(default_gotos[non_terminal])));
+        }
+
+        // invalid_id if the table has no such terminal
+        uint32_t find_terminal(const std::string &name) const;
+    };
+};
+
+namespace compiled_lr_table_helper
+{
+    // compile a parsing table into its integer form
+    // "empty" actions and cells out of the table are errors, cells with several actions become conflict_action,
+    // with default reductions on, the error cells of a state take its most frequent reduce (errors are still found before the next shift)
+    // throws if a goto cell has several targets
+    lr_parsing_model::CompiledLRTable compile_lr_table(const lr_parsing_model::LRParsingTable &parsing_table, bool default_reductions = true);
+
+    // pack sparse rows of (column, value) pairs, first fit with the fullest rows first
+    lr_parsing_model::CombVector pack_comb_vector(const std::vector<std::vector<std::pair<uint32_t, int32_t>>> &rows, uint32_t column_count);
+}
+
+#endif // !COMPILED_LR_TABLE_H
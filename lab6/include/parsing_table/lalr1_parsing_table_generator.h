@@ -0,0 +1,52 @@
+#ifndef LALR1_PARSING_TABLE_GENERATOR_H
+#define LALR1_PARSING_TABLE_GENERATOR_H
+
+#include "lr_parsing_model.h"
+#include "lr_parsing_table_generator.h"
+#include "lr1_parsing_table_generator.h"
+#include "itemset_generator.h"
+#include "itemset_to_parsing_table.h"
+#include "cfg_model.h"
+#include "cfg_analyzer.h"
+#include "dfa_model.h"
+#include <memory>
+#include <unordered_map>
+#include <string>
+
+// LALR(1) table on top of the LR(0) automaton, built once
+// lookaheads of the completed items come from the DeRemer & Pennello relations (reads, includes, lookback),
+// so the table has exactly as many states as the LR(0) one
+class LALR1ParsingTableGenerator : public LRParsingTableGenerator
+{
+public:
+    LALR1ParsingTableGenerator() = default;
+    ~LALR1ParsingTableGenerator() override = default;
+
+    lr_parsing_model::LRParsingTable generate_parsing_table(const cfg_model::CFG &cfg) override;
+    lr_parsing_model::ItemSet generate_item_set(const cfg_model::CFG &cfg) override;
+
+    // the LR(0) automaton with its items as LR(1) items, in the same shape as the LR(1) generator result
+    // completed items carry their LALR(1) lookaheads, S' items carry END, the other items carry none
+    lr_parsing_model::LR1ItemSetDFAGenerationResult generate_item_set_dfa(const cfg_model::CFG &cfg);
+
+private:
+    LR1ItemPool pool_;
+};
+
+namespace lalr1_parsing_table_generator_helper
+{
+    // LR(0) state -> completed item A -> ω · -> LA(state, A -> ω) as terminal bits of the analyzer
+    using LookaheadTable = std::unordered_map<std::string, std::unordered_map<lr_parsing_model::Item, cfg_model::TerminalSet>>;
+
+    // DeRemer & Pennello over the non-terminal transitions (p, A) of the LR(0) automaton
+    // 1. Read(p, A) = DR(p, A) ∪ Read over (p, A) reads (goto(p, A), C) with C nullable
+    // 2. Follow(p, A) = Read(p, A) ∪ Follow over (p, A) includes (p', B), B -> β A γ, γ nullable, p' --β--> p
+    // 3. LA(q, A -> ω) = ∪ Follow(p, A) over (q, A -> ω) lookback (p, A), p --ω--> q
+    // the analyzer must be built on the expanded grammar and have computeFirstSet done
+    LookaheadTable compute_lalr1_lookaheads(
+        const lr_parsing_model::ItemSetDFAGenerationResult &lr0_dfa_result,
+        const lr_parsing_model::ItemSet &lr0_item_set,
+        const CFGAnalyzer &cfg_analyzer);
+}
+
+#endif // !LALR1_PARSING_TABLE_GENERATOR_H
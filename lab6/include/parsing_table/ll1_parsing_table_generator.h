@@ -0,0 +1,27 @@
+#ifndef LL1_PARSING_TABLE_GENERATOR_H
+#define LL1_PARSING_TABLE_GENERATOR_H
+
+#include "ll_parsing_model.h"
+#include "cfg_model.h"
+#include "cfg_reducing_generator.h"
+#include <vector>
+
+// predictive LL(1) table from FIRST/FOLLOW, no item sets are built
+// M[A, a] holds A -> α for every a in FIRST(α), and for every a in FOLLOW(A) if α derives ε
+class LL1ParsingTableGenerator : public CFGReducingGenerator
+{
+public:
+    LL1ParsingTableGenerator() = default;
+    ~LL1ParsingTableGenerator() = default;
+
+    // conflicts do not throw, they are kept in the table and reported through get_last_conflicts
+    ll_parsing_model::LL1ParsingTable generate_parsing_table(const cfg_model::CFG &cfg);
+
+    // LL(1) conflicts of the last generated table, empty if the grammar is LL(1)
+    const std::vector<ll_parsing_model::LL1Conflict> &get_last_conflicts() const { return last_conflicts; }
+
+private:
+    std::vector<ll_parsing_model::LL1Conflict> last_conflicts;
+};
+
+#endif // !LL1_PARSING_TABLE_GENERATOR_H
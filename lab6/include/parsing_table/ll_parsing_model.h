@@ -0,0 +1,43 @@
+#ifndef LL_PARSING_MODEL_H
+#define LL_PARSING_MODEL_H
+
+#include "cfg_model.h"
+#include "spdlog/spdlog.h"
+#include <unordered_set>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+namespace ll_parsing_model
+{
+    // a cell of the predictive table that predicts more than one production
+    struct LL1Conflict
+    {
+        cfg_model::symbol non_terminal;
+        cfg_model::symbol lookahead;
+        std::vector<std::vector<cfg_model::symbol>> candidate_rhs; // sorted by symbol names, empty rhs is epsilon
+
+        // string representation
+        operator std::string() const;
+    };
+
+    // predictive parsing table M[non-terminal][terminal] -> rhs to expand with
+    struct LL1ParsingTable
+    {
+        std::unordered_set<cfg_model::symbol> all_symbols;
+        cfg_model::symbol start_symbol; // start symbol of the (non-expanded) grammar, the driver starts here
+        cfg_model::symbol end_symbol;   // the terminal with special property END
+        std::unordered_map<cfg_model::symbol, std::unordered_map<cfg_model::symbol, std::unordered_set<std::vector<cfg_model::symbol>>>> prediction_table; // conflict tolerant
+
+        // returns false if the prediction already exists, a second prediction in a cell is kept silently as a conflict
+        bool add_prediction(const cfg_model::symbol &non_terminal, const cfg_model::symbol &lookahead, const std::vector<cfg_model::symbol> &rhs);
+
+        // nullptr if the cell is empty
+        const std::unordered_set<std::vector<cfg_model::symbol>> *get_predictions(const cfg_model::symbol &non_terminal, const cfg_model::symbol &lookahead) const;
+
+        // find all the cells with more than one prediction, ordered by (non-terminal, lookahead) names
+        std::vector<LL1Conflict> find_conflicts() const;
+    };
+};
+
+#endif // !LL_PARSING_MODEL_H
@@ -6,47 +6,92 @@
 #include "itemset_generator.h"
 #include "itemset_to_parsing_table.h"
 #include "cfg_model.h"
+#include "cfg_analyzer.h"
 #include "nfa_model.h"
 #include "dfa_model.h"
 #include "standard_nfa_dfa_converter.h"
 #include <memory>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <mutex>
+#include <atomic>
 
+// the LR(1) items of one grammar, interned by (LR(0) core, lookahead set id)
+// items are stored once, in a monotonic arena, and named by 32-bit handles (their arena index)
+// the generator works on handles only, copying one is free where a shared_ptr copy is an atomic refcount update
+// the shared_ptrs handed out alias the arena, they keep it alive without owning an item each,
+// they are only made for the item sets returned to callers
+// interning is safe from several threads: the index is split into shards, each under its own lock
 class LR1ItemPool {
 public:
+    using Handle = uint32_t;
+
+    LR1ItemPool();
+
+    // start over for a new grammar, lookahead sets are interned in the given table from now on
+    // items handed out before stay valid, the pool must not be in use by other threads meanwhile
+    void reset(std::shared_ptr<lr_parsing_model::LookaheadSetTable> lookahead_table);
+    const std::shared_ptr<lr_parsing_model::LookaheadSetTable>& get_lookahead_table() const { return lookahead_table_; }
+
+    // the handle of an item, created on first use, the set id must come from the pool's lookahead table
+    Handle intern(const lr_parsing_model::Item& item, uint32_t lookahead_set_id);
+    Handle intern(const lr_parsing_model::Item& item, const cfg_model::TerminalSet& lookahead_bits);
+    // an LR(1) item of any lookahead table, re-interned by its symbols if the table is not the pool's
+    Handle intern(const lr_parsing_model::LR1Item& item);
+    const lr_parsing_model::LR1Item& item(Handle handle) const { return (*arena_)[handle]; }
+    std::shared_ptr<lr_parsing_model::LR1Item> item_ptr(Handle handle) const;
+    // items interned since the last reset
+    size_t size() const { return arena_->size(); }
+
     // 通过内容获取唯一shared_ptr
     std::shared_ptr<lr_parsing_model::LR1Item> get_or_create(const lr_parsing_model::Item& item, const cfg_model::symbol& lookahead) {
-        lr_parsing_model::LR1Item key(item, lookahead);
-        return get_or_create_impl(key);
+        return get_or_create(item, std::unordered_set<cfg_model::symbol>{lookahead});
     }
     std::shared_ptr<lr_parsing_model::LR1Item> get_or_create(const lr_parsing_model::Item& item, const std::unordered_set<cfg_model::symbol>& lookahead) {
-        lr_parsing_model::LR1Item key(item, lookahead);
-        return get_or_create_impl(key);
+        return item_ptr(intern(item, checked_lookahead_table().intern(lookahead)));
+    }
+    std::shared_ptr<lr_parsing_model::LR1Item> get_or_create(const lr_parsing_model::Item& item, const cfg_model::TerminalSet& lookahead_bits) {
+        return item_ptr(intern(item, lookahead_bits));
+    }
+    std::shared_ptr<lr_parsing_model::LR1Item> get_or_create(const lr_parsing_model::Item& item, uint32_t lookahead_set_id) {
+        return item_ptr(intern(item, lookahead_set_id));
     }
     std::shared_ptr<lr_parsing_model::LR1Item> get_or_create(const lr_parsing_model::LR1Item& item) {
-        return get_or_create_impl(item);
+        return item_ptr(intern(item));
     }
     std::shared_ptr<lr_parsing_model::LR1Item> get_or_create(const std::shared_ptr<lr_parsing_model::LR1Item>& item_ptr) {
-        return get_or_create_impl(*item_ptr);
+        return get_or_create(*item_ptr);
     }
+
 private:
-    std::unordered_map<lr_parsing_model::LR1Item, std::shared_ptr<lr_parsing_model::LR1Item>> pool_;
-    std::mutex mutex_;
-    std::shared_ptr<lr_parsing_model::LR1Item> get_or_create_impl(const lr_parsing_model::LR1Item& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = pool_.find(key);
-        if (it != pool_.end()) return it->second;
-        auto ptr = std::make_shared<lr_parsing_model::LR1Item>(key);
-        pool_.emplace(*ptr, ptr);
-        return ptr;
-    }
+    static constexpr size_t shard_count = 16;
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, Handle> handles; // (packed LR(0) core << 32 | lookahead set id) -> handle
+    };
+    using Arena = lr_parsing_model::MonotonicArena<lr_parsing_model::LR1Item>;
+
+    std::shared_ptr<lr_parsing_model::LookaheadSetTable> lookahead_table_;
+    std::atomic<const lr_parsing_model::ProductionTable*> production_table_{nullptr}; // of the first item since the last reset
+    std::shared_ptr<Arena> arena_;
+    std::unique_ptr<Shard[]> shards_;
+
+    lr_parsing_model::LookaheadSetTable& checked_lookahead_table() const;
+    void check_production_table(const lr_parsing_model::Item& item);
 };
 
 class LR1ParsingTableGenerator : public LRParsingTableGenerator
 {
 public:
+    // how states with the same LR(0) core are handled while the automaton is explored
+    enum class StateMerging
+    {
+        CANONICAL,                // one state per distinct LR(1) closure
+        PAGER_WEAK_COMPATIBILITY, // merge into a same-core state whenever Pager's weak compatibility test allows it
+    };
+
     LR1ParsingTableGenerator() = default;
     ~LR1ParsingTableGenerator() override = default;
 
@@ -56,8 +101,21 @@ public:
     // the LR1 table generation is completely DFA-based, thus not providing NFA generation
     lr_parsing_model::LR1ItemSetDFAGenerationResult generate_item_set_dfa(const cfg_model::CFG &cfg);
 
+    // canonical by default, merged automata keep LR(1) power with a state count close to LALR(1)
+    void set_state_merging(StateMerging merging) { state_merging = merging; }
+    StateMerging get_state_merging() const { return state_merging; }
+    // how many times a new kernel was merged into an existing state during the last DFA generation
+    size_t get_last_merge_count() const { return last_merge_count; }
+    // threads expanding canonical states, 1 by default, 0 means hardware concurrency
+    // state ids do not depend on it, merged exploration always runs on the calling thread
+    void set_thread_count(unsigned thread_count) { this->thread_count = thread_count; }
+    unsigned get_thread_count() const { return thread_count; }
+
 private:
     LR1ItemPool pool_; // 新增：LR1Item对象池
+    StateMerging state_merging = StateMerging::CANONICAL;
+    size_t last_merge_count = 0;
+    unsigned thread_count = 1;
 };
 
 namespace lr1_parsing_table_generator_helper
@@ -68,6 +126,9 @@ namespace lr1_parsing_table_generator_helper
         SHIFT_OVER_REDUCE, // shift over reduce
         REDUCE_OVER_SHIFT, // reduce over shift
     };
+    // shift/goto/reduce/accept actions of an LR(1)-item automaton, reduces only on the lookaheads of the completed items
+    // conflicts are resolved with resolve_conflicts, the automaton may also be an LR(0) one annotated with LALR(1) lookaheads
+    lr_parsing_model::LRParsingTable build_parsing_table(const lr_parsing_model::LR1ItemSetDFAGenerationResult &item_set_dfa_result);
     // generate LR(1) parsing table to item set mapping
     lr_parsing_model::ItemSetParsingTableMapping generate_item_set_parsing_table_mapping(
         const lr_parsing_model::LRParsingTable &parsing_table,
@@ -85,15 +146,149 @@ namespace lr1_parsing_table_generator_helper
     // generate a blank LR(1) item set from an LR(0) item set
     lr_parsing_model::ItemSet generate_blank_lr1_item_set(const lr_parsing_model::ItemSet &item_set, LR1ItemPool& pool);
 
+    // constant-time lookups into an LR(0) item set, built once per DFA construction
+    struct LR0ItemIndex
+    {
+        std::unordered_map<cfg_model::symbol, std::vector<std::shared_ptr<lr_parsing_model::Item>>> initial_items_by_lhs; // A -> · α
+        std::unordered_map<lr_parsing_model::Item, std::shared_ptr<lr_parsing_model::Item>> items_by_content;
+        std::unordered_map<lr_parsing_model::Item, uint32_t> ids_by_content; // dense ids in [0, item count)
+
+        explicit LR0ItemIndex(const lr_parsing_model::ItemSet &lr0_item_set);
+
+        // the dense id of an item (the LR(0) core of an LR(1) item), throws if the item set does not contain it
+        uint32_t item_id(const lr_parsing_model::Item &item) const;
+
+        // the items A -> · α of a non-terminal, empty for terminals
+        const std::vector<std::shared_ptr<lr_parsing_model::Item>> &initial_items(const cfg_model::symbol &lhs) const;
+        // A -> α X · β for A -> α · X β, throws if the item set does not contain it
+        const std::shared_ptr<lr_parsing_model::Item> &advance(const lr_parsing_model::Item &item) const;
+    };
+
+    // lookahead sets numbered like the analyzer's terminal bits, so its FIRST bitsets are interned as they are
+    std::shared_ptr<lr_parsing_model::LookaheadSetTable> make_lookahead_set_table(const CFGAnalyzer &cfg_analyzer);
+
+    // the LR(0) closure of every non-terminal A, computed once per grammar
+    // an item of the closure of A gets its spontaneous lookaheads whatever A was introduced with,
+    // and also the lookaheads of A if it propagates them (every suffix on the way to it derives ε)
+    // the LR(1) closure is linear in the lookaheads, so it is a union of instantiated templates
+    struct LR1ClosureTemplates
+    {
+        struct Entry
+        {
+            std::shared_ptr<lr_parsing_model::Item> core;
+            cfg_model::TerminalSet spontaneous;
+            bool propagated;
+        };
+        // what closing A -> α · B β adds: the template of B, introduced with FIRST(β), and with the item's lookaheads if β =>* ε
+        struct ItemRule
+        {
+            uint32_t template_id;
+            cfg_model::TerminalSet first_of_rest;
+            bool rest_nullable;
+        };
+
+        size_t terminal_count = 0;
+        std::vector<std::vector<Entry>> templates;            // by template id, one entry per LR(0) core
+        std::unordered_map<cfg_model::symbol, uint32_t> template_ids;
+        std::unordered_map<uint32_t, ItemRule> rules_by_core; // packed core -> rule, items before a non-terminal only
+
+        // the analyzer must have computeSuffixFirstSets done and be built on the grammar of the item set
+        LR1ClosureTemplates(const LR0ItemIndex &lr0_item_index, const CFGAnalyzer &cfg_analyzer);
+
+        // the rule of an item, nullptr if nothing follows its dot or a terminal does
+        const ItemRule *rule(const lr_parsing_model::Item &item) const;
+        // the template of a non-terminal, empty for terminals
+        const std::vector<Entry> &closure_template(const cfg_model::symbol &non_terminal) const;
+    };
+
+    // a kernel or a closure while the automaton is explored: pool handles in ascending order, one per LR(0) core
+    // handles name interned (core, lookahead set) pairs, so equal item sets are equal vectors
+    using LR1ItemHandles = std::vector<LR1ItemPool::Handle>;
+
     // generate a set of LR(1) items from an LR(0) item and their lookahead symbols
+    // lookaheads come from the analyzer's suffix first sets, so computeSuffixFirstSets must have run
+    // the closure has one item per LR(0) core, lookaheads reaching a core twice are united (bitwise or)
+    // the pool must have been reset with make_lookahead_set_table of the same analyzer
+    // the first two overloads build the closure templates for this call only, the shared_ptr overloads wrap the handle one
     std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> grow_closure(
         const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &initial_items,
         const lr_parsing_model::ItemSet &reference_lr0_item_set,
-        const cfg_model::CFG &cfg,
-        const cfg_model::FirstSet &first_set,
-        const cfg_model::FollowSet &follow_set,
+        const CFGAnalyzer &cfg_analyzer,
+        LR1ItemPool& pool);
+    std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> grow_closure(
+        const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &initial_items,
+        const LR0ItemIndex &lr0_item_index,
+        const CFGAnalyzer &cfg_analyzer,
+        LR1ItemPool& pool);
+    // no fixpoint: the templates of the non-terminals after the kernel dots are instantiated once each,
+    // with the lookaheads of all kernel items introducing them united first
+    std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> grow_closure(
+        const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &initial_items,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool& pool);
+    LR1ItemHandles grow_closure(
+        const LR1ItemHandles &kernel,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool& pool);
+
+    // the kernels of every successor of a closure in one pass, keyed by the symbol after the dot
+    // symbols that follow no dot in the closure get no entry, every kernel has one item per LR(0) core
+    std::unordered_map<cfg_model::symbol, LR1ItemHandles> generate_goto_kernels(
+        const LR1ItemHandles &closure,
+        const LR0ItemIndex &lr0_item_index,
         LR1ItemPool& pool);
 
+    // identity of a canonical LR(1) state: its kernel handles, hashed once
+    // the closure is a function of the kernel, so states are told apart without growing or naming closures
+    // kernels have one item per core (see generate_goto_kernels), so equal states have equal keys
+    struct LR1KernelKey
+    {
+        LR1ItemHandles items;
+        size_t hash = 0;
+
+        bool operator==(const LR1KernelKey &other) const { return hash == other.hash && items == other.items; }
+    };
+    struct LR1KernelKeyHash
+    {
+        size_t operator()(const LR1KernelKey &key) const { return key.hash; }
+    };
+    LR1KernelKey make_kernel_key(const LR1ItemHandles &kernel);
+
+    // one state of an explored LR(1) automaton, only merged exploration keeps the kernel per LR(0) core item
+    struct LR1KernelState
+    {
+        std::vector<std::shared_ptr<lr_parsing_model::Item>> core; // LR(0) kernel items, ordered by item id
+        std::vector<cfg_model::TerminalSet> lookaheads;            // lookaheads of each core item
+        LR1ItemHandles closure;
+        std::unordered_map<cfg_model::symbol, uint32_t> successors;
+    };
+
+    // Pager's weak compatibility of two lookahead vectors over the same core: for every i != j,
+    // either no cross pair L_i ∩ L'_j, L'_i ∩ L_j meets, or one of L_i ∩ L_j, L'_i ∩ L'_j is already non-empty
+    // every intersection test is a word-wise and of the bitsets
+    bool weakly_compatible(
+        const std::vector<cfg_model::TerminalSet> &lookaheads,
+        const std::vector<cfg_model::TerminalSet> &other_lookaheads);
+
+    // explore the LR(1) automaton, merging every new kernel into a weakly compatible state of the same core
+    // a state whose lookaheads grow is expanded again, states no longer reachable from state 0 are dropped
+    std::vector<LR1KernelState> explore_merged_states(
+        const LR1ItemHandles &initial_kernel,
+        const LR0ItemIndex &lr0_item_index,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool &pool,
+        size_t &merge_count);
+
+    // explore the canonical LR(1) automaton, frontier states are expanded in parallel on a work-stealing pool
+    // new states are deduplicated through a sharded kernel table and renumbered breadth-first at the end,
+    // successors in symbol name order, so the ids are the same for every thread count
+    std::vector<LR1KernelState> explore_canonical_states(
+        const LR1ItemHandles &initial_kernel,
+        const LR0ItemIndex &lr0_item_index,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool &pool,
+        unsigned thread_count);
+
     // generate the initial closure items from an existing closure by moving in one symbol
     std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> generate_initial_closure(
         const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &closure_items,
@@ -104,7 +299,11 @@ namespace lr1_parsing_table_generator_helper
         const cfg_model::FollowSet &follow_set,
         LR1ItemPool& pool);
 
-    // generate a unique DFA name string for an LR(1) closure set
+    // DFA state name of the state with the given id, states are numbered in discovery order
+    std::string generate_lr1_state_name(uint32_t state_id);
+
+    // display name of an LR(1) closure: all its items, sorted, one per line
+    // only built on demand (visualization, debugging), states are not identified by it
     std::string generate_lr1_closure_name(const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &closure_items);
 }
 
@@ -11,21 +11,117 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
 
 namespace lr_parsing_model
 {
+    // a production lhs -> rhs of an item set, items only refer to it by id
+    struct Production
+    {
+        cfg_model::symbol lhs;
+        std::vector<cfg_model::symbol> rhs; // empty for epsilon
+        size_t hash = 0;                    // of lhs & rhs, item hashes start from it
+    };
+
+    // the productions of one expanded grammar, ids are dense and never change once added
+    // shared (read-only) by every item of the item set and by the LR(1) items derived from it
+    class ProductionTable
+    {
+    public:
+        static constexpr uint32_t invalid_production = std::numeric_limits<uint32_t>::max();
+
+        ProductionTable() = default;
+        // the numbered productions in id order, so that table ids are the grammar's production ids
+        explicit ProductionTable(const cfg_model::ProductionNumbering &numbering);
+
+        // id of lhs -> rhs, the production is added if it is not in the table yet
+        uint32_t add_production(const cfg_model::symbol &lhs, const std::vector<cfg_model::symbol> &rhs);
+        // invalid_production if the table does not have it
+        uint32_t find_production(const cfg_model::symbol &lhs, const std::vector<cfg_model::symbol> &rhs) const;
+
+        const Production &production(uint32_t production_id) const { return productions[production_id]; }
+        size_t size() const { return productions.size(); }
+
+    private:
+        std::vector<Production> productions;
+        std::unordered_map<cfg_model::symbol, std::vector<uint32_t>> productions_by_lhs;
+    };
+
+    // read-only view over a run of production symbols, converts to a vector where one is needed
+    class SymbolSpan
+    {
+    public:
+        SymbolSpan() = default;
+        SymbolSpan(const cfg_model::symbol *first, const cfg_model::symbol *last) : first(first), last(last) {}
+
+        const cfg_model::symbol *begin() const { return first; }
+        const cfg_model::symbol *end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+        const cfg_model::symbol &operator[](size_t index) const { return first[index]; }
+
+        operator std::vector<cfg_model::symbol>() const { return std::vector<cfg_model::symbol>(first, last); }
+
+        bool operator==(const SymbolSpan &other) const { return std::equal(first, last, other.first, other.last); }
+        friend bool operator==(const SymbolSpan &span, const std::vector<cfg_model::symbol> &symbols)
+        {
+            return std::equal(span.first, span.last, symbols.begin(), symbols.end());
+        }
+        friend bool operator==(const std::vector<cfg_model::symbol> &symbols, const SymbolSpan &span) { return span == symbols; }
+
+    private:
+        const cfg_model::symbol *first = nullptr;
+        const cfg_model::symbol *last = nullptr;
+    };
+
+    // a dotted production, (production id, dot) packed into 32 bits
+    // the symbols on both sides of the dot are views into the shared production table
     struct Item
     {
-        cfg_model::symbol left_side_symbol;
-        std::vector<cfg_model::symbol> sequence_already_parsed;
-        std::vector<cfg_model::symbol> sequence_to_parse;
+        static constexpr uint32_t dot_bits = 8;
+        static constexpr uint32_t max_dot = (1u << dot_bits) - 1;
+        static constexpr uint32_t max_production_id = (1u << (32 - dot_bits)) - 1;
 
-        // overload the equality operator
+        std::shared_ptr<const ProductionTable> production_table;
+        uint32_t packed = 0; // production id << dot_bits | dot
+
+        Item() = default;
+        // throws if the dot is past the end of the production or the ids do not fit
+        Item(std::shared_ptr<const ProductionTable> production_table, uint32_t production_id, uint32_t dot);
+
+        uint32_t production_id() const { return packed >> dot_bits; }
+        uint32_t dot() const { return packed & max_dot; }
+        const Production &production() const { return production_table->production(production_id()); }
+
+        const cfg_model::symbol &left_side_symbol() const { return production().lhs; }
+        SymbolSpan sequence_already_parsed() const
+        {
+            const auto &rhs = production().rhs;
+            return SymbolSpan(rhs.data(), rhs.data() + dot());
+        }
+        SymbolSpan sequence_to_parse() const
+        {
+            const auto &rhs = production().rhs;
+            return SymbolSpan(rhs.data() + dot(), rhs.data() + rhs.size());
+        }
+
+        // the item with the dot moved over the next symbol, throws if the item is complete
+        Item advanced() const;
+
+        // items of the same table compare by id, items of different tables by content
         bool operator==(const Item &other) const
         {
-            return left_side_symbol == other.left_side_symbol &&
-                   sequence_already_parsed == other.sequence_already_parsed &&
-                   sequence_to_parse == other.sequence_to_parse;
+            if (production_table == other.production_table)
+            {
+                return packed == other.packed;
+            }
+            return dot() == other.dot() &&
+                   left_side_symbol() == other.left_side_symbol() &&
+                   production().rhs == other.production().rhs;
         }
 
         // string representation
@@ -34,43 +130,160 @@ namespace lr_parsing_model
         // helper functions
         bool is_accepting() const
         {
-            return sequence_to_parse.empty();
+            return dot() == production().rhs.size();
         }
 
         bool is_complete() const
         {
-            return sequence_already_parsed.empty() && sequence_to_parse.empty();
+            return production().rhs.empty();
+        }
+    };
+
+    // append-only storage addressed by 32-bit indices, elements never move and live as long as the arena
+    // chunk k holds 1024 << k elements, so 23 chunks cover every index and a lookup is two shifts
+    // allocating is lock-free, an element may be read from any thread once its index was handed over under a lock
+    template <typename T>
+    class MonotonicArena
+    {
+    public:
+        MonotonicArena() = default;
+        MonotonicArena(const MonotonicArena &) = delete;
+        MonotonicArena &operator=(const MonotonicArena &) = delete;
+        ~MonotonicArena()
+        {
+            for (auto &chunk : chunks)
+            {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+
+        // index of a new default-constructed element
+        uint32_t allocate()
+        {
+            uint32_t index = next.fetch_add(1, std::memory_order_relaxed);
+            if (index == std::numeric_limits<uint32_t>::max())
+            {
+                throw std::runtime_error("MonotonicArena is full");
+            }
+            size_t chunk, offset;
+            locate(index, chunk, offset);
+            if (chunks[chunk].load(std::memory_order_acquire) == nullptr)
+            {
+                T *new_chunk = new T[first_chunk_size << chunk]();
+                T *expected = nullptr;
+                if (!chunks[chunk].compare_exchange_strong(expected, new_chunk, std::memory_order_acq_rel))
+                {
+                    delete[] new_chunk; // another thread got there first
+                }
+            }
+            return index;
+        }
+
+        T &operator[](uint32_t index)
+        {
+            size_t chunk, offset;
+            locate(index, chunk, offset);
+            return chunks[chunk].load(std::memory_order_acquire)[offset];
+        }
+        const T &operator[](uint32_t index) const
+        {
+            size_t chunk, offset;
+            locate(index, chunk, offset);
+            return chunks[chunk].load(std::memory_order_acquire)[offset];
         }
+
+        // elements allocated so far
+        uint32_t size() const { return next.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr uint32_t first_chunk_bits = 10;
+        static constexpr size_t first_chunk_size = size_t(1) << first_chunk_bits;
+        static constexpr size_t chunk_count = 32 - first_chunk_bits + 1;
+
+        static void locate(uint32_t index, size_t &chunk, size_t &offset)
+        {
+            uint64_t shifted = uint64_t(index) + first_chunk_size;
+            unsigned top_bit = 63u - static_cast<unsigned>(__builtin_clzll(shifted));
+            chunk = top_bit - first_chunk_bits;
+            offset = static_cast<size_t>(shifted - (uint64_t(1) << top_bit));
+        }
+
+        std::atomic<T *> chunks[chunk_count] = {};
+        std::atomic<uint32_t> next{0};
     };
 
+    // the lookahead sets of one expanded grammar as interned terminal bitsets, bit i of a set stands for terminals[i]
+    // equal sets get equal ids, set 0 is the empty set, ids never change once given out
+    // interning may happen from several threads, sets are read without locking
+    class LookaheadSetTable
+    {
+    public:
+        static constexpr uint32_t empty_set = 0;
+
+        explicit LookaheadSetTable(std::vector<cfg_model::symbol> terminals);
+
+        uint32_t intern(const cfg_model::TerminalSet &bits);
+        // throws if a symbol is not one of the terminals
+        uint32_t intern(const std::unordered_set<cfg_model::symbol> &symbols);
+        // id of the union of two interned sets
+        uint32_t unite(uint32_t lookahead_set_id, uint32_t other_lookahead_set_id);
+
+        const cfg_model::TerminalSet &bits(uint32_t lookahead_set_id) const { return sets[lookahead_set_id].bits; }
+        // the set as symbols, materialized once per interned set
+        const std::unordered_set<cfg_model::symbol> &symbols(uint32_t lookahead_set_id) const { return sets[lookahead_set_id].symbols; }
+        size_t hash(uint32_t lookahead_set_id) const { return sets[lookahead_set_id].hash; }
+
+        const std::vector<cfg_model::symbol> &get_terminals() const { return terminals; }
+        // the bit of a terminal, cfg_model::invalid_symbol_id if it is not one
+        uint32_t terminal_bit(const cfg_model::symbol &terminal) const;
+        size_t size() const { return sets.size(); }
+
+    private:
+        struct LookaheadSet
+        {
+            cfg_model::TerminalSet bits;
+            std::unordered_set<cfg_model::symbol> symbols;
+            size_t hash = 0;
+        };
+        std::vector<cfg_model::symbol> terminals;
+        std::unordered_map<cfg_model::symbol, uint32_t> bits_by_terminal;
+        MonotonicArena<LookaheadSet> sets;
+        std::mutex intern_mutex; // guards ids_by_hash and the order of new sets
+        std::unordered_map<size_t, std::vector<uint32_t>> ids_by_hash;
+    };
+
+    // an LR(0) core item plus the id of its lookahead set in a shared lookahead set table
+    // items of the same table compare by the core and the set id, neither walks a set
     struct LR1Item : public Item
     {
-        std::unordered_set<cfg_model::symbol> lookahead_symbols; // the lookahead symbol for LR(1) items
+        std::shared_ptr<const LookaheadSetTable> lookahead_table;
+        uint32_t lookahead_set_id = LookaheadSetTable::empty_set;
+
+        const std::unordered_set<cfg_model::symbol> &lookahead_symbols() const;
+        const cfg_model::TerminalSet &lookahead_bits() const;
 
         // overload the equality operator
         bool operator==(const LR1Item &other) const
         {
-            return Item::operator==(other) && lookahead_symbols == other.lookahead_symbols;
+            if (!Item::operator==(other))
+            {
+                return false;
+            }
+            if (lookahead_table == other.lookahead_table)
+            {
+                return lookahead_set_id == other.lookahead_set_id;
+            }
+            return lookahead_symbols() == other.lookahead_symbols();
         }
 
         // string representation
         operator std::string() const;
 
         // helper functions
-        // create from normal Item
-        LR1Item(const Item &item, const cfg_model::symbol &lookahead)
+        // create from normal Item and an interned lookahead set
+        LR1Item(const Item &item, std::shared_ptr<const LookaheadSetTable> lookahead_table, uint32_t lookahead_set_id)
+            : Item(item), lookahead_table(std::move(lookahead_table)), lookahead_set_id(lookahead_set_id)
         {
-            left_side_symbol = item.left_side_symbol;
-            sequence_already_parsed = item.sequence_already_parsed;
-            sequence_to_parse = item.sequence_to_parse;
-            lookahead_symbols.insert(lookahead);
-        }
-        LR1Item(const Item &item, const std::unordered_set<cfg_model::symbol> &lookahead)
-        {
-            left_side_symbol = item.left_side_symbol;
-            sequence_already_parsed = item.sequence_already_parsed;
-            sequence_to_parse = item.sequence_to_parse;
-            lookahead_symbols = lookahead;
         }
         LR1Item() = default; // default constructor for empty LR1Item
     };
@@ -85,15 +298,9 @@ namespace std
     {
         size_t operator()(const lr_parsing_model::Item &item) const
         {
-            size_t seed = hash<cfg_model::symbol>()(item.left_side_symbol) + 0x9e3779b9;
-            for (const auto &s : item.sequence_already_parsed)
-            {
-                seed ^= hash<cfg_model::symbol>()(s) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            }
-            for (const auto &s : item.sequence_to_parse)
-            {
-                seed ^= hash<cfg_model::symbol>()(s) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            }
+            // content based, equal items of different tables hash the same
+            size_t seed = item.production().hash;
+            seed ^= item.dot() + 0x9e3779b9 + (seed << 6) + (seed >> 2);
             return seed;
         }
     };
@@ -103,11 +310,10 @@ namespace std
     {
         size_t operator()(const lr_parsing_model::LR1Item &item) const
         {
+            // the set hash is content based and computed once when the set is interned
             size_t seed = hash<lr_parsing_model::Item>()(item);
-            for (const auto &s : item.lookahead_symbols)
-            {
-                seed ^= hash<cfg_model::symbol>()(s) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            }
+            size_t lookahead_hash = item.lookahead_table == nullptr ? 0 : item.lookahead_table->hash(item.lookahead_set_id);
+            seed ^= lookahead_hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
             return seed;
         }
     };
@@ -117,6 +323,7 @@ namespace lr_parsing_model
 {
     struct ItemSet
     {
+        std::shared_ptr<const ProductionTable> production_table; // the productions every item points into
         std::unordered_set<std::shared_ptr<Item>> items;
         std::shared_ptr<Item> start_item;
         std::shared_ptr<Item> end_item;
@@ -128,7 +335,7 @@ namespace lr_parsing_model
             std::unordered_set<std::shared_ptr<Item>> generation_items;
             for (const auto &item : items)
             {
-                if (item->left_side_symbol == symbol && item->sequence_already_parsed.empty())
+                if (item->left_side_symbol() == symbol && item->dot() == 0)
                 {
                     generation_items.insert(item);
                 }
@@ -186,17 +393,15 @@ namespace lr_parsing_model
     struct Action
     {
         std::string action_type = "";
-        std::string target_state = "";                       // if the action type is "shift"
-        cfg_model::symbol reduce_rule_lhs;                   // if the action type is "reduce"
-        std::vector<cfg_model::symbol> reduce_rule_rhs = {}; // if the action type is "reduce"
+        std::string target_state = "";                                       // if the action type is "shift"
+        uint32_t reduce_production = ProductionTable::invalid_production;    // if the action type is "reduce", id in the table's production_table
 
         // ==
         bool operator==(const Action &other) const
         {
             return action_type == other.action_type &&
                    target_state == other.target_state &&
-                   reduce_rule_lhs == other.reduce_rule_lhs &&
-                   reduce_rule_rhs == other.reduce_rule_rhs;
+                   reduce_production == other.reduce_production;
         }
     };
 }
@@ -212,11 +417,7 @@ namespace std
             size_t seed = 0;
             seed ^= hash<std::string>()(action.action_type) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
             seed ^= hash<std::string>()(action.target_state) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= hash<cfg_model::symbol>()(action.reduce_rule_lhs) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            for (const auto &s : action.reduce_rule_rhs)
-            {
-                seed ^= hash<cfg_model::symbol>()(s) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            }
+            seed ^= hash<uint32_t>()(action.reduce_production) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
             return seed;
         }
     };
@@ -231,6 +432,7 @@ namespace lr_parsing_model
         std::unordered_map<std::string, std::unordered_map<cfg_model::symbol, std::unordered_set<Action>>> action_table;    // conflict tolerant action table
         std::unordered_map<std::string, std::unordered_map<cfg_model::symbol, std::unordered_set<std::string>>> goto_table; // goto table, conflict tolerant
         std::string start_state; // the start state of the parsing table
+        std::shared_ptr<const ProductionTable> production_table; // the productions reduce actions refer to, ids are the grammar's production ids
 
         bool add_action(const std::string &state, const cfg_model::symbol &symbol, const Action &action);
 
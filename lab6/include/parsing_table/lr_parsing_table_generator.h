@@ -3,6 +3,7 @@
 
 #include "lr_parsing_model.h"
 #include "cfg_model.h"
+#include "cfg_reducing_generator.h"
 #include "nfa_model.h"
 #include "dfa_model.h"
 #include <unordered_map>
@@ -10,7 +11,7 @@
 #include <vector>
 #include <string>
 
-class LRParsingTableGenerator
+class LRParsingTableGenerator : public CFGReducingGenerator
 {
 public:
     virtual ~LRParsingTableGenerator() = default;
@@ -0,0 +1,40 @@
+#ifndef LR_TABLE_CODEGEN_H
+#define LR_TABLE_CODEGEN_H
+
+#include "lr_table_file.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// C++ source generation from compiled LR tables
+// the emitted header holds the table as constexpr arrays, lr_parsing_model::StaticLRParser drives a parse over them,
+// or the table is also turned into code, a recursive ascent parser
+namespace lr_table_codegen_helper
+{
+    constexpr int32_t no_node_type = -1;
+
+    struct TableHeaderOptions
+    {
+        std::string table_name;     // name of the emitted struct
+        std::string namespace_name = "generated_lr_tables";
+        std::string source;         // where the table came from, for the header comment
+        // per production id, empty / no_node_type for productions without semantic info
+        std::vector<std::string> node_type_names;
+        std::vector<int32_t> node_type_ids;
+    };
+
+    // a header defining struct <table_name> with the arrays StaticLRParser expects:
+    // the comb-vector action and goto tables in CompiledLRTable's encoding, production lengths, lhs ids and node types,
+    // terminal / non-terminal names (terminals sorted by name, as the compiled table numbers them)
+    // throws if the table name is not an identifier or the node type vectors are longer than the production table
+    std::string generate_table_header(const lr_parsing_model::StoredLRTable &table, const TableHeaderOptions &options);
+
+    // the same header, with a recursive ascent parser nested in the struct as <table_name>::RecursiveAscentParser:
+    // one function per state, lookaheads and gotos are switch cases, the call stack is the state stack
+    // its parse() has the contract of StaticLRParser::parse and drives the same shifts and reduces, default reductions included
+    // recursion goes as deep as the LR stack, which the left-recursive lists of our grammars keep shallow
+    std::string generate_recursive_ascent_header(const lr_parsing_model::LRParsingTable &parsing_table, const lr_parsing_model::LRTableFileKey &key,
+                                                 const TableHeaderOptions &options);
+}
+
+#endif // !LR_TABLE_CODEGEN_H
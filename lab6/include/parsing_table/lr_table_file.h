@@ -0,0 +1,161 @@
+#ifndef LR_TABLE_FILE_H
+#define LR_TABLE_FILE_H
+
+#include "compiled_lr_table.h"
+#include "lr_parsing_model.h"
+#include "cfg_model.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// on-disk form of a generated LR parsing table
+// a compiled table plus the production table its reduce actions refer to, keyed by the grammar file and the generator,
+// so a run with an unchanged grammar loads the table instead of generating it again
+namespace lr_parsing_model
+{
+    // the generators a table file may come from, the values are part of the file format
+    enum class TableGeneratorKind : uint32_t
+    {
+        SIMPLE_LR = 0,
+        SLR1 = 1,
+        LR1 = 2,       // canonical LR(1)
+        LR1_PAGER = 3, // LR(1) with Pager's weak compatibility merging
+        LALR1 = 4,
+    };
+
+    // version of what the generators produce, part of a table file's key
+    // bump on any change that alters a generated table for an unchanged grammar, e.g. a fix of the LALR(1) lookaheads,
+    // of Pager's merging or of the state numbering, so cached table files are regenerated instead of loaded
+    constexpr uint32_t table_generator_version = 1;
+
+    // what a table file was generated from
+    struct LRTableFileKey
+    {
+        uint64_t grammar_hash = 0; // of the grammar YAML bytes
+        TableGeneratorKind generator = TableGeneratorKind::LR1;
+        uint32_t generator_version = table_generator_version;
+
+        bool operator==(const LRTableFileKey &other) const
+        {
+            return grammar_hash == other.grammar_hash && generator == other.generator && generator_version == other.generator_version;
+        }
+        bool operator!=(const LRTableFileKey &other) const { return !(*this == other); }
+    };
+
+    struct StoredLRTable
+    {
+        LRTableFileKey key;
+        CompiledLRTable compiled_table;
+        std::shared_ptr<const ProductionTable> production_table; // ids are the ones of the compiled table
+    };
+
+    // layout, integers in host byte order, every section starts 8-byte aligned:
+    //   LRTableFileHeader
+    //   LRTableFileSection[section_count], indexed by LRTableFileSectionId
+    //   the sections
+    // strings are (offset, length) pairs into the STRING_DATA section
+    struct LRTableFileHeader
+    {
+        char magic[8];            // lr_table_file_helper::file_magic
+        uint32_t format_version;  // lr_table_file_helper::format_version
+        uint32_t generator;       // TableGeneratorKind
+        uint64_t grammar_hash;
+        uint64_t file_size;
+        uint32_t section_count;
+        uint32_t generator_version; // table_generator_version
+    };
+
+    struct LRTableFileSection
+    {
+        uint64_t offset; // from the start of the file
+        uint64_t count;  // elements of the section's record type
+    };
+
+    enum LRTableFileSectionId : uint32_t
+    {
+        TABLE_SCALARS = 0,     // uint32: state_count, start_state, end_terminal
+        STATE_NAMES,           // uint32 string pairs, one per state
+        TERMINALS,             // uint32 x4 per terminal: name, special property
+        NON_TERMINALS,         // uint32 x4 per non-terminal: name, special property
+        PRODUCTIONS,           // uint32 x3 per production: compiled lhs, rhs length, index of its lhs in PRODUCTION_SYMBOLS
+        PRODUCTION_SYMBOLS,    // uint32 x5 per symbol: name, special property, is_terminal; a production's lhs then its rhs
+        DEFAULT_ACTIONS,       // int32 per state
+        ACTION_BASE,           // uint32 per state
+        ACTION_VALUES,         // int32 per slot
+        ACTION_CHECK,          // uint32 per slot
+        DEFAULT_GOTOS,         // uint32 per non-terminal
+        GOTO_BASE,             // uint32 per non-terminal
+        GOTO_VALUES,           // int32 per slot
+        GOTO_CHECK,            // uint32 per slot
+        STRING_DATA,           // chars
+        SECTION_COUNT,
+    };
+
+    // a table file mapped read-only into memory, the sections are read in place
+    class MappedLRTableFile
+    {
+    public:
+        // throws if the file cannot be mapped or is not a table file of this format version
+        explicit MappedLRTableFile(const std::string &path);
+        ~MappedLRTableFile();
+        MappedLRTableFile(const MappedLRTableFile &) = delete;
+        MappedLRTableFile &operator=(const MappedLRTableFile &) = delete;
+
+        const LRTableFileHeader &header() const { return *reinterpret_cast<const LRTableFileHeader *>(data); }
+        LRTableFileKey key() const;
+        // the records of a section, bounds were checked when the file was mapped
+        template <typename T>
+        const T *section(LRTableFileSectionId id, size_t &count) const
+        {
+            const LRTableFileSection &entry = sections()[id];
+            count = static_cast<size_t>(entry.count);
+            return reinterpret_cast<const T *>(data + entry.offset);
+        }
+
+        // copy the sections into a table the parser driver can use
+        // throws if any action or goto targets a state or production the file does not have
+        StoredLRTable load() const;
+
+    private:
+        const LRTableFileSection *sections() const { return reinterpret_cast<const LRTableFileSection *>(data + sizeof(LRTableFileHeader)); }
+        void check_layout() const;
+
+        const char *data = nullptr;
+        size_t size = 0;
+    };
+};
+
+namespace lr_table_file_helper
+{
+    constexpr char file_magic[8] = {'L', 'R', 'T', 'A', 'B', 'L', 'E', '\0'};
+    // bump on any change of the layout or of what the sections mean
+    constexpr uint32_t format_version = 2;
+
+    // FNV-1a of the file bytes, throws if the file cannot be read
+    uint64_t hash_grammar_file(const std::string &grammar_path);
+
+    // "simple_lr", "slr1", "lr1", "lr1_pager", "lalr1"
+    std::string generator_name(lr_parsing_model::TableGeneratorKind generator);
+    // throws on an unknown name
+    lr_parsing_model::TableGeneratorKind parse_generator_name(const std::string &name);
+
+    // run the generator a table file is keyed by
+    lr_parsing_model::LRParsingTable generate_parsing_table(const cfg_model::CFG &cfg, lr_parsing_model::TableGeneratorKind generator);
+
+    // compile the table and write it with its production table, the file is replaced atomically
+    // throws if the table has no production table
+    void write_table_file(const std::string &path, const lr_parsing_model::LRTableFileKey &key, const lr_parsing_model::LRParsingTable &parsing_table);
+
+    // map a table file and copy it out
+    lr_parsing_model::StoredLRTable read_table_file(const std::string &path);
+
+    // the table of a grammar file, read from table_path if the file there has the same key,
+    // otherwise generated and written to table_path for the next run
+    lr_parsing_model::StoredLRTable load_or_generate(const std::string &grammar_path, lr_parsing_model::TableGeneratorKind generator, const std::string &table_path);
+
+    // human-readable summary of a stored table, with every production and, if asked, every non-error action cell
+    std::string describe_table(const lr_parsing_model::StoredLRTable &table, bool with_cells = false);
+}
+
+#endif // !LR_TABLE_FILE_H
@@ -0,0 +1,105 @@
+#ifndef STATIC_LR_PARSER_H
+#define STATIC_LR_PARSER_H
+
+#include "compiled_lr_table.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// LR driver specialized over a table compiled into the binary
+// Table is a struct emitted by tablegen (lr_table_codegen_helper::generate_table_header),
+// the lookups are the ones of CompiledLRTable over constexpr arrays, nothing is built at startup
+namespace lr_parsing_model
+{
+    template <typename Table>
+    struct StaticLRParser
+    {
+        static constexpr int32_t action(uint32_t state, uint32_t terminal)
+        {
+            uint32_t slot = Table::action_base[state] + terminal;
+            return Table::action_check[slot] == state ? Table::action_values[slot] : Table::default_actions[state];
+        }
+
+        static constexpr uint32_t goto_state(uint32_t state, uint32_t non_terminal)
+        {
+            uint32_t slot = Table::goto_base[non_terminal] + state;
+            return Table::goto_check[slot] == non_terminal ? static_cast<uint32_t>(Table::goto_values[slot]) : Table::default_gotos[non_terminal];
+        }
+
+        // CompiledLRTable::invalid_id if the table has no such terminal
+        static uint32_t find_terminal(std::string_view name)
+        {
+            uint32_t low = 0, high = Table::terminal_count;
+            while (low < high)
+            {
+                uint32_t middle = low + (high - low) / 2;
+                std::string_view middle_name(Table::terminal_names[middle]);
+                if (middle_name == name)
+                {
+                    return middle;
+                }
+                if (middle_name < name)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            return CompiledLRTable::invalid_id;
+        }
+
+        // parse terminal ids, the end terminal included
+        // the listener gets shift(token index) for every shift and reduce(production id) for every reduce, in parse order
+        // throws on a syntax error or a conflicting cell
+        template <typename Listener>
+        static void parse(const std::vector<uint32_t> &terminals, Listener &listener)
+        {
+            std::vector<uint32_t> state_stack;
+            state_stack.reserve(64);
+            state_stack.push_back(Table::start_state);
+            size_t index = 0;
+            while (index < terminals.size())
+            {
+                int32_t current_action = action(state_stack.back(), terminals[index]);
+                switch (CompiledLRTable::action_kind(current_action))
+                {
+                case CompiledLRTable::SHIFT:
+                    state_stack.push_back(CompiledLRTable::action_value(current_action));
+                    listener.shift(index);
+                    index++;
+                    break;
+                case CompiledLRTable::REDUCE:
+                {
+                    uint32_t production = CompiledLRTable::action_value(current_action);
+                    uint32_t length = Table::production_lengths[production];
+                    if (length >= state_stack.size())
+                    {
+                        throw std::runtime_error("Not enough symbols in the stack to perform reduce action.");
+                    }
+                    state_stack.resize(state_stack.size() - length);
+                    state_stack.push_back(goto_state(state_stack.back(), Table::production_lhs[production]));
+                    listener.reduce(production);
+                    break;
+                }
+                case CompiledLRTable::ACCEPT:
+                    return;
+                default:
+                    if (current_action == CompiledLRTable::conflict_action)
+                    {
+                        throw std::runtime_error("Multiple actions found for state " + std::to_string(state_stack.back()) + " and terminal " +
+                                                 Table::terminal_names[terminals[index]]);
+                    }
+                    throw std::runtime_error("Parsing failed due to empty action for state " + std::to_string(state_stack.back()) + " and terminal " +
+                                             Table::terminal_names[terminals[index]]);
+                }
+            }
+            throw std::runtime_error("Parsing failed. No accept action found.");
+        }
+    };
+};
+
+#endif // !STATIC_LR_PARSER_H
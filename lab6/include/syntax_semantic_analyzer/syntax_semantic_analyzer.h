@@ -4,6 +4,9 @@
 #include "ast_model.h"
 #include "scope_table.h"
 #include "lr_parsing_model.h"
+#include "compiled_lr_table.h"
+#include "static_lr_parser.h"
+#include "ll_parsing_model.h"
 #include "cfg_model.h"
 #include "symbol_table.h"
 #include "syntax_semantic_model.h"
@@ -23,6 +26,13 @@ namespace syntax_semantic_analyzer {
         const std::string& node_type,
         const std::string& node_value = ""
     );
+
+    // one entry of the LL(1) parse stack: a grammar symbol still to be matched, or a marker that builds
+    // the AST node of lhs -> rhs once all symbols of rhs have been matched
+    struct ll1_stack_entry {
+        cfg_model::symbol symbol; // the symbol to match, or the lhs for a marker
+        const std::vector<cfg_model::symbol>* reduce_rhs = nullptr; // set for markers, points into the LL(1) table
+    };
 };
 
 class SyntaxSemanticAnalyzer {
@@ -30,18 +40,49 @@ public:
     SyntaxSemanticAnalyzer(); // Constructor to initialize member variables
 
     
+    // the table is checked and compiled once here, the driver itself only reads the compiled table
     void prepair_new_analysis(
         const lr_parsing_model::LRParsingTable& slr1_parsing_table,
         const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
         const std::vector<Token>& tokens
     );
 
+    // same as above, with a table compiled beforehand, its production ids must be those the production info mapping was loaded with
+    void prepair_new_analysis(
+        const lr_parsing_model::CompiledLRTable& compiled_lr_table,
+        const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+        const std::vector<Token>& tokens
+    );
+
     // Analyze the syntax and semantics of the given AST
     syntax_semantic_analyzer::analysis_result analyze_syntax_semantics(
         const lr_parsing_model::LRParsingTable& slr1_parsing_table,
         const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
         const std::vector<Token>& tokens
     );
+    syntax_semantic_analyzer::analysis_result analyze_syntax_semantics(
+        const lr_parsing_model::CompiledLRTable& compiled_lr_table,
+        const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+        const std::vector<Token>& tokens
+    );
+
+    // same as above, with the LL(1) predictive table
+    void prepair_new_ll1_analysis(
+        const ll_parsing_model::LL1ParsingTable& ll1_parsing_table,
+        const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+        const std::vector<Token>& tokens
+    );
+
+    syntax_semantic_analyzer::analysis_result analyze_syntax_semantics_ll1(
+        const ll_parsing_model::LL1ParsingTable& ll1_parsing_table,
+        const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+        const std::vector<Token>& tokens
+    );
+
+    // same as above, with a table generated into a header by tablegen, node types come from the table itself
+    // Parser drives the parse, the table driver by default or Table::RecursiveAscentParser
+    template <typename Table, typename Parser = lr_parsing_model::StaticLRParser<Table>>
+    syntax_semantic_analyzer::analysis_result analyze_syntax_semantics_static(const std::vector<Token>& tokens);
 
     // get blank AST tree after syntax analysis
     tree<std::shared_ptr<ast_model::ASTNodeContent>> get_blank_ast_tree();
@@ -52,9 +93,28 @@ public:
     // check if the toke stream and info_mapping are valid
     void input_check();
 
+    // LL(1) version of input_check
+    void ll1_input_check();
+
+    // token and production info checks shared by both input checks
+    void check_tokens_and_production_info(const std::unordered_set<cfg_model::symbol>& table_terminals);
+
     // syntax analysis & build empty AST tree
     void syntax_anlaysis();
 
+    // non-recursive predictive syntax analysis, builds the same AST as syntax_anlaysis
+    void ll1_syntax_analysis();
+
+    // syntax analysis of the given tokens over a generated table, builds the same AST as syntax_anlaysis
+    template <typename Table, typename Parser = lr_parsing_model::StaticLRParser<Table>>
+    void static_syntax_analysis(const std::vector<Token>& tokens);
+
+    // push a leaf subtree for a matched token
+    void shift_ast_leaf(const Token& token);
+
+    // pop the subtrees of a production's rhs_size symbols and graft them under a new node of its node type
+    void reduce_ast_subtrees(const std::string& node_type_str, size_t rhs_size);
+
     // semantic analysis
     void semantic_analysis();
 
@@ -65,20 +125,94 @@ public:
 
 public:
     // for debugging purposes, set all member variables as public
-    std::vector<cfg_model::symbol> current_symbol_stack; // 当前符号栈
-    std::vector<std::string> current_state_stack; // 当前状态栈
+    std::vector<uint32_t> current_state_stack; // 当前状态栈, ids of the compiled table, one deeper than the AST subtree stack
     std::vector<tree<std::shared_ptr<ast_model::ASTNodeContent>>> current_ast_subtree_stack; // 当前AST子树栈
+    std::vector<syntax_semantic_analyzer::ll1_stack_entry> current_ll1_stack; // LL(1)预测分析栈
     int current_token_index = 0; // 当前token索引
     tree<std::shared_ptr<ast_model::ASTNodeContent>> current_ast_tree; // 当前AST树
     std::shared_ptr<SymbolTable> symbol_table; // 符号表
     std::shared_ptr<ScopeTable> scope_table; // 作用域表
 
-    // SLR(1) parsing table
-    lr_parsing_model::LRParsingTable slr1_parsing_table_ref; // SLR(1)分析表
+    // compiled LR parsing table
+    lr_parsing_model::CompiledLRTable lr_parsing_table_ref; // LR分析表
+    // LL(1) parsing table
+    ll_parsing_model::LL1ParsingTable ll1_parsing_table_ref; // LL(1)预测分析表
     // production info mapping
     syntax_semantic_model::ProductionInfoMapping production_info_mapping_ref; // 产生式信息映射
     // token stream
     std::vector<Token> tokens_ref; // token流
 };
 
+// StaticLRParser listener building the AST the same way syntax_anlaysis does
+template <typename Table>
+struct StaticASTBuilder {
+    SyntaxSemanticAnalyzer& analyzer;
+    const std::vector<Token>& tokens;
+
+    void shift(size_t index) {
+        analyzer.shift_ast_leaf(tokens[index]);
+    }
+
+    void reduce(uint32_t production_id) {
+        const char* node_type = Table::production_node_type_names[production_id];
+        if (node_type[0] == '\0') {
+            spdlog::error("No node type for production: {}", Table::production_texts[production_id]);
+            throw std::runtime_error("No node type for production.");
+        }
+        analyzer.reduce_ast_subtrees(node_type, Table::production_lengths[production_id]);
+    }
+};
+
+template <typename Table, typename Parser>
+void SyntaxSemanticAnalyzer::static_syntax_analysis(const std::vector<Token>& tokens) {
+    spdlog::info("Starting syntax analysis over the generated table...");
+    reset();
+    tokens_ref = tokens;
+    Token end_token;
+    end_token.type = Table::terminal_names[Table::end_terminal];
+    end_token.value = ""; // End token has no value
+    tokens_ref.push_back(end_token);
+
+    std::vector<uint32_t> token_terminals;
+    token_terminals.reserve(tokens_ref.size());
+    for (const auto& token : tokens_ref) {
+        uint32_t terminal = lr_parsing_model::StaticLRParser<Table>::find_terminal(token.type);
+        if (terminal == lr_parsing_model::CompiledLRTable::invalid_id) {
+            spdlog::error("Current token '{}' is not found in the parsing table symbols.", token.type);
+            throw std::runtime_error("Current token is not found in the parsing table symbols.");
+        }
+        token_terminals.push_back(terminal);
+    }
+
+    StaticASTBuilder<Table> builder{*this, tokens_ref};
+    try {
+        Parser::parse(token_terminals, builder);
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Error in syntax analysis: {}", e.what());
+        throw std::runtime_error(std::string("Error in syntax analysis: ") + e.what());
+    }
+    if (current_ast_subtree_stack.size() != 1) {
+        spdlog::error("Parsing failed. Expected one AST subtree, but found {}.", current_ast_subtree_stack.size());
+        throw std::runtime_error("Parsing failed. Expected one AST subtree.");
+    }
+    current_ast_tree = current_ast_subtree_stack.back();
+    spdlog::info("Syntax analysis completed successfully.");
+}
+
+template <typename Table, typename Parser>
+syntax_semantic_analyzer::analysis_result SyntaxSemanticAnalyzer::analyze_syntax_semantics_static(const std::vector<Token>& tokens) {
+    static_syntax_analysis<Table, Parser>(tokens); // Perform syntax analysis and build the AST tree
+    semantic_analysis(); // Perform semantic analysis on the AST tree
+
+    // Prepare the result
+    syntax_semantic_analyzer::analysis_result result;
+    result.ast_tree = current_ast_tree;
+    result.symbol_table = *symbol_table;
+    result.scope_table = *scope_table;
+
+    spdlog::info("Syntax and semantic analysis completed successfully.");
+    return result;
+}
+
 #endif // !SYNTAX_SEMANTIC_ANALYZER_H
\ No newline at end of file
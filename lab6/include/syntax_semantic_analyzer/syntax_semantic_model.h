@@ -17,6 +17,13 @@ struct ProductionInfoMapping {
 
     // 提供一个包装好的查询方法，能够应对没找到的情况（报错）
     std::string get_node_type(const cfg_model::symbol& lhs, const std::vector<cfg_model::symbol>& rhs) const;
+
+    // 同样的节点类型，按文法的产生式编号(cfg_model::ProductionNumbering)存放，没有语义信息的产生式为空串
+    // LR归约只带产生式编号，查询不需要哈希
+    std::vector<std::string> node_types;
+
+    // 按产生式编号查询，没找到时报错
+    const std::string& get_node_type(cfg_model::production_id production) const;
 };
 
 enum class SymbolType {
@@ -1,19 +1,426 @@
 #include "cfg_analyzer.h"
 #include "cfg_model.h"
 #include "spdlog/spdlog.h"
+#include "log_macros.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
 #include <vector>
 
+std::vector<uint8_t> cfg_analyzer_helper::compute_nullable(const cfg_model::IndexedGrammar &grammar)
+{
+    std::vector<uint8_t> nullable(grammar.interner.size(), 0);
+    // remaining[p] = number of rhs symbols of production p not yet known to be nullable
+    std::vector<uint32_t> remaining(grammar.productions.size());
+    // symbol id -> productions it occurs in (once per occurrence)
+    std::vector<std::vector<uint32_t>> occurrences(grammar.interner.size());
+    std::vector<cfg_model::symbol_id> worklist;
+    for (uint32_t p = 0; p < grammar.productions.size(); ++p)
+    {
+        const auto &production = grammar.productions[p];
+        remaining[p] = static_cast<uint32_t>(production.rhs.size());
+        bool has_terminal = false;
+        for (const auto symbol : production.rhs)
+        {
+            has_terminal = has_terminal || grammar.is_terminal[symbol];
+        }
+        // a production with a terminal can never vanish
+        if (has_terminal)
+        {
+            continue;
+        }
+        for (const auto symbol : production.rhs)
+        {
+            occurrences[symbol].push_back(p);
+        }
+        if (production.rhs.empty() && !nullable[production.lhs])
+        {
+            nullable[production.lhs] = 1;
+            worklist.push_back(production.lhs);
+        }
+    }
+    while (!worklist.empty())
+    {
+        cfg_model::symbol_id symbol = worklist.back();
+        worklist.pop_back();
+        for (const auto p : occurrences[symbol])
+        {
+            cfg_model::symbol_id lhs = grammar.productions[p].lhs;
+            if (--remaining[p] == 0 && !nullable[lhs])
+            {
+                nullable[lhs] = 1;
+                worklist.push_back(lhs);
+            }
+        }
+    }
+    return nullable;
+}
+
+void cfg_analyzer_helper::propagate_over_digraph(const std::vector<std::vector<uint32_t>> &edges, std::vector<cfg_model::TerminalSet> &sets)
+{
+    constexpr uint32_t done = std::numeric_limits<uint32_t>::max();
+    const size_t node_count = edges.size();
+    // depth[x]: 0 = not visited, done = finished, otherwise the position on the node stack (1-based)
+    std::vector<uint32_t> depth(node_count, 0);
+    std::vector<uint32_t> node_stack;
+    // explicit call stack: (node, next edge index)
+    std::vector<std::pair<uint32_t, size_t>> call_stack;
+
+    for (uint32_t root = 0; root < node_count; ++root)
+    {
+        if (depth[root] != 0)
+        {
+            continue;
+        }
+        node_stack.push_back(root);
+        depth[root] = static_cast<uint32_t>(node_stack.size());
+        call_stack.emplace_back(root, 0);
+        while (!call_stack.empty())
+        {
+            uint32_t x = call_stack.back().first;
+            size_t &next_edge = call_stack.back().second;
+            if (next_edge < edges[x].size())
+            {
+                uint32_t y = edges[x][next_edge++];
+                if (depth[y] == 0)
+                {
+                    // descend, the edge is folded in when y returns
+                    node_stack.push_back(y);
+                    depth[y] = static_cast<uint32_t>(node_stack.size());
+                    call_stack.emplace_back(y, 0);
+                    continue;
+                }
+                depth[x] = std::min(depth[x], depth[y]);
+                if (x != y)
+                {
+                    sets[x].union_with(sets[y]);
+                }
+                continue;
+            }
+            // all edges of x are done, close its component if x is the root of one
+            call_stack.pop_back();
+            if (node_stack[depth[x] - 1] == x)
+            {
+                while (true)
+                {
+                    uint32_t top = node_stack.back();
+                    node_stack.pop_back();
+                    depth[top] = done;
+                    if (top == x)
+                    {
+                        break;
+                    }
+                    sets[top] = sets[x];
+                }
+            }
+            // return to the caller
+            if (!call_stack.empty())
+            {
+                uint32_t parent = call_stack.back().first;
+                depth[parent] = std::min(depth[parent], depth[x]);
+                sets[parent].union_with(sets[x]);
+            }
+        }
+    }
+}
+
+namespace
+{
+    // levels with fewer components than this are not worth waking the workers for
+    constexpr size_t parallel_level_threshold = 32;
+
+    // fixed set of worker threads running index-parallel loops, the calling thread takes part as well
+    class ParallelForPool
+    {
+    public:
+        explicit ParallelForPool(unsigned extra_workers)
+        {
+            workers.reserve(extra_workers);
+            for (unsigned i = 0; i < extra_workers; ++i)
+            {
+                workers.emplace_back([this]() { work_loop(); });
+            }
+        }
+        ~ParallelForPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            start_cv.notify_all();
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        // run task(i) for every i in [0, count), returns once all of them are done
+        void run(size_t count, const std::function<void(size_t)> &task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                current_task = &task;
+                task_count = count;
+                next_task.store(0);
+                busy_workers = workers.size();
+                ++generation;
+            }
+            start_cv.notify_all();
+            drain();
+            std::unique_lock<std::mutex> lock(mutex);
+            done_cv.wait(lock, [this]() { return busy_workers == 0; });
+            current_task = nullptr;
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable start_cv;
+        std::condition_variable done_cv;
+        const std::function<void(size_t)> *current_task = nullptr;
+        size_t task_count = 0;
+        std::atomic<size_t> next_task{0};
+        size_t busy_workers = 0;
+        size_t generation = 0;
+        bool stopping = false;
+
+        void drain()
+        {
+            for (size_t i = next_task.fetch_add(1); i < task_count; i = next_task.fetch_add(1))
+            {
+                (*current_task)(i);
+            }
+        }
+
+        void work_loop()
+        {
+            size_t seen_generation = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    start_cv.wait(lock, [&]() { return stopping || generation != seen_generation; });
+                    if (stopping)
+                    {
+                        return;
+                    }
+                    seen_generation = generation;
+                }
+                drain();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--busy_workers == 0)
+                    {
+                        done_cv.notify_one();
+                    }
+                }
+            }
+        }
+    };
+}
+
+cfg_analyzer_helper::Condensation cfg_analyzer_helper::condense_digraph(const std::vector<std::vector<uint32_t>> &edges)
+{
+    constexpr uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+    const size_t node_count = edges.size();
+    Condensation condensation;
+    condensation.component_of.assign(node_count, unvisited);
+
+    // iterative Tarjan, components are emitted after everything they reach
+    std::vector<uint32_t> index(node_count, unvisited);
+    std::vector<uint32_t> lowlink(node_count, 0);
+    std::vector<uint8_t> on_stack(node_count, 0);
+    std::vector<uint32_t> node_stack;
+    std::vector<std::pair<uint32_t, size_t>> call_stack;
+    uint32_t next_index = 0;
+    for (uint32_t root = 0; root < node_count; ++root)
+    {
+        if (index[root] != unvisited)
+        {
+            continue;
+        }
+        call_stack.emplace_back(root, 0);
+        index[root] = lowlink[root] = next_index++;
+        node_stack.push_back(root);
+        on_stack[root] = 1;
+        while (!call_stack.empty())
+        {
+            uint32_t x = call_stack.back().first;
+            size_t &next_edge = call_stack.back().second;
+            if (next_edge < edges[x].size())
+            {
+                uint32_t y = edges[x][next_edge++];
+                if (index[y] == unvisited)
+                {
+                    index[y] = lowlink[y] = next_index++;
+                    node_stack.push_back(y);
+                    on_stack[y] = 1;
+                    call_stack.emplace_back(y, 0);
+                }
+                else if (on_stack[y])
+                {
+                    lowlink[x] = std::min(lowlink[x], index[y]);
+                }
+                continue;
+            }
+            call_stack.pop_back();
+            if (lowlink[x] == index[x])
+            {
+                uint32_t component = static_cast<uint32_t>(condensation.components.size());
+                condensation.components.emplace_back();
+                while (true)
+                {
+                    uint32_t top = node_stack.back();
+                    node_stack.pop_back();
+                    on_stack[top] = 0;
+                    condensation.component_of[top] = component;
+                    condensation.components.back().push_back(top);
+                    if (top == x)
+                    {
+                        break;
+                    }
+                }
+            }
+            if (!call_stack.empty())
+            {
+                uint32_t parent = call_stack.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[x]);
+            }
+        }
+    }
+
+    // component edges and levels, successors always have smaller component ids
+    const size_t component_count = condensation.components.size();
+    condensation.successors.assign(component_count, {});
+    std::vector<uint32_t> level(component_count, 0);
+    for (uint32_t component = 0; component < component_count; ++component)
+    {
+        auto &successors = condensation.successors[component];
+        for (const auto x : condensation.components[component])
+        {
+            for (const auto y : edges[x])
+            {
+                if (condensation.component_of[y] != component)
+                {
+                    successors.push_back(condensation.component_of[y]);
+                }
+            }
+        }
+        std::sort(successors.begin(), successors.end());
+        successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+        for (const auto successor : successors)
+        {
+            level[component] = std::max(level[component], level[successor] + 1);
+        }
+        if (level[component] >= condensation.levels.size())
+        {
+            condensation.levels.resize(level[component] + 1);
+        }
+        condensation.levels[level[component]].push_back(component);
+    }
+    return condensation;
+}
+
+void cfg_analyzer_helper::propagate_over_condensation(const std::vector<std::vector<uint32_t>> &edges, std::vector<cfg_model::TerminalSet> &sets, unsigned thread_count)
+{
+    Condensation condensation = condense_digraph(edges);
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // a component gets the union of its own sets and the final sets of its successors,
+    // the successors are all on lower levels, so the components of one level never touch each other
+    auto solve_component = [&](uint32_t component)
+    {
+        const auto &nodes = condensation.components[component];
+        cfg_model::TerminalSet result = sets[nodes[0]];
+        for (size_t i = 1; i < nodes.size(); ++i)
+        {
+            result.union_with(sets[nodes[i]]);
+        }
+        for (const auto successor : condensation.successors[component])
+        {
+            result.union_with(sets[condensation.components[successor][0]]);
+        }
+        for (const auto node : nodes)
+        {
+            sets[node] = result;
+        }
+    };
+
+    size_t widest_level = 0;
+    for (const auto &level : condensation.levels)
+    {
+        widest_level = std::max(widest_level, level.size());
+    }
+    if (thread_count == 1 || widest_level < parallel_level_threshold)
+    {
+        for (const auto &level : condensation.levels)
+        {
+            for (const auto component : level)
+            {
+                solve_component(component);
+            }
+        }
+        return;
+    }
+
+    ParallelForPool pool(thread_count - 1);
+    for (const auto &level : condensation.levels)
+    {
+        if (level.size() < parallel_level_threshold)
+        {
+            for (const auto component : level)
+            {
+                solve_component(component);
+            }
+            continue;
+        }
+        pool.run(level.size(), [&](size_t i) { solve_component(level[i]); });
+    }
+}
+
 CFGAnalyzer::CFGAnalyzer(const cfg_model::CFG &cfg) : cfg(cfg)
 {
     // Initialize the first and follow sets
     first_set = cfg_model::FirstSet();
     follow_set = cfg_model::FollowSet();
+    // translate the grammar to ids once, terminal bits follow the ascending terminal ids
+    grammar = cfg_model_helper::build_indexed_grammar(cfg);
+    terminal_bits.assign(grammar.interner.size(), cfg_model::invalid_symbol_id);
+    for (uint32_t bit = 0; bit < grammar.terminals.size(); ++bit)
+    {
+        terminal_bits[grammar.terminals[bit]] = bit;
+    }
+    for (uint32_t p = 0; p < grammar.productions.size(); ++p)
+    {
+        const auto &production = grammar.productions[p];
+        std::vector<cfg_model::symbol> rhs;
+        rhs.reserve(production.rhs.size());
+        for (const auto symbol : production.rhs)
+        {
+            rhs.push_back(grammar.interner.symbol_of(symbol));
+        }
+        production_indices[grammar.interner.symbol_of(production.lhs)].emplace(std::move(rhs), p);
+    }
 }
 CFGAnalyzer::~CFGAnalyzer() = default;
 
+// Select sequential or parallel propagation
+void CFGAnalyzer::setAnalysisMode(AnalysisMode mode, unsigned thread_count)
+{
+    analysis_mode = mode;
+    analysis_thread_count = thread_count;
+}
+
 // Get the first set
 const cfg_model::FirstSet &CFGAnalyzer::getFirstSet() const
 {
@@ -24,99 +431,123 @@ const cfg_model::FollowSet &CFGAnalyzer::getFollowSet() const
 {
     return follow_set;
 }
+// Get the id-level grammar
+const cfg_model::IndexedGrammar &CFGAnalyzer::getIndexedGrammar() const
+{
+    return grammar;
+}
+
+// Get the index of a production
+uint32_t CFGAnalyzer::getProductionIndex(const cfg_model::symbol &lhs, const std::vector<cfg_model::symbol> &rhs) const
+{
+    auto lhs_it = production_indices.find(lhs);
+    if (lhs_it == production_indices.end())
+    {
+        return cfg_model::invalid_symbol_id;
+    }
+    auto rhs_it = lhs_it->second.find(rhs);
+    return rhs_it == lhs_it->second.end() ? cfg_model::invalid_symbol_id : rhs_it->second;
+}
+// Get FIRST of a production suffix
+const cfg_model::TerminalSet &CFGAnalyzer::getSuffixFirst(uint32_t production_index, size_t dot) const
+{
+    return suffix_first[suffix_offsets[production_index] + dot];
+}
+// Check whether a production suffix is nullable
+bool CFGAnalyzer::isSuffixNullable(uint32_t production_index, size_t dot) const
+{
+    return suffix_nullable[suffix_offsets[production_index] + dot] != 0;
+}
+// terminal <-> bit mapping
+size_t CFGAnalyzer::getTerminalCount() const
+{
+    return grammar.terminals.size();
+}
+uint32_t CFGAnalyzer::getTerminalBit(const cfg_model::symbol &terminal) const
+{
+    cfg_model::symbol_id id = grammar.interner.id_of(terminal);
+    return id == cfg_model::invalid_symbol_id ? cfg_model::invalid_symbol_id : terminal_bits[id];
+}
+const cfg_model::symbol &CFGAnalyzer::getTerminalOfBit(size_t bit) const
+{
+    return grammar.interner.symbol_of(grammar.terminals.at(bit));
+}
 
 // Compute the first set for the CFG
 void CFGAnalyzer::computeFirstSet()
 {
     try{
-        spdlog::debug("Computing first set...");
-        // clear the first set
-        first_set.first_set.clear();
-        first_set.symbols_with_epsilon.clear();
-        // Initialize the first set: for each non-terminal, the first set is empty, for each terminal, the first set is the terminal itself
-        for (const auto &non_terminal : cfg.non_terminals)
+        LAB_LOG_DEBUG("Computing first set...");
+        const size_t symbol_count = grammar.interner.size();
+        const size_t terminal_count = grammar.terminals.size();
+        nullable = cfg_analyzer_helper::compute_nullable(grammar);
+
+        // FIRST(t) = {t} for terminals, the non-terminals start empty
+        first_bits.assign(symbol_count, cfg_model::TerminalSet(terminal_count));
+        for (const auto terminal : grammar.terminals)
+        {
+            first_bits[terminal].set(terminal_bits[terminal]);
+        }
+        // A -> X1 X2 ... Xn: FIRST(A) includes FIRST(Xi) for every Xi up to & including the first non-nullable one
+        std::vector<std::vector<uint32_t>> edges(symbol_count);
+        for (const auto &production : grammar.productions)
         {
-            first_set.first_set[non_terminal] = std::unordered_set<cfg_model::symbol>();
-            // if the non-terminal has epsilon production, add it to the epsilon set
-            if (cfg.epsilon_production_symbols.find(non_terminal) != cfg.epsilon_production_symbols.end())
+            for (const auto symbol : production.rhs)
             {
-                first_set.symbols_with_epsilon.insert(non_terminal);
+                edges[production.lhs].push_back(symbol);
+                if (!nullable[symbol])
+                {
+                    break;
+                }
             }
         }
-        for (const auto &terminal : cfg.terminals)
+        for (auto &symbol_edges : edges)
+        {
+            std::sort(symbol_edges.begin(), symbol_edges.end());
+            symbol_edges.erase(std::unique(symbol_edges.begin(), symbol_edges.end()), symbol_edges.end());
+        }
+        if (analysis_mode == AnalysisMode::PARALLEL)
         {
-            first_set.first_set[terminal] = std::unordered_set<cfg_model::symbol>({terminal});
+            cfg_analyzer_helper::propagate_over_condensation(edges, first_bits, analysis_thread_count);
+        }
+        else
+        {
+            cfg_analyzer_helper::propagate_over_digraph(edges, first_bits);
         }
 
-        // start iterating over the production rules until no changes are made
-        bool changed = true;
-        while(changed)
+        // translate back to symbols
+        first_set.first_set.clear();
+        first_set.symbols_with_epsilon.clear();
+        for (const auto symbol : grammar.terminals)
         {
-            changed = false;
-            // iterate over the non-espilon production rules
-            for (const auto &rule : cfg.production_rules)
+            first_set.first_set[grammar.interner.symbol_of(symbol)] = {grammar.interner.symbol_of(symbol)};
+        }
+        for (const auto symbol : grammar.non_terminals)
+        {
+            auto &symbol_first_set = first_set.first_set[grammar.interner.symbol_of(symbol)];
+            first_bits[symbol].for_each([&](size_t bit)
+                                        { symbol_first_set.insert(grammar.interner.symbol_of(grammar.terminals[bit])); });
+            if (nullable[symbol])
             {
-                const cfg_model::symbol &lhs = rule.first;
-                // iterate over all the candidate productions
-                for (const auto &rhs : rule.second)
-                {
-                    const cfg_model::symbol &first_symbol = rhs[0];
-                    // add every symbol in the first set of the first symbol to the first set of the lhs
-                    if (first_set.first_set.at(first_symbol).size() == 0)
-                    {
-                        // the first set is still empty
-                        continue;
-                    }
-                    int current_lhs_first_set_size = first_set.first_set[lhs].size();
-                    int current_epsilon_set_size = first_set.symbols_with_epsilon.size();
-                    // add the first set of the first symbol to the first set of the lhs
-                    first_set.first_set[lhs].insert(first_set.first_set[first_symbol].begin(), first_set.first_set[first_symbol].end());
-
-                    // also, check if the first symbol set has epsilon
-                    if (first_set.symbols_with_epsilon.find(first_symbol) != first_set.symbols_with_epsilon.end())
-                    {
-                        // 1. now an epsilon symbol must in the first set of the first symbol, so add it to the first set of the lhs
-                        first_set.symbols_with_epsilon.insert(lhs);
-                        // 2. check if there is a second symbol in the rhs
-                        if (rhs.size() > 1)
-                        {
-                            // 3. if there is a second symbol, add the first set of the second symbol to the first set of the lhs
-                            const cfg_model::symbol &second_symbol = rhs[1];
-                            // add the first set of the second symbol to the first set of the lhs
-                            first_set.first_set[lhs].insert(first_set.first_set[second_symbol].begin(), first_set.first_set[second_symbol].end());
-
-                            // 4. !!! important: check if the second symbol has epsilon
-                            if (first_set.symbols_with_epsilon.find(second_symbol) != first_set.symbols_with_epsilon.end())
-                            {
-                                // 5. if the second symbol has epsilon, add it to the first set of the lhs
-                                first_set.symbols_with_epsilon.insert(lhs);
-                            }
-                        }
-                    }
-
-                    // check if the first set of the lhs has changed
-                    if (first_set.first_set[lhs].size() != current_lhs_first_set_size || first_set.symbols_with_epsilon.size() != current_epsilon_set_size)
-                    {
-                        changed = true;
-                    }
-
-                }
-                
+                first_set.symbols_with_epsilon.insert(grammar.interner.symbol_of(symbol));
             }
         }
 
-        spdlog::debug("First set computed successfully.");
+        LAB_LOG_DEBUG("First set computed successfully.");
         // log the first set
-        for (const auto &entry : first_set.first_set)
+        if (LAB_LOG_DEBUG_ENABLED())
         {
-            spdlog::debug("First set of {}: ", std::string(entry.first));
-            for (const auto &symbol : entry.second)
-            {
-                spdlog::debug("{}", std::string(symbol));
-            }
-            if (first_set.symbols_with_epsilon.find(entry.first) != first_set.symbols_with_epsilon.end())
+            for (const auto &entry : first_set.first_set)
             {
-                spdlog::debug("Epsilon production found for {}", std::string(entry.first));
+                LAB_LOG_DEBUG("First set of {}: ", std::string(entry.first));
+                for (const auto &symbol : entry.second)
+                {
+                    LAB_LOG_DEBUG("{}", std::string(symbol));
+                }
+                if (first_set.symbols_with_epsilon.find(entry.first) != first_set.symbols_with_epsilon.end())
+                {
+                    LAB_LOG_DEBUG("Epsilon production found for {}", std::string(entry.first));
+                }
             }
         }
 
@@ -135,132 +566,85 @@ void CFGAnalyzer::computeFirstSet()
 void CFGAnalyzer::computeFollowSet()
 {
     try{
-        spdlog::debug("Computing follow set...");
+        LAB_LOG_DEBUG("Computing follow set...");
         // check if the first set is computed
-        if (first_set.first_set.size() == 0)
+        if (first_bits.empty())
         {
             throw std::runtime_error("First set is not computed. Please compute the first set before computing the follow set.");
         }
-        // clear the follow set
-        follow_set.follow_set.clear();
         // find the end symbol
-        cfg_model::symbol end_symbol;
-        bool end_symbol_found = false;
-        for (const auto &terminal : cfg.terminals)
-        {
-            if (terminal.special_property == "END")
-            {
-                end_symbol = terminal;
-                end_symbol_found = true;
-                break;
-            }
-        }
-        if (!end_symbol_found)
+        if (grammar.end_symbol == cfg_model::invalid_symbol_id)
         {
             throw std::runtime_error("End symbol not found in the CFG. Please add an end symbol to the CFG.");
         }
-        // initialize the follow set for each non-terminal
-        for (const auto &non_terminal : cfg.non_terminals)
-        {
-            follow_set.follow_set[non_terminal] = std::unordered_set<cfg_model::symbol>();
-        }
-        // add the end symbol to the follow set of the start symbol
-        follow_set.follow_set[cfg.start_symbol].insert(end_symbol);
-        follow_set.end_symbol = end_symbol;
-        // start iterating over the production rules until no changes are made
-        bool changed = true;
-        while (changed)
+        const size_t symbol_count = grammar.interner.size();
+        const size_t terminal_count = grammar.terminals.size();
+        // the end symbol follows the start symbol
+        follow_bits.assign(symbol_count, cfg_model::TerminalSet(terminal_count));
+        follow_bits[grammar.start_symbol].set(terminal_bits[grammar.end_symbol]);
+
+        // A -> α B β: FOLLOW(B) includes FIRST(β), and FOLLOW(A) if β is nullable
+        // β is walked right to left so every suffix is built once
+        std::vector<std::vector<uint32_t>> edges(symbol_count);
+        cfg_model::TerminalSet suffix_first(terminal_count);
+        for (const auto &production : grammar.productions)
         {
-            changed = false;
-            // iterate over the production rules
-            for (const auto &rule : cfg.production_rules)
+            suffix_first.clear();
+            bool suffix_nullable = true;
+            for (size_t i = production.rhs.size(); i-- > 0;)
             {
-                const cfg_model::symbol &lhs = rule.first;
-                // iterate over all the candidate productions
-                for (const auto &rhs : rule.second)
+                const cfg_model::symbol_id current_symbol = production.rhs[i];
+                if (!grammar.is_terminal[current_symbol])
                 {
-                    std::string rhs_str = "";
-                    for (const auto &symbol : rhs)
+                    follow_bits[current_symbol].union_with(suffix_first);
+                    if (suffix_nullable)
                     {
-                        rhs_str += std::string(symbol) + " ";
-                    }
-                    spdlog::debug("Processing production rule: {} -> {}", std::string(lhs), rhs_str);
-                    // iterate over the symbols in the rhs
-                    for (size_t i = 0; i < rhs.size(); i++)
-                    {
-                        const cfg_model::symbol &current_symbol = rhs[i];
-                        // if is terminal, continue
-                        if (current_symbol.is_terminal)
-                        {
-                            continue;
-                        }
-                        bool epsilon_suffix = false;
-                        bool is_last_symbol = false;
-                        // if the current symbol is the last symbol, then it has epsilon suffix
-                        if (i == rhs.size() - 1)
-                        {
-                            is_last_symbol = true;
-                            epsilon_suffix = true;
-                        }
-                        // else if the next symbol is in the symbol with epsilon set, then it has epsilon suffix
-                        else if (first_set.symbols_with_epsilon.find(rhs[i + 1]) != first_set.symbols_with_epsilon.end())
-                        {
-                            spdlog::debug("Symbol {} has epsilon suffix", std::string(current_symbol));
-                            epsilon_suffix = true;
-                        }
-                        // else it does not have epsilon suffix
-                        else
-                        {
-                            epsilon_suffix = false;
-                        }
-
-                        // if the current symbol has an epsilon suffix, then add the follow set of the lhs to the follow set of the current symbol
-                        if (epsilon_suffix)
-                        {
-                            int current_follow_set_size = follow_set.follow_set[current_symbol].size();
-                            // add the follow set of the lhs to the follow set of the current symbol
-                            follow_set.follow_set[current_symbol].insert(follow_set.follow_set[lhs].begin(), follow_set.follow_set[lhs].end());
-                            // if not the last symbol, add the first set of the next symbol to the follow set of the current symbol
-                            if (!is_last_symbol)
-                            {
-                                const cfg_model::symbol &next_symbol = rhs[i + 1];
-                                // add the first set of the next symbol to the follow set of the current symbol
-                                follow_set.follow_set[current_symbol].insert(first_set.first_set[next_symbol].begin(), first_set.first_set[next_symbol].end());
-                            }
-                            // check if the follow set of the current symbol has changed
-                            if (follow_set.follow_set[current_symbol].size() != current_follow_set_size)
-                            {
-                                changed = true;
-                            }
-                        }
-                        // if the current symbol does not have an epsilon suffix, then add the first set of the next symbol to the follow set of the current symbol
-                        else
-                        {
-                            // the symbol must not be the last symbol
-                            const cfg_model::symbol &next_symbol = rhs[i + 1];
-                            // add the first set of the next symbol to the follow set of the current symbol
-                            int current_follow_set_size = follow_set.follow_set[current_symbol].size();
-                            // here our first set does not contain epsilon, so we can add it directly
-                            spdlog::debug("Adding first set of {} to follow set of {}", std::string(next_symbol), std::string(current_symbol));
-                            follow_set.follow_set[current_symbol].insert(first_set.first_set[next_symbol].begin(), first_set.first_set[next_symbol].end());
-                            // check if the follow set of the current symbol has changed
-                            if (follow_set.follow_set[current_symbol].size() != current_follow_set_size)
-                            {
-                                changed = true;
-                            }
-                        }
+                        edges[current_symbol].push_back(production.lhs);
                     }
                 }
+                if (!nullable[current_symbol])
+                {
+                    suffix_first.clear();
+                    suffix_nullable = false;
+                }
+                suffix_first.union_with(first_bits[current_symbol]);
             }
         }
-        spdlog::debug("Follow set computed successfully.");
+        for (auto &symbol_edges : edges)
+        {
+            std::sort(symbol_edges.begin(), symbol_edges.end());
+            symbol_edges.erase(std::unique(symbol_edges.begin(), symbol_edges.end()), symbol_edges.end());
+        }
+        if (analysis_mode == AnalysisMode::PARALLEL)
+        {
+            cfg_analyzer_helper::propagate_over_condensation(edges, follow_bits, analysis_thread_count);
+        }
+        else
+        {
+            cfg_analyzer_helper::propagate_over_digraph(edges, follow_bits);
+        }
+
+        // translate back to symbols
+        follow_set.follow_set.clear();
+        follow_set.end_symbol = grammar.interner.symbol_of(grammar.end_symbol);
+        for (const auto symbol : grammar.non_terminals)
+        {
+            auto &symbol_follow_set = follow_set.follow_set[grammar.interner.symbol_of(symbol)];
+            follow_bits[symbol].for_each([&](size_t bit)
+                                         { symbol_follow_set.insert(grammar.interner.symbol_of(grammar.terminals[bit])); });
+        }
+
+        LAB_LOG_DEBUG("Follow set computed successfully.");
         // log the follow set
-        for (const auto &entry : follow_set.follow_set)
+        if (LAB_LOG_DEBUG_ENABLED())
         {
-            spdlog::debug("Follow set of {}: ", std::string(entry.first));
-            for (const auto &symbol : entry.second)
+            for (const auto &entry : follow_set.follow_set)
             {
-                spdlog::debug("{}", std::string(symbol));
+                LAB_LOG_DEBUG("Follow set of {}: ", std::string(entry.first));
+                for (const auto &symbol : entry.second)
+                {
+                    LAB_LOG_DEBUG("{}", std::string(symbol));
+                }
             }
         }
         return;
@@ -271,4 +655,50 @@ void CFGAnalyzer::computeFollowSet()
         spdlog::error(error_msg);
         throw std::runtime_error(error_msg);
     }
-}
\ No newline at end of file
+}
+
+// Compute FIRST of every production suffix
+void CFGAnalyzer::computeSuffixFirstSets()
+{
+    try{
+        LAB_LOG_DEBUG("Computing suffix first sets...");
+        if (first_bits.empty())
+        {
+            throw std::runtime_error("First set is not computed. Please compute the first set before computing the suffix first sets.");
+        }
+        const size_t terminal_count = grammar.terminals.size();
+        suffix_offsets.assign(grammar.productions.size(), 0);
+        uint32_t slot_count = 0;
+        for (uint32_t p = 0; p < grammar.productions.size(); ++p)
+        {
+            suffix_offsets[p] = slot_count;
+            slot_count += static_cast<uint32_t>(grammar.productions[p].rhs.size()) + 1;
+        }
+        suffix_first.assign(slot_count, cfg_model::TerminalSet(terminal_count));
+        suffix_nullable.assign(slot_count, 0);
+        // right to left, each suffix extends the one after it
+        for (uint32_t p = 0; p < grammar.productions.size(); ++p)
+        {
+            const auto &rhs = grammar.productions[p].rhs;
+            const uint32_t offset = suffix_offsets[p];
+            suffix_nullable[offset + rhs.size()] = 1;
+            for (size_t dot = rhs.size(); dot-- > 0;)
+            {
+                const cfg_model::symbol_id symbol = rhs[dot];
+                suffix_first[offset + dot] = first_bits[symbol];
+                if (nullable[symbol])
+                {
+                    suffix_first[offset + dot].union_with(suffix_first[offset + dot + 1]);
+                    suffix_nullable[offset + dot] = suffix_nullable[offset + dot + 1];
+                }
+            }
+        }
+        LAB_LOG_DEBUG("Suffix first sets computed for {} productions, {} suffixes", grammar.productions.size(), slot_count);
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error computing suffix first sets: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
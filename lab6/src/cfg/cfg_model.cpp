@@ -0,0 +1,221 @@
+#include "cfg_model.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <stdexcept>
+
+cfg_model::symbol_id cfg_model::SymbolInterner::intern(const symbol &s)
+{
+    auto it = symbol_to_id.find(s);
+    if (it != symbol_to_id.end())
+    {
+        return it->second;
+    }
+    symbol_id id = static_cast<symbol_id>(id_to_symbol.size());
+    symbol_to_id.emplace(s, id);
+    id_to_symbol.push_back(s);
+    return id;
+}
+
+cfg_model::symbol_id cfg_model::SymbolInterner::id_of(const symbol &s) const
+{
+    auto it = symbol_to_id.find(s);
+    return it == symbol_to_id.end() ? invalid_symbol_id : it->second;
+}
+
+cfg_model::production_id cfg_model::ProductionNumbering::number(const symbol &lhs, const std::vector<symbol> &rhs)
+{
+    auto &ids_by_rhs = production_to_id[lhs];
+    auto it = ids_by_rhs.find(rhs);
+    if (it != ids_by_rhs.end())
+    {
+        return it->second;
+    }
+    production_id id = static_cast<production_id>(id_to_lhs.size());
+    ids_by_rhs.emplace(rhs, id);
+    id_to_lhs.push_back(lhs);
+    id_to_rhs.push_back(rhs);
+    return id;
+}
+
+cfg_model::production_id cfg_model::ProductionNumbering::id_of(const symbol &lhs, const std::vector<symbol> &rhs) const
+{
+    auto lhs_it = production_to_id.find(lhs);
+    if (lhs_it == production_to_id.end())
+    {
+        return invalid_production_id;
+    }
+    auto it = lhs_it->second.find(rhs);
+    return it == lhs_it->second.end() ? invalid_production_id : it->second;
+}
+
+namespace
+{
+    // intern the symbols of a set in name order, so that ids do not depend on hash iteration order
+    void intern_sorted(cfg_model::SymbolInterner &interner, const std::unordered_set<cfg_model::symbol> &symbols)
+    {
+        std::vector<cfg_model::symbol> missing;
+        for (const auto &s : symbols)
+        {
+            if (!interner.contains(s))
+            {
+                missing.push_back(s);
+            }
+        }
+        std::sort(missing.begin(), missing.end(), [](const cfg_model::symbol &a, const cfg_model::symbol &b)
+                  { return std::string(a) < std::string(b); });
+        for (const auto &s : missing)
+        {
+            interner.intern(s);
+        }
+    }
+}
+
+void cfg_model_helper::intern_cfg_symbols(cfg_model::CFG &cfg)
+{
+    try
+    {
+        if (!cfg.start_symbol.name.empty())
+        {
+            cfg.symbol_interner.intern(cfg.start_symbol);
+        }
+        intern_sorted(cfg.symbol_interner, cfg.terminals);
+        intern_sorted(cfg.symbol_interner, cfg.non_terminals);
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error interning CFG symbols: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+void cfg_model_helper::number_cfg_productions(cfg_model::CFG &cfg)
+{
+    try
+    {
+        using production = std::pair<cfg_model::symbol, std::vector<cfg_model::symbol>>;
+        std::vector<production> missing;
+        for (const auto &rule : cfg.production_rules)
+        {
+            for (const auto &rhs : rule.second)
+            {
+                if (!cfg.production_numbering.contains(rule.first, rhs))
+                {
+                    missing.emplace_back(rule.first, rhs);
+                }
+            }
+        }
+        for (const auto &lhs : cfg.epsilon_production_symbols)
+        {
+            if (!cfg.production_numbering.contains(lhs, {}))
+            {
+                missing.emplace_back(lhs, std::vector<cfg_model::symbol>{});
+            }
+        }
+        // name order, so that ids do not depend on hash iteration order
+        auto names = [](const production &p)
+        {
+            std::vector<std::string> text{p.first.name};
+            for (const auto &s : p.second)
+            {
+                text.push_back(s.name);
+            }
+            return text;
+        };
+        std::sort(missing.begin(), missing.end(), [&names](const production &a, const production &b)
+                  { return names(a) < names(b); });
+        for (const auto &p : missing)
+        {
+            cfg.production_numbering.number(p.first, p.second);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error numbering CFG productions: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+cfg_model::IndexedGrammar cfg_model_helper::build_indexed_grammar(const cfg_model::CFG &cfg)
+{
+    try
+    {
+        cfg_model::IndexedGrammar grammar;
+        grammar.interner = cfg.symbol_interner;
+        // complete the interner with anything the CFG gained after loading
+        if (!cfg.start_symbol.name.empty())
+        {
+            grammar.interner.intern(cfg.start_symbol);
+        }
+        intern_sorted(grammar.interner, cfg.terminals);
+        intern_sorted(grammar.interner, cfg.non_terminals);
+
+        grammar.start_symbol = grammar.interner.id_of(cfg.start_symbol);
+        grammar.is_terminal.assign(grammar.interner.size(), 0);
+        for (const auto &terminal : cfg.terminals)
+        {
+            cfg_model::symbol_id id = grammar.interner.id_of(terminal);
+            grammar.is_terminal[id] = 1;
+            grammar.terminals.push_back(id);
+            if (terminal.special_property == "END")
+            {
+                grammar.end_symbol = id;
+            }
+        }
+        for (const auto &non_terminal : cfg.non_terminals)
+        {
+            grammar.non_terminals.push_back(grammar.interner.id_of(non_terminal));
+        }
+        std::sort(grammar.terminals.begin(), grammar.terminals.end());
+        std::sort(grammar.non_terminals.begin(), grammar.non_terminals.end());
+
+        // productions, epsilon productions get an empty rhs
+        auto id_of_known = [&grammar](const cfg_model::symbol &s)
+        {
+            cfg_model::symbol_id id = grammar.interner.id_of(s);
+            if (id == cfg_model::invalid_symbol_id)
+            {
+                throw std::runtime_error("Production refers to a symbol outside the CFG: " + std::string(s));
+            }
+            return id;
+        };
+        for (const auto &rule : cfg.production_rules)
+        {
+            cfg_model::symbol_id lhs = id_of_known(rule.first);
+            for (const auto &rhs : rule.second)
+            {
+                cfg_model::IndexedProduction production;
+                production.lhs = lhs;
+                production.rhs.reserve(rhs.size());
+                for (const auto &s : rhs)
+                {
+                    production.rhs.push_back(id_of_known(s));
+                }
+                grammar.productions.push_back(std::move(production));
+            }
+        }
+        for (const auto &epsilon_symbol : cfg.epsilon_production_symbols)
+        {
+            cfg_model::IndexedProduction production;
+            production.lhs = id_of_known(epsilon_symbol);
+            grammar.productions.push_back(std::move(production));
+        }
+        std::sort(grammar.productions.begin(), grammar.productions.end(),
+                  [](const cfg_model::IndexedProduction &a, const cfg_model::IndexedProduction &b)
+                  { return a.lhs != b.lhs ? a.lhs < b.lhs : a.rhs < b.rhs; });
+
+        grammar.productions_by_lhs.assign(grammar.interner.size(), {});
+        for (uint32_t i = 0; i < grammar.productions.size(); ++i)
+        {
+            grammar.productions_by_lhs[grammar.productions[i].lhs].push_back(i);
+        }
+        return grammar;
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error building indexed grammar: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
@@ -0,0 +1,192 @@
+#include "cfg_reducer.h"
+#include "cfg_model.h"
+#include "spdlog/spdlog.h"
+#include "log_macros.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+cfg_model::CFGReductionResult cfg_reducer_helper::reduce_cfg(const cfg_model::CFG &cfg)
+{
+    try
+    {
+        LAB_LOG_DEBUG("Reducing CFG with start symbol {}...", std::string(cfg.start_symbol));
+        cfg_model::IndexedGrammar grammar = cfg_model_helper::build_indexed_grammar(cfg);
+        const size_t symbol_count = grammar.interner.size();
+        if (grammar.start_symbol == cfg_model::invalid_symbol_id)
+        {
+            throw std::runtime_error("Start symbol is not set");
+        }
+
+        // 1. productive symbols: terminals, and lhs of productions whose rhs symbols are all productive
+        std::vector<uint8_t> productive(symbol_count, 0);
+        std::vector<uint32_t> remaining(grammar.productions.size());
+        std::vector<std::vector<uint32_t>> occurrences(symbol_count);
+        std::vector<cfg_model::symbol_id> worklist;
+        auto mark_productive = [&](cfg_model::symbol_id symbol)
+        {
+            if (!productive[symbol])
+            {
+                productive[symbol] = 1;
+                worklist.push_back(symbol);
+            }
+        };
+        for (uint32_t p = 0; p < grammar.productions.size(); ++p)
+        {
+            const auto &production = grammar.productions[p];
+            remaining[p] = 0;
+            for (const auto symbol : production.rhs)
+            {
+                if (!grammar.is_terminal[symbol])
+                {
+                    ++remaining[p];
+                    occurrences[symbol].push_back(p);
+                }
+            }
+            if (remaining[p] == 0)
+            {
+                mark_productive(production.lhs);
+            }
+        }
+        while (!worklist.empty())
+        {
+            cfg_model::symbol_id symbol = worklist.back();
+            worklist.pop_back();
+            for (const auto p : occurrences[symbol])
+            {
+                if (--remaining[p] == 0)
+                {
+                    mark_productive(grammar.productions[p].lhs);
+                }
+            }
+        }
+        if (!productive[grammar.start_symbol])
+        {
+            throw std::runtime_error("Start symbol " + std::string(cfg.start_symbol) + " derives no terminal string");
+        }
+
+        // 2. reachable symbols, only following productions made of productive symbols
+        std::vector<uint8_t> production_kept(grammar.productions.size(), 0);
+        for (uint32_t p = 0; p < grammar.productions.size(); ++p)
+        {
+            production_kept[p] = productive[grammar.productions[p].lhs] && remaining[p] == 0;
+        }
+        std::vector<uint8_t> reachable(symbol_count, 0);
+        reachable[grammar.start_symbol] = 1;
+        worklist.push_back(grammar.start_symbol);
+        while (!worklist.empty())
+        {
+            cfg_model::symbol_id symbol = worklist.back();
+            worklist.pop_back();
+            for (const auto p : grammar.productions_by_lhs[symbol])
+            {
+                if (!production_kept[p])
+                {
+                    continue;
+                }
+                for (const auto rhs_symbol : grammar.productions[p].rhs)
+                {
+                    if (!reachable[rhs_symbol])
+                    {
+                        reachable[rhs_symbol] = 1;
+                        worklist.push_back(rhs_symbol);
+                    }
+                }
+            }
+        }
+
+        // 3. copy what is left, symbol ids keep their relative order
+        cfg_model::CFGReductionResult result;
+        cfg_model::CFG &reduced_cfg = result.reduced_cfg;
+        cfg_model::CFGReductionReport &report = result.report;
+        reduced_cfg.start_symbol = cfg.start_symbol;
+        // production ids are kept whole, removed productions leave holes, so ids still match the semantic info of the original CFG
+        reduced_cfg.production_numbering = cfg.production_numbering;
+        for (cfg_model::symbol_id id = 0; id < symbol_count; ++id)
+        {
+            const cfg_model::symbol &s = grammar.interner.symbol_of(id);
+            if (grammar.is_terminal[id])
+            {
+                if (reachable[id] || !s.special_property.empty())
+                {
+                    reduced_cfg.terminals.insert(s);
+                    reduced_cfg.symbol_interner.intern(s);
+                }
+                else
+                {
+                    report.unreachable_terminals.insert(s);
+                }
+            }
+            else if (!productive[id])
+            {
+                report.unproductive_non_terminals.insert(s);
+            }
+            else if (!reachable[id])
+            {
+                report.unreachable_non_terminals.insert(s);
+            }
+            else
+            {
+                reduced_cfg.non_terminals.insert(s);
+                reduced_cfg.symbol_interner.intern(s);
+            }
+        }
+        for (uint32_t p = 0; p < grammar.productions.size(); ++p)
+        {
+            const auto &production = grammar.productions[p];
+            if (!production_kept[p] || !reachable[production.lhs])
+            {
+                ++report.removed_production_count;
+                continue;
+            }
+            const cfg_model::symbol &lhs = grammar.interner.symbol_of(production.lhs);
+            if (production.rhs.empty())
+            {
+                reduced_cfg.epsilon_production_symbols.insert(lhs);
+                continue;
+            }
+            std::vector<cfg_model::symbol> rhs;
+            rhs.reserve(production.rhs.size());
+            for (const auto symbol : production.rhs)
+            {
+                rhs.push_back(grammar.interner.symbol_of(symbol));
+            }
+            reduced_cfg.production_rules[lhs].insert(std::move(rhs));
+        }
+        cfg_model_helper::number_cfg_productions(reduced_cfg);
+
+        if (!report.empty())
+        {
+            spdlog::info("CFG reduction: {}", describe_reduction(report));
+        }
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error reducing CFG: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+std::string cfg_reducer_helper::describe_reduction(const cfg_model::CFGReductionReport &report)
+{
+    auto join_names = [](const std::unordered_set<cfg_model::symbol> &symbols)
+    {
+        std::vector<std::string> names;
+        for (const auto &s : symbols)
+        {
+            names.push_back(s.name);
+        }
+        std::sort(names.begin(), names.end());
+        std::string joined;
+        for (const auto &name : names)
+        {
+            joined += joined.empty() ? name : ", " + name;
+        }
+        return "[" + joined + "]";
+    };
+    return "removed " + std::to_string(report.removed_production_count) + " production(s), unproductive non-terminals " +
+           join_names(report.unproductive_non_terminals) + ", unreachable non-terminals " + join_names(report.unreachable_non_terminals) +
+           ", unreachable terminals " + join_names(report.unreachable_terminals);
+}
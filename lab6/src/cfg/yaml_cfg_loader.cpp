@@ -94,6 +94,8 @@ cfg_model::CFG YAML_CFG_Loader_Helper::ParseYAMLFile(const std::string &filename
             temp_symbol.name = terminal.as<std::string>();
             temp_symbol.is_terminal = true;
             temp_cfg.terminals.insert(temp_symbol);
+            // ids follow the declaration order: terminals first, then non-terminals
+            temp_cfg.symbol_interner.intern(temp_symbol);
             terminal_names.insert(temp_symbol.name);
         }
         std:: string terminal_names_str;
@@ -109,6 +111,7 @@ cfg_model::CFG YAML_CFG_Loader_Helper::ParseYAMLFile(const std::string &filename
             temp_symbol.name = non_terminal.as<std::string>();
             temp_symbol.is_terminal = false;
             temp_cfg.non_terminals.insert(temp_symbol);
+            temp_cfg.symbol_interner.intern(temp_symbol);
             non_terminal_names.insert(temp_symbol.name);
         }
         std::string non_terminal_names_str;
@@ -171,7 +174,8 @@ cfg_model::CFG YAML_CFG_Loader_Helper::ParseYAMLFile(const std::string &filename
                 }
             }
 
-            // finalize the production rule
+            // finalize the production rule, ids follow the declaration order
+            temp_cfg.production_numbering.number(lhs, rhs_symbols);
             if (is_epsilon_production)
             {
                 temp_cfg.epsilon_production_symbols.insert(lhs);
@@ -191,8 +191,15 @@ void visualization_helper::pretty_print_parsing_table(const lr_parsing_model::LR
     {
         tabulate::Table::Row_t row;
         row.push_back(std::to_string(pair.second));
-        std::string production_rule = pair.first.reduce_rule_lhs.name + " -> ";
-        for (const auto &symbol : pair.first.reduce_rule_rhs)
+        if (!parsing_table.production_table)
+        {
+            std::string error_message = "Error: Parsing table has reduce actions but no production table";
+            spdlog::error(error_message);
+            throw std::runtime_error(error_message);
+        }
+        const lr_parsing_model::Production &production = parsing_table.production_table->production(pair.first.reduce_production);
+        std::string production_rule = production.lhs.name + " -> ";
+        for (const auto &symbol : production.rhs)
         {
             production_rule += symbol.name + " ";
         }
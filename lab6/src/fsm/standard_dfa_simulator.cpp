@@ -1,10 +1,12 @@
 #include "standard_dfa_simulator.h"
 #include "spdlog/spdlog.h"
+#include "log_macros.h"
 #include <iostream>
 
 bool StandardDFASimulator::UpdateDFA(const dfa_model::DFA<char> &dfa) {
     try {
         this->dfa = dfa;
+        compiled_dfa.reset();
         return true;
     } catch (const std::exception &e) {
         std::cerr << "Error updating DFA: " << e.what() << std::endl;
@@ -17,7 +19,6 @@ bool StandardDFASimulator::SimulateString(const std::vector<char>& input) {
         std::cerr << "Error: Input string is empty" << std::endl;
         return false;
     }
-    std::string input_str(input.begin(), input.end());
     // spdlog::debug("Simulating string: {}", input);
     // spdlog::debug("DFA initial state: {}", dfa.initial_state);
     // spdlog::debug("DFA accepting states: {}", fmt::join(dfa.accepting_states, ", "));
@@ -31,38 +32,49 @@ bool StandardDFASimulator::SimulateString(const std::vector<char>& input) {
     } */
 
     std::string current_state = dfa.initial_state;
-    spdlog::debug("Starting simulation with initial state: {}", current_state);
+    LAB_LOG_DEBUG("Starting simulation with initial state: {}", current_state);
 
     // 遍历输入字符串的每个字符
     for (const char &input_char : input) {
         
         // 当前字符
-        spdlog::debug("Current character: '{}'", input_char);
+        LAB_LOG_DEBUG("Current character: '{}'", input_char);
         
         // 检查是否可以转移
         if (!CheckSingleCharInSingleState(current_state, input_char)) {
             // 注意这不是程序错误，只是输入字符串不符合DFA
             // 将情况记录到日志中
-            spdlog::debug("No transition from state {} on input '{}'", current_state, input_char);
+            LAB_LOG_DEBUG("No transition from state {} on input '{}'", current_state, input_char);
             return false;
         }
 
         // 进行单步模拟
         current_state = SingleStepSimulate(current_state, input_char);
-        spdlog::debug("Transitioned to state: {}", current_state);
+        LAB_LOG_DEBUG("Transitioned to state: {}", current_state);
     }
 
     // 检查最终状态是否为接受状态
-    spdlog::debug("Final state after processing input: {}", current_state);
+    LAB_LOG_DEBUG("Final state after processing input: {}", current_state);
     if (IsAcceptState(current_state)) {
-        spdlog::info("Accepted string: {}", input_str);
+        LAB_LOG_INFO("Accepted string: {}", std::string(input.begin(), input.end()));
         return true;
     } else {
-        spdlog::info("Rejected string: {}", input_str);
+        LAB_LOG_INFO("Rejected string: {}", std::string(input.begin(), input.end()));
         return false;
     }
 }
 
+std::vector<bool> StandardDFASimulator::SimulateBatch(const std::vector<std::vector<char>>& inputs, unsigned thread_count) {
+    try {
+        return compiled_dfa_helper::simulate_batch(*GetCompiledDFA(), inputs, thread_count);
+    } catch (const std::exception &e) {
+        std::string error_message = "Error simulating batch: ";
+        error_message += e.what();
+        spdlog::error(error_message);
+        throw std::runtime_error(error_message);
+    }
+}
+
 bool StandardDFASimulator::CheckSingleCharInSingleState(const std::string &state, const char input_char) const {
     // 检查当前状态是否存在
     if (dfa.transitions.find(state) == dfa.transitions.end()) {
@@ -85,34 +97,60 @@ std::string StandardDFASimulator::SingleStepSimulate(const std::string &state, c
     return dfa.transitions.at(state).at(input_char);
 }
 
+std::shared_ptr<const dfa_model::CompiledDFA<char>> StandardDFASimulator::GetCompiledDFA() const {
+    if (!compiled_dfa) {
+        compiled_dfa = std::make_shared<const dfa_model::CompiledDFA<char>>(compiled_dfa_helper::compile_dfa(dfa));
+    }
+    return compiled_dfa;
+}
+
 std::set<std::string> StandardDFASimulator::GenerateAcceptedStrings(int max_length) const {
     std::set<std::string> accepted_strings;
 
-    // 递归生成符合规则的字符串
-    GenerateAcceptedStrings("", dfa.initial_state, max_length, accepted_strings);
+    // 非递归枚举，逐个插入结果集
+    auto enumerator = EnumerateAcceptedStrings(max_length);
+    for (const auto &accepted_string : enumerator) {
+        accepted_strings.emplace(accepted_string.begin(), accepted_string.end());
+    }
     return accepted_strings;
 }
 
-void StandardDFASimulator::GenerateAcceptedStrings(const std::string &current_string, const std::string &current_state, int max_length, std::set<std::string> &accepted_strings) const {
-    // 如果当前字符串长度超过最大长度，返回
-    if (current_string.length() > max_length) {
-        return;
+std::vector<uint64_t> StandardDFASimulator::CountAcceptedStrings(int max_length) const {
+    try {
+        return accepted_string_enumerator_helper::count_accepted_strings(*GetCompiledDFA(), max_length);
+    } catch (const std::exception &e) {
+        std::string error_message = "Error counting accepted strings: ";
+        error_message += e.what();
+        spdlog::error(error_message);
+        throw std::runtime_error(error_message);
     }
+}
 
-    // 如果当前状态是接受状态，添加到结果集中
-    if (IsAcceptState(current_state)) {
-        accepted_strings.insert(current_string);
+dfa_model::AcceptedStringEnumerator<char> StandardDFASimulator::EnumerateAcceptedStrings(int max_length) const {
+    try {
+        return dfa_model::AcceptedStringEnumerator<char>(GetCompiledDFA(), max_length);
+    } catch (const std::exception &e) {
+        std::string error_message = "Error enumerating accepted strings: ";
+        error_message += e.what();
+        spdlog::error(error_message);
+        throw std::runtime_error(error_message);
     }
+}
 
-    // 遍历所有可能的输入字符
-    for (const char &input_char : dfa.character_set) {
-        // 检查是否可以转移
-        if (CheckSingleCharInSingleState(current_state, input_char)) {
-            // 进行单步模拟
-            std::string next_state = SingleStepSimulate(current_state, input_char);
-            GenerateAcceptedStrings(current_string + input_char, next_state, max_length, accepted_strings);
+std::optional<std::string> StandardDFASimulator::SampleAcceptedString(int length, std::mt19937_64 &random_engine) const {
+    try {
+        auto compiled = GetCompiledDFA();
+        // 计数表只需覆盖到目标长度
+        auto suffix_count_table = accepted_string_enumerator_helper::build_suffix_count_table(*compiled, length);
+        auto sampled = accepted_string_enumerator_helper::sample_accepted_string(*compiled, suffix_count_table, length, random_engine);
+        if (!sampled.has_value()) {
+            return std::nullopt;
         }
-        // 否则字符串必然不符合规则
-        // 不用继续递归
+        return std::string(sampled->begin(), sampled->end());
+    } catch (const std::exception &e) {
+        std::string error_message = "Error sampling accepted string: ";
+        error_message += e.what();
+        spdlog::error(error_message);
+        throw std::runtime_error(error_message);
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #include "standard_nfa_dfa_converter.h"
 #include "nfa_model.h"
 #include "dfa_model.h"
+#include "dfa_builder.h"
 #include "spdlog/spdlog.h"
 #include <unordered_set>
 #include <unordered_map>
@@ -32,34 +33,47 @@ NFADFAConvertionResult StandardNFA_DFA_Converter::convert_nfa_to_dfa(const nfa_m
         // step 2: generate the state mapping
         NFADFABidirectionalMapping state_mapping = std_nfa_dfa_converter_helper::generate_state_mapping(closure_set);
 
-        // step 3: build the DFA
+        // step 3: build the DFA states
+        // the states are registered in a bulk builder, the transitions only need the state names
+        dfa_model::DFABuilder<std::string> dfa_builder;
         dfa_model::DFA<std::string> dfa;
         dfa.character_set = nfa.character_set;
+        dfa_builder.reserve(closure_set.size(), closure_set.size() * nfa.character_set.size());
+        for (const auto &symbol : nfa.character_set)
+        {
+            dfa_builder.add_symbol(symbol);
+        }
         // iterate through the closure set and build the DFA states
         for (const auto &closure : closure_set)
         {
-            // add the closure name to the DFA states
+            // add the closure name to the DFA states, accepting if the closure has an accepting state
+            uint32_t state_id = dfa_builder.add_state(closure.closure_name, closure.has_accepting_state);
             dfa.states_set.insert(closure.closure_name);
-            // check if the closure has an accepting state, if so, add it to the DFA accepting states
             if (closure.has_accepting_state)
             {
-                dfa.accepting_states.insert(closure.closure_name);
                 spdlog::debug("DFA accepting state: {}", closure.closure_name);
             }
             // check if the closure has the initial state, if so, set it as the DFA initial state
             if (closure.has_initial_state)
             {
-                dfa.initial_state = closure.closure_name;
+                dfa_builder.set_initial_state(state_id);
                 spdlog::debug("DFA initial state: {}", closure.closure_name);
             }
         }
         // step 4: generate the DFA transitions
         std::unordered_map<std::string, std::unordered_map<std::string, std::string>> dfa_transitions = std_nfa_dfa_converter_helper::generate_dfa_transitions(nfa, state_mapping, dfa);
-        dfa.transitions = dfa_transitions;
+        for (const auto &state_transitions : dfa_transitions)
+        {
+            uint32_t from_state = dfa_builder.find_state(state_transitions.first);
+            for (const auto &symbol_state_pair : state_transitions.second)
+            {
+                dfa_builder.add_transition(from_state, dfa_builder.find_symbol(symbol_state_pair.first), dfa_builder.find_state(symbol_state_pair.second));
+            }
+        }
 
         // step 5: check & finish the DFA
-        // check the DFA configurations
-        dfa_model_helper::check_dfa_configuration(dfa);
+        // the builder validates the whole DFA in one pass
+        dfa = dfa_builder.build();
         // update the result
         result.dfa = dfa;
         result.state_mapping = state_mapping;
@@ -0,0 +1,351 @@
+#include "compiled_lr_table.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+namespace lr_parsing_model
+{
+    uint32_t CompiledLRTable::find_terminal(const std::string &name) const
+    {
+        auto it = terminal_ids_by_name.find(name);
+        return it == terminal_ids_by_name.end() ? invalid_id : it->second;
+    }
+};
+
+namespace compiled_lr_table_helper
+{
+    namespace
+    {
+        // the most frequent value among the cells, ties go to the smallest value, fallback if there are no cells
+        int32_t most_frequent(const std::vector<int32_t> &cells, int32_t fallback)
+        {
+            std::map<int32_t, size_t> counts;
+            for (const auto cell : cells)
+            {
+                counts[cell]++;
+            }
+            int32_t result = fallback;
+            size_t result_count = 0;
+            for (const auto &count : counts)
+            {
+                if (count.second > result_count)
+                {
+                    result = count.first;
+                    result_count = count.second;
+                }
+            }
+            return result;
+        }
+
+        bool symbol_name_less(const cfg_model::symbol &a, const cfg_model::symbol &b)
+        {
+            return a.name < b.name;
+        }
+    }
+
+    lr_parsing_model::CombVector pack_comb_vector(const std::vector<std::vector<std::pair<uint32_t, int32_t>>> &rows, uint32_t column_count)
+    {
+        lr_parsing_model::CombVector comb_vector;
+        comb_vector.base.assign(rows.size(), 0);
+        std::vector<uint32_t> order(rows.size());
+        for (uint32_t row = 0; row < rows.size(); ++row)
+        {
+            order[row] = row;
+        }
+        std::stable_sort(order.begin(), order.end(), [&rows](uint32_t a, uint32_t b) {
+            return rows[a].size() > rows[b].size();
+        });
+
+        size_t first_free = 0; // no empty slot below it
+        uint32_t max_base = 0;
+        for (const auto row : order)
+        {
+            const auto &cells = rows[row];
+            if (cells.empty())
+            {
+                // no slot names the row, every lookup falls back to its default
+                continue;
+            }
+            uint32_t lowest_column = cells.front().first;
+            for (const auto &cell : cells)
+            {
+                lowest_column = std::min(lowest_column, cell.first);
+            }
+            size_t candidate = first_free > lowest_column ? first_free - lowest_column : 0;
+            for (;; ++candidate)
+            {
+                bool fits = std::all_of(cells.begin(), cells.end(), [&](const std::pair<uint32_t, int32_t> &cell) {
+                    size_t slot = candidate + cell.first;
+                    return slot >= comb_vector.check.size() || comb_vector.check[slot] == lr_parsing_model::CombVector::empty_slot;
+                });
+                if (fits)
+                {
+                    break;
+                }
+            }
+            for (const auto &cell : cells)
+            {
+                size_t slot = candidate + cell.first;
+                if (slot >= comb_vector.check.size())
+                {
+                    comb_vector.check.resize(slot + 1, lr_parsing_model::CombVector::empty_slot);
+                    comb_vector.values.resize(slot + 1, 0);
+                }
+                comb_vector.check[slot] = row;
+                comb_vector.values[slot] = cell.second;
+            }
+            comb_vector.base[row] = static_cast<uint32_t>(candidate);
+            max_base = std::max(max_base, static_cast<uint32_t>(candidate));
+            while (first_free < comb_vector.check.size() && comb_vector.check[first_free] != lr_parsing_model::CombVector::empty_slot)
+            {
+                first_free++;
+            }
+        }
+        size_t padded_size = static_cast<size_t>(max_base) + column_count;
+        if (comb_vector.check.size() < padded_size)
+        {
+            comb_vector.check.resize(padded_size, lr_parsing_model::CombVector::empty_slot);
+            comb_vector.values.resize(padded_size, 0);
+        }
+        return comb_vector;
+    }
+
+    lr_parsing_model::CompiledLRTable compile_lr_table(const lr_parsing_model::LRParsingTable &parsing_table, bool default_reductions)
+    {
+        try
+        {
+            using lr_parsing_model::CompiledLRTable;
+            CompiledLRTable compiled_table;
+
+            // 1. states, the start state is 0 and the others follow by name
+            std::unordered_map<std::string, uint32_t> state_ids;
+            if (parsing_table.all_states.find(parsing_table.start_state) == parsing_table.all_states.end())
+            {
+                throw std::runtime_error("Start state " + parsing_table.start_state + " is not a state of the table");
+            }
+            std::vector<std::string> other_states;
+            for (const auto &state : parsing_table.all_states)
+            {
+                if (state != parsing_table.start_state)
+                {
+                    other_states.push_back(state);
+                }
+            }
+            std::sort(other_states.begin(), other_states.end());
+            compiled_table.state_names.push_back(parsing_table.start_state);
+            compiled_table.state_names.insert(compiled_table.state_names.end(), other_states.begin(), other_states.end());
+            for (uint32_t state = 0; state < compiled_table.state_names.size(); ++state)
+            {
+                state_ids.emplace(compiled_table.state_names[state], state);
+            }
+            compiled_table.state_count = static_cast<uint32_t>(compiled_table.state_names.size());
+            compiled_table.start_state = 0;
+
+            // 2. terminals and non-terminals, each numbered by name
+            for (const auto &symbol : parsing_table.all_symbols)
+            {
+                (symbol.is_terminal ? compiled_table.terminals : compiled_table.non_terminals).push_back(symbol);
+            }
+            std::sort(compiled_table.terminals.begin(), compiled_table.terminals.end(), symbol_name_less);
+            std::sort(compiled_table.non_terminals.begin(), compiled_table.non_terminals.end(), symbol_name_less);
+            for (uint32_t terminal = 0; terminal < compiled_table.terminals.size(); ++terminal)
+            {
+                compiled_table.terminal_ids_by_name.emplace(compiled_table.terminals[terminal].name, terminal);
+                if (compiled_table.terminals[terminal].special_property == "END")
+                {
+                    compiled_table.end_terminal = terminal;
+                }
+            }
+            if (compiled_table.terminal_ids_by_name.size() != compiled_table.terminals.size())
+            {
+                throw std::runtime_error("Two terminals of the table share a name");
+            }
+            for (uint32_t non_terminal = 0; non_terminal < compiled_table.non_terminals.size(); ++non_terminal)
+            {
+                compiled_table.non_terminal_ids.emplace(compiled_table.non_terminals[non_terminal], non_terminal);
+            }
+
+            // 3. productions, under the grammar's production ids the reduce actions carry
+            // productions that are never reduced (the augmented start, ones the CFG reduction removed) keep an invalid lhs
+            if (parsing_table.production_table)
+            {
+                const lr_parsing_model::ProductionTable &production_table = *parsing_table.production_table;
+                compiled_table.productions.reserve(production_table.size());
+                for (uint32_t production = 0; production < production_table.size(); ++production)
+                {
+                    const lr_parsing_model::Production &source = production_table.production(production);
+                    auto lhs_it = compiled_table.non_terminal_ids.find(source.lhs);
+                    uint32_t lhs = lhs_it == compiled_table.non_terminal_ids.end() ? CompiledLRTable::invalid_id : lhs_it->second;
+                    compiled_table.productions.push_back({lhs, static_cast<uint32_t>(source.rhs.size())});
+                }
+            }
+
+            // 4. the action rows, dense first, then stripped of their default
+            auto encode = [&](const lr_parsing_model::Action &action) {
+                if (action.action_type == "shift")
+                {
+                    auto target_it = state_ids.find(action.target_state);
+                    if (target_it == state_ids.end())
+                    {
+                        throw std::runtime_error("Shift to a state out of the table: " + action.target_state);
+                    }
+                    return CompiledLRTable::make_shift(target_it->second);
+                }
+                else if (action.action_type == "reduce")
+                {
+                    if (action.reduce_production >= compiled_table.productions.size())
+                    {
+                        throw std::runtime_error("Reduce by a production out of the production table: " + std::to_string(action.reduce_production));
+                    }
+                    if (compiled_table.productions[action.reduce_production].lhs == CompiledLRTable::invalid_id)
+                    {
+                        throw std::runtime_error("Reduce to a non-terminal out of the table: " +
+                                                 parsing_table.production_table->production(action.reduce_production).lhs.name);
+                    }
+                    return CompiledLRTable::make_reduce(action.reduce_production);
+                }
+                else if (action.action_type == "accept")
+                {
+                    return CompiledLRTable::accept_action;
+                }
+                else if (action.action_type == "empty")
+                {
+                    return CompiledLRTable::error_action;
+                }
+                throw std::runtime_error("Unknown action type: " + action.action_type);
+            };
+            const uint32_t terminal_count = static_cast<uint32_t>(compiled_table.terminals.size());
+            std::vector<std::vector<std::pair<uint32_t, int32_t>>> action_rows(compiled_table.state_count);
+            compiled_table.default_actions.assign(compiled_table.state_count, CompiledLRTable::error_action);
+            size_t conflict_count = 0;
+            size_t filled_action_count = 0;
+            for (uint32_t state = 0; state < compiled_table.state_count; ++state)
+            {
+                std::vector<int32_t> row(terminal_count, CompiledLRTable::error_action);
+                auto state_row = parsing_table.action_table.find(compiled_table.state_names[state]);
+                if (state_row != parsing_table.action_table.end())
+                {
+                    for (const auto &cell : state_row->second)
+                    {
+                        auto terminal_it = compiled_table.terminal_ids_by_name.find(cell.first.name);
+                        if (!cell.first.is_terminal || terminal_it == compiled_table.terminal_ids_by_name.end() || cell.second.empty())
+                        {
+                            continue;
+                        }
+                        if (cell.second.size() > 1)
+                        {
+                            row[terminal_it->second] = CompiledLRTable::conflict_action;
+                            conflict_count++;
+                            continue;
+                        }
+                        row[terminal_it->second] = encode(*cell.second.begin());
+                    }
+                }
+                if (default_reductions)
+                {
+                    std::vector<int32_t> reduces;
+                    for (const auto cell : row)
+                    {
+                        if (CompiledLRTable::action_kind(cell) == CompiledLRTable::REDUCE)
+                        {
+                            reduces.push_back(cell);
+                        }
+                    }
+                    compiled_table.default_actions[state] = most_frequent(reduces, CompiledLRTable::error_action);
+                }
+                for (uint32_t terminal = 0; terminal < terminal_count; ++terminal)
+                {
+                    if (row[terminal] == compiled_table.default_actions[state])
+                    {
+                        continue;
+                    }
+                    // an error cell of a defaulted state takes the default
+                    if (row[terminal] == CompiledLRTable::error_action)
+                    {
+                        continue;
+                    }
+                    action_rows[state].emplace_back(terminal, row[terminal]);
+                    filled_action_count++;
+                }
+            }
+            compiled_table.action_rows = pack_comb_vector(action_rows, terminal_count);
+
+            // 5. the goto columns, one per non-terminal, stripped of the most frequent target
+            const uint32_t non_terminal_count = static_cast<uint32_t>(compiled_table.non_terminals.size());
+            std::vector<std::vector<std::pair<uint32_t, int32_t>>> goto_columns(non_terminal_count);
+            std::vector<std::vector<int32_t>> targets(non_terminal_count);
+            for (const auto &state_row : parsing_table.goto_table)
+            {
+                auto state_it = state_ids.find(state_row.first);
+                if (state_it == state_ids.end())
+                {
+                    continue;
+                }
+                for (const auto &cell : state_row.second)
+                {
+                    auto non_terminal_it = compiled_table.non_terminal_ids.find(cell.first);
+                    if (non_terminal_it == compiled_table.non_terminal_ids.end())
+                    {
+                        continue;
+                    }
+                    std::vector<std::string> cell_targets;
+                    for (const auto &target : cell.second)
+                    {
+                        if (!target.empty())
+                        {
+                            cell_targets.push_back(target);
+                        }
+                    }
+                    if (cell_targets.empty())
+                    {
+                        continue;
+                    }
+                    if (cell_targets.size() > 1)
+                    {
+                        throw std::runtime_error("Goto conflict in state " + state_row.first + " on " + cell.first.name);
+                    }
+                    auto target_it = state_ids.find(cell_targets.front());
+                    if (target_it == state_ids.end())
+                    {
+                        throw std::runtime_error("Goto to a state out of the table: " + cell_targets.front());
+                    }
+                    goto_columns[non_terminal_it->second].emplace_back(state_it->second, static_cast<int32_t>(target_it->second));
+                    targets[non_terminal_it->second].push_back(static_cast<int32_t>(target_it->second));
+                }
+            }
+            compiled_table.default_gotos.assign(non_terminal_count, CompiledLRTable::invalid_id);
+            size_t filled_goto_count = 0;
+            for (uint32_t non_terminal = 0; non_terminal < non_terminal_count; ++non_terminal)
+            {
+                int32_t default_goto = most_frequent(targets[non_terminal], static_cast<int32_t>(CompiledLRTable::invalid_id));
+                compiled_table.default_gotos[non_terminal] = static_cast<uint32_t>(default_goto);
+                auto &column = goto_columns[non_terminal];
+                column.erase(std::remove_if(column.begin(), column.end(), [default_goto](const std::pair<uint32_t, int32_t> &cell) {
+                                 return cell.second == default_goto;
+                             }),
+                             column.end());
+                std::sort(column.begin(), column.end());
+                filled_goto_count += column.size();
+            }
+            compiled_table.goto_columns = pack_comb_vector(goto_columns, compiled_table.state_count);
+
+            if (conflict_count > 0)
+            {
+                spdlog::warn("Compiled LR table keeps {} conflicting cells as errors", conflict_count);
+            }
+            spdlog::info("Compiled LR table with {} states, {} terminals, {} non-terminals and {} productions: "
+                         "{} action cells in {} slots, {} goto cells in {} slots",
+                         compiled_table.state_count, terminal_count, non_terminal_count, compiled_table.productions.size(),
+                         filled_action_count, compiled_table.action_rows.values.size(),
+                         filled_goto_count, compiled_table.goto_columns.values.size());
+            return compiled_table;
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_msg = "Error compiling LR parsing table: " + std::string(e.what());
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+}
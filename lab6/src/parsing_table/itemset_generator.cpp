@@ -18,8 +18,11 @@ lr_parsing_model::ItemSet ItemSetGenerator::generate_item_set(const cfg_model::C
     cfg_model::symbol original_initial_symbol = cfg.start_symbol;
     cfg_model::symbol new_initial_symbol = expanded_cfg.start_symbol;
     // 2. generate the items for the expanded cfg
-    auto items = itemset_generator_helper::generate_cfg_items(expanded_cfg);
+    // seeded with the grammar's numbering, so item production ids are the grammar's production ids
+    auto production_table = std::make_shared<lr_parsing_model::ProductionTable>(expanded_cfg.production_numbering);
+    auto items = itemset_generator_helper::generate_cfg_items(expanded_cfg, production_table);
     // 3. add the items to the item set
+    item_set.production_table = production_table;
     item_set.items = items;
     spdlog::debug("Item set generated with {} items", items.size());
     // 4. find the items related to the new initial symbol
@@ -27,25 +30,25 @@ lr_parsing_model::ItemSet ItemSetGenerator::generate_item_set(const cfg_model::C
     std::shared_ptr<lr_parsing_model::Item> parsing_end_item;
     for (const auto &item : items)
     {
-        spdlog::debug("Item: {} -> ", item->left_side_symbol.name);
-        if (item->left_side_symbol == new_initial_symbol)
+        spdlog::debug("Item: {} -> ", item->left_side_symbol().name);
+        if (item->left_side_symbol() == new_initial_symbol)
         {
-            spdlog::debug("Found the item for the new initial symbol: {} -> ", item->left_side_symbol.name);
+            spdlog::debug("Found the item for the new initial symbol: {} -> ", item->left_side_symbol().name);
             // check if the item is the initial item
-            if (item->sequence_already_parsed.empty() && item->sequence_to_parse.size() == 1)
+            if (item->sequence_already_parsed().empty() && item->sequence_to_parse().size() == 1)
             {
-                spdlog::debug("Found the start item: {} -> · {}", item->left_side_symbol.name, item->sequence_to_parse[0].name);
+                spdlog::debug("Found the start item: {} -> · {}", item->left_side_symbol().name, item->sequence_to_parse()[0].name);
                 parsing_start_item = item;
             }
-            else if (item->sequence_already_parsed.size() == 1 && item->sequence_already_parsed[0] == original_initial_symbol && item->sequence_to_parse.empty())
+            else if (item->sequence_already_parsed().size() == 1 && item->sequence_already_parsed()[0] == original_initial_symbol && item->sequence_to_parse().empty())
             {
-                spdlog::debug("Found the end item: {} -> {} ·", item->left_side_symbol.name, item->sequence_already_parsed[0].name);
+                spdlog::debug("Found the end item: {} -> {} ·", item->left_side_symbol().name, item->sequence_already_parsed()[0].name);
                 parsing_end_item = item;
             }
             else
             {
-                std::string error_msg = "Error: The item set is not valid. The new initial symbol has an unexpected item: " + item->left_side_symbol.name + " -> ";
-                for (const auto &symbol : item->sequence_already_parsed)
+                std::string error_msg = "Error: The item set is not valid. The new initial symbol has an unexpected item: " + item->left_side_symbol().name + " -> ";
+                for (const auto &symbol : item->sequence_already_parsed())
                 {
                     error_msg += symbol.name + " ";
                 }
@@ -125,6 +128,13 @@ cfg_model::CFG itemset_generator_helper::expand_cfg(const cfg_model::CFG &cfg)
         end_symbol.special_property = "END";
         // add the end symbol to the CFG
         expanded_cfg.terminals.insert(end_symbol);
+        // 7. give the new symbols ids after the original ones
+        expanded_cfg.symbol_interner.intern(new_initial_symbol);
+        expanded_cfg.symbol_interner.intern(end_symbol);
+        cfg_model_helper::intern_cfg_symbols(expanded_cfg);
+        // the new production is numbered after the original ones too
+        expanded_cfg.production_numbering.number(new_initial_symbol, new_production_rule);
+        cfg_model_helper::number_cfg_productions(expanded_cfg);
         return expanded_cfg;
     }
     catch (const std::exception &e)
@@ -135,17 +145,15 @@ cfg_model::CFG itemset_generator_helper::expand_cfg(const cfg_model::CFG &cfg)
     }
 }
 
-std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_helper::gen_epsilon_production_rule_items(const cfg_model::symbol &left_side_symbol)
+std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_helper::gen_epsilon_production_rule_items(const std::shared_ptr<lr_parsing_model::ProductionTable> &production_table, const cfg_model::symbol &left_side_symbol)
 {
     try
     {
         // generate the item set for a given production rule(epsilon)
         std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> items;
-        std::shared_ptr<lr_parsing_model::Item> item = std::make_shared<lr_parsing_model::Item>();
-        item->left_side_symbol = left_side_symbol;
-        // set two vectors to empty
-        item->sequence_already_parsed = {};
-        item->sequence_to_parse = {};
+        // the only item of an epsilon production is A -> ·
+        uint32_t production_id = production_table->add_production(left_side_symbol, {});
+        std::shared_ptr<lr_parsing_model::Item> item = std::make_shared<lr_parsing_model::Item>(production_table, production_id, 0);
         // insert the item into the set
         items.insert(item);
         spdlog::debug("Generated epsilon production rule item: {} -> ε", left_side_symbol.name);
@@ -159,30 +167,28 @@ std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_he
     }
 }
 
-std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_helper::gen_non_epsilon_production_rule_items(const cfg_model::symbol &left_side_symbol, const std::vector<cfg_model::symbol> &right_side_sequence)
+std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_helper::gen_non_epsilon_production_rule_items(const std::shared_ptr<lr_parsing_model::ProductionTable> &production_table, const cfg_model::symbol &left_side_symbol, const std::vector<cfg_model::symbol> &right_side_sequence)
 {
     try
     {
         // generate the item set for a given production rule(not epsilon)
         std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> items;
+        uint32_t production_id = production_table->add_production(left_side_symbol, right_side_sequence);
 
         // generate all items for the given production rule
         for (size_t i = 0; i <= right_side_sequence.size(); ++i)
         {
             // create a new item
-            std::shared_ptr<lr_parsing_model::Item> item = std::make_shared<lr_parsing_model::Item>();
-            item->left_side_symbol = left_side_symbol;
-            item->sequence_already_parsed = std::vector<cfg_model::symbol>(right_side_sequence.begin(), right_side_sequence.begin() + i);
-            item->sequence_to_parse = std::vector<cfg_model::symbol>(right_side_sequence.begin() + i, right_side_sequence.end());
+            std::shared_ptr<lr_parsing_model::Item> item = std::make_shared<lr_parsing_model::Item>(production_table, production_id, static_cast<uint32_t>(i));
             // insert the item into the set
             items.insert(item);
             std::string parsed_sequence_str = "";
             std::string to_parse_sequence_str = "";
-            for (const auto &symbol : item->sequence_already_parsed)
+            for (const auto &symbol : item->sequence_already_parsed())
             {
                 parsed_sequence_str += symbol.name + " ";
             }
-            for (const auto &symbol : item->sequence_to_parse)
+            for (const auto &symbol : item->sequence_to_parse())
             {
                 to_parse_sequence_str += symbol.name + " ";
             }
@@ -199,7 +205,7 @@ std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_he
     }
 }
 
-std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_helper::generate_cfg_items(const cfg_model::CFG &cfg)
+std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_helper::generate_cfg_items(const cfg_model::CFG &cfg, const std::shared_ptr<lr_parsing_model::ProductionTable> &production_table)
 {
     try
     {
@@ -209,7 +215,7 @@ std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_he
         // 1. generate items for epsilon production rules
         for (const auto &epsilon_symbol : cfg.epsilon_production_symbols)
         {
-            auto epsilon_items = gen_epsilon_production_rule_items(epsilon_symbol);
+            auto epsilon_items = gen_epsilon_production_rule_items(production_table, epsilon_symbol);
             items.insert(epsilon_items.begin(), epsilon_items.end());
         }
         spdlog::debug("Eplison production rules items generated");
@@ -221,7 +227,7 @@ std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> itemset_generator_he
             const auto &right_side_sequences_set = rule.second;
             for (const auto &right_side_sequence : right_side_sequences_set)
             {
-                auto non_epsilon_items = gen_non_epsilon_production_rule_items(left_side_symbol, right_side_sequence);
+                auto non_epsilon_items = gen_non_epsilon_production_rule_items(production_table, left_side_symbol, right_side_sequence);
                 items.insert(non_epsilon_items.begin(), non_epsilon_items.end());
             }
         }
@@ -129,13 +129,12 @@ lr_parsing_model::LRParsingTable ItemSetToParsingTable::build_parsing_table()
             for (const auto &item : items_in_accepting_state)
             {
                 // check if the item is an accepting state and not the end item
-                if (item->sequence_to_parse.empty() && item != item_set.end_item)
+                if (item->sequence_to_parse().empty() && item != item_set.end_item)
                 {
                     // create a reduce action
                     lr_parsing_model::Action reduce_action;
                     reduce_action.action_type = "reduce";
-                    reduce_action.reduce_rule_lhs = item->left_side_symbol;
-                    reduce_action.reduce_rule_rhs = item->sequence_already_parsed;
+                    reduce_action.reduce_production = item->production_id();
                     // add the action to the parsing table for all symbols
                     for (const auto &symbol : item_set.symbol_set)
                     {
@@ -236,6 +235,7 @@ lr_parsing_model::LRParsingTable ItemSetToParsingTable::build_parsing_table()
         std::string start_item_state = *start_item_states.begin();
         // add the start state to the parsing table
         new_parsing_table.start_state = start_item_state;
+        new_parsing_table.production_table = item_set.production_table;
         spdlog::debug("Start state of the parsing table: {}", start_item_state);
         // 7. return the parsing table & update the class member variable
         spdlog::debug("Parsing table built successfully, with {} states and {} symbols", new_parsing_table.all_states.size(), new_parsing_table.all_symbols.size());
@@ -301,7 +301,7 @@ lr_parsing_model::ItemSetNFAGenerationResult ItemSetToParsingTable::generate_nfa
             new_item_set_nfa_mapping.item_set_to_nfa_state[item] = state_name;
             new_item_set_nfa_mapping.nfa_state_to_item_set[state_name] = item;
             // check if the item is an accepting state
-            if (item->sequence_to_parse.empty())
+            if (item->sequence_to_parse().empty())
             {
                 new_nfa.accepting_states.insert(state_name);
             }
@@ -316,23 +316,19 @@ lr_parsing_model::ItemSetNFAGenerationResult ItemSetToParsingTable::generate_nfa
         for (const auto &item : item_set.items)
         {
             // check if the sequence to parse is empty, if so, skip
-            if (item->sequence_to_parse.empty())
+            if (item->sequence_to_parse().empty())
             {
                 continue;
             }
             // get the first symbol in the sequence to parse
-            const auto &first_symbol = item->sequence_to_parse[0];
+            const auto &first_symbol = item->sequence_to_parse()[0];
             // be it a terminal or non-terminal, a transition to the next parsing item is needed
             // get the NFA state name in the mapping
             std::string from_state = new_item_set_nfa_mapping.item_set_to_nfa_state[item];
             // get the NFA character name in the mapping
             std::string character_name = new_item_set_nfa_mapping.item_set_symbol_to_nfa_character[first_symbol];
             // construct the next parsing item
-            lr_parsing_model::Item next_item;
-            next_item.left_side_symbol = item->left_side_symbol;
-            next_item.sequence_already_parsed = item->sequence_already_parsed;
-            next_item.sequence_already_parsed.push_back(first_symbol);
-            next_item.sequence_to_parse = std::vector<cfg_model::symbol>(item->sequence_to_parse.begin() + 1, item->sequence_to_parse.end());
+            lr_parsing_model::Item next_item = item->advanced();
             // get the NFA state name for the next item
             std::string to_state = itemset_to_parsing_table_helper::generate_nfa_state_name(next_item);
             // ensure the name is already in the NFA
@@ -353,7 +349,7 @@ lr_parsing_model::ItemSetNFAGenerationResult ItemSetToParsingTable::generate_nfa
                 for (const auto &next_item : item_set.items)
                 {
                     // check if the left side symbol is the same as the first symbol
-                    if (next_item->left_side_symbol == first_symbol && next_item->sequence_already_parsed.empty())
+                    if (next_item->left_side_symbol() == first_symbol && next_item->sequence_already_parsed().empty())
                     {
                         // get the NFA state name in the mapping
                         std::string from_state = new_item_set_nfa_mapping.item_set_to_nfa_state[item];
@@ -0,0 +1,281 @@
+#include "lalr1_parsing_table_generator.h"
+#include "lr1_parsing_table_generator.h"
+#include "cfg_model.h"
+#include "lr_parsing_model.h"
+#include "itemset_generator.h"
+#include "itemset_to_parsing_table.h"
+#include "cfg_analyzer.h"
+#include "spdlog/spdlog.h"
+#include "log_macros.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include <memory>
+
+lr_parsing_model::ItemSet LALR1ParsingTableGenerator::generate_item_set(const cfg_model::CFG &cfg)
+{
+    try
+    {
+        // Generate the item set from the reduced grammar
+        ItemSetGenerator item_set_generator;
+        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(prepare_cfg(cfg));
+
+        return item_set;
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error generating item set: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+lr_parsing_model::LR1ItemSetDFAGenerationResult LALR1ParsingTableGenerator::generate_item_set_dfa(const cfg_model::CFG &cfg)
+{
+    try
+    {
+        LAB_LOG_DEBUG("Generating item set DFA for LALR(1) parsing table...");
+        // the LR(0) automaton and the analyzer both work on the reduced grammar
+        cfg_model::CFG reduced_cfg = prepare_cfg(cfg);
+        ItemSetGenerator item_set_generator;
+        lr_parsing_model::ItemSet lr0_item_set = item_set_generator.generate_item_set(reduced_cfg);
+        cfg_model::CFG expanded_cfg = itemset_generator_helper::expand_cfg(reduced_cfg);
+        CFGAnalyzer cfg_analyzer(expanded_cfg);
+        cfg_analyzer.computeFirstSet();
+
+        ItemSetToParsingTable lr0_automaton(lr0_item_set);
+        lr_parsing_model::ItemSetDFAGenerationResult lr0_dfa_result = lr0_automaton.get_dfa();
+        lalr1_parsing_table_generator_helper::LookaheadTable lookaheads =
+            lalr1_parsing_table_generator_helper::compute_lalr1_lookaheads(lr0_dfa_result, lr0_item_set, cfg_analyzer);
+
+        // re-label the LR(0) states with LR(1) items, the states and transitions stay as they are
+        lr_parsing_model::LR1ItemSetDFAGenerationResult result;
+        result.dfa = lr0_dfa_result.dfa;
+        result.item_set_dfa_mapping.item_set_symbol_to_dfa_character = lr0_dfa_result.item_set_dfa_mapping.item_set_symbol_to_dfa_character;
+        result.item_set_dfa_mapping.dfa_character_to_item_set_symbol = lr0_dfa_result.item_set_dfa_mapping.dfa_character_to_item_set_symbol;
+        // the lookahead bitsets of the table are interned as they are
+        pool_.reset(lr1_parsing_table_generator_helper::make_lookahead_set_table(cfg_analyzer));
+        result.lr1_item_set = lr1_parsing_table_generator_helper::generate_blank_lr1_item_set(lr0_item_set, pool_);
+        const cfg_model::symbol &augmented_symbol = lr0_item_set.start_item->left_side_symbol();
+        // reduces are only added in accepting states, every state with a completed item has to be one
+        result.dfa.accepting_states.clear();
+        result.dfa.accepting_states.insert(result.dfa.initial_state);
+        for (const auto &state_items : lr0_dfa_result.item_set_dfa_mapping.dfa_state_to_item_set)
+        {
+            const std::string &state = state_items.first;
+            auto state_lookaheads = lookaheads.find(state);
+            for (const auto &item : state_items.second)
+            {
+                std::shared_ptr<lr_parsing_model::LR1Item> lr1_item;
+                if (item->left_side_symbol() == augmented_symbol)
+                {
+                    lr1_item = pool_.get_or_create(*item, std::static_pointer_cast<lr_parsing_model::LR1Item>(result.lr1_item_set.start_item)->lookahead_set_id);
+                }
+                else if (item->is_accepting())
+                {
+                    uint32_t lookahead_set_id = lr_parsing_model::LookaheadSetTable::empty_set;
+                    if (state_lookaheads != lookaheads.end())
+                    {
+                        auto item_lookaheads = state_lookaheads->second.find(*item);
+                        if (item_lookaheads != state_lookaheads->second.end())
+                        {
+                            lookahead_set_id = pool_.get_lookahead_table()->intern(item_lookaheads->second);
+                        }
+                    }
+                    lr1_item = pool_.get_or_create(*item, lookahead_set_id);
+                }
+                else
+                {
+                    lr1_item = pool_.get_or_create(*item, lr_parsing_model::LookaheadSetTable::empty_set);
+                }
+                if (item->is_accepting())
+                {
+                    result.dfa.accepting_states.insert(state);
+                }
+                result.item_set_dfa_mapping.item_set_to_dfa_state[lr1_item].insert(state);
+                result.item_set_dfa_mapping.dfa_state_to_item_set[state].insert(lr1_item);
+                result.lr1_item_set.items.insert(lr1_item);
+            }
+        }
+        LAB_LOG_DEBUG("LALR(1) item set DFA generated with {} states and {} items",
+                      result.dfa.states_set.size(), result.lr1_item_set.items.size());
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error generating item set DFA: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+lr_parsing_model::LRParsingTable LALR1ParsingTableGenerator::generate_parsing_table(const cfg_model::CFG &cfg)
+{
+    try
+    {
+        LAB_LOG_DEBUG("Generating LALR(1) parsing table for CFG: {}", cfg.start_symbol.name);
+        // same table construction & conflict resolution as LR(1), only the automaton differs
+        lr_parsing_model::LR1ItemSetDFAGenerationResult item_set_dfa_result = generate_item_set_dfa(cfg);
+        return lr1_parsing_table_generator_helper::build_parsing_table(item_set_dfa_result);
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error generating parsing table: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+// helper functions
+namespace lalr1_parsing_table_generator_helper
+{
+    LookaheadTable compute_lalr1_lookaheads(
+        const lr_parsing_model::ItemSetDFAGenerationResult &lr0_dfa_result,
+        const lr_parsing_model::ItemSet &lr0_item_set,
+        const CFGAnalyzer &cfg_analyzer)
+    {
+        try
+        {
+            const dfa_model::DFA<std::string> &dfa = lr0_dfa_result.dfa;
+            const lr_parsing_model::ItemSetDFAMapping &mapping = lr0_dfa_result.item_set_dfa_mapping;
+            const std::unordered_set<cfg_model::symbol> &nullable_symbols = cfg_analyzer.getFirstSet().symbols_with_epsilon;
+            const size_t terminal_count = cfg_analyzer.getTerminalCount();
+            auto goto_state = [&](const std::string &state, const cfg_model::symbol &symbol) -> const std::string & {
+                auto row = dfa.transitions.find(state);
+                auto character = mapping.item_set_symbol_to_dfa_character.find(symbol);
+                if (row == dfa.transitions.end() || character == mapping.item_set_symbol_to_dfa_character.end() ||
+                    row->second.find(character->second) == row->second.end())
+                {
+                    throw std::runtime_error("No transition from state " + state + " on symbol " + std::string(symbol));
+                }
+                return row->second.at(character->second);
+            };
+
+            // 1. number the non-terminal transitions, they are the nodes of both relations
+            std::vector<std::pair<std::string, cfg_model::symbol>> transitions;
+            std::unordered_map<std::string, std::unordered_map<cfg_model::symbol, uint32_t>> transition_index;
+            for (const auto &state_transitions : dfa.transitions)
+            {
+                for (const auto &transition : state_transitions.second)
+                {
+                    const cfg_model::symbol &symbol = mapping.dfa_character_to_item_set_symbol.at(transition.first);
+                    if (!symbol.is_terminal)
+                    {
+                        transition_index[state_transitions.first][symbol] = static_cast<uint32_t>(transitions.size());
+                        transitions.emplace_back(state_transitions.first, symbol);
+                    }
+                }
+            }
+            LAB_LOG_DEBUG("LR(0) automaton has {} non-terminal transitions", transitions.size());
+
+            // 2. DR(p, A): terminals shifted right after goto(p, A), END if S' -> S · is there
+            //    (p, A) reads (goto(p, A), C) for every nullable C read there
+            uint32_t end_bit = cfg_model::invalid_symbol_id;
+            for (const auto &symbol : lr0_item_set.symbol_set)
+            {
+                if (symbol.special_property == "END")
+                {
+                    end_bit = cfg_analyzer.getTerminalBit(symbol);
+                }
+            }
+            if (end_bit == cfg_model::invalid_symbol_id)
+            {
+                throw std::runtime_error("End symbol not found in the item set");
+            }
+            std::vector<cfg_model::TerminalSet> follow_bits(transitions.size(), cfg_model::TerminalSet(terminal_count));
+            std::vector<std::vector<uint32_t>> reads(transitions.size());
+            for (uint32_t x = 0; x < transitions.size(); ++x)
+            {
+                const std::string &target = goto_state(transitions[x].first, transitions[x].second);
+                auto row = dfa.transitions.find(target);
+                if (row != dfa.transitions.end())
+                {
+                    for (const auto &transition : row->second)
+                    {
+                        const cfg_model::symbol &symbol = mapping.dfa_character_to_item_set_symbol.at(transition.first);
+                        if (symbol.is_terminal)
+                        {
+                            follow_bits[x].set(cfg_analyzer.getTerminalBit(symbol));
+                        }
+                        else if (nullable_symbols.find(symbol) != nullable_symbols.end())
+                        {
+                            reads[x].push_back(transition_index.at(target).at(symbol));
+                        }
+                    }
+                }
+                const auto &target_items = mapping.dfa_state_to_item_set.at(target);
+                if (target_items.find(lr0_item_set.end_item) != target_items.end())
+                {
+                    follow_bits[x].set(end_bit);
+                }
+            }
+            // Read sets
+            cfg_analyzer_helper::propagate_over_digraph(reads, follow_bits);
+
+            // 3. walk every B -> β from the states p' that read B, the walk ends in the state that reduces it
+            //    (p, A) includes (p', B) for every A on the way whose rest of β is nullable
+            lr1_parsing_table_generator_helper::LR0ItemIndex lr0_item_index(lr0_item_set);
+            std::vector<std::vector<uint32_t>> includes(transitions.size());
+            std::unordered_map<std::string, std::unordered_map<lr_parsing_model::Item, std::vector<uint32_t>>> lookback;
+            for (uint32_t x = 0; x < transitions.size(); ++x)
+            {
+                for (const auto &initial_item : lr0_item_index.initial_items(transitions[x].second))
+                {
+                    std::string state = transitions[x].first;
+                    const lr_parsing_model::Item *item = initial_item.get();
+                    while (!item->sequence_to_parse().empty())
+                    {
+                        const cfg_model::symbol &symbol = item->sequence_to_parse()[0];
+                        if (!symbol.is_terminal)
+                        {
+                            bool rest_nullable = true;
+                            for (size_t i = 1; i < item->sequence_to_parse().size() && rest_nullable; ++i)
+                            {
+                                rest_nullable = nullable_symbols.find(item->sequence_to_parse()[i]) != nullable_symbols.end();
+                            }
+                            if (rest_nullable)
+                            {
+                                includes[transition_index.at(state).at(symbol)].push_back(x);
+                            }
+                        }
+                        state = goto_state(state, symbol);
+                        item = lr0_item_index.advance(*item).get();
+                    }
+                    lookback[state][*item].push_back(x);
+                }
+            }
+            // Follow sets
+            cfg_analyzer_helper::propagate_over_digraph(includes, follow_bits);
+
+            // 4. LA(q, A -> ω) from the lookback transitions, S' -> S · only ever sees END
+            LookaheadTable lookaheads;
+            for (const auto &state_lookback : lookback)
+            {
+                for (const auto &item_lookback : state_lookback.second)
+                {
+                    cfg_model::TerminalSet item_lookaheads(terminal_count);
+                    for (const auto x : item_lookback.second)
+                    {
+                        item_lookaheads.union_with(follow_bits[x]);
+                    }
+                    lookaheads[state_lookback.first].emplace(item_lookback.first, std::move(item_lookaheads));
+                }
+            }
+            for (const auto &end_state : mapping.item_set_to_dfa_state.at(lr0_item_set.end_item))
+            {
+                cfg_model::TerminalSet end_lookaheads(terminal_count);
+                end_lookaheads.set(end_bit);
+                lookaheads[end_state].emplace(*lr0_item_set.end_item, std::move(end_lookaheads));
+            }
+            LAB_LOG_DEBUG("LALR(1) lookaheads computed for {} states", lookaheads.size());
+            return lookaheads;
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_msg = "Error computing LALR(1) lookaheads: " + std::string(e.what());
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include "ll1_parsing_table_generator.h"
+#include "ll_parsing_model.h"
+#include "cfg_model.h"
+#include "cfg_analyzer.h"
+#include "itemset_generator.h"
+#include "spdlog/spdlog.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+
+ll_parsing_model::LL1ParsingTable LL1ParsingTableGenerator::generate_parsing_table(const cfg_model::CFG &cfg)
+{
+    try
+    {
+        last_conflicts.clear();
+        cfg_model::CFG working_cfg = prepare_cfg(cfg);
+        // the expanded grammar only contributes the END symbol to FOLLOW(start), S' -> S itself is not a table row
+        cfg_model::CFG expanded_cfg = itemset_generator_helper::expand_cfg(working_cfg);
+
+        CFGAnalyzer analyzer(expanded_cfg);
+        analyzer.computeFirstSet();
+        analyzer.computeFollowSet();
+        analyzer.computeSuffixFirstSets();
+        const cfg_model::IndexedGrammar &grammar = analyzer.getIndexedGrammar();
+        const cfg_model::FollowSet &follow_set = analyzer.getFollowSet();
+
+        ll_parsing_model::LL1ParsingTable parsing_table;
+        parsing_table.start_symbol = working_cfg.start_symbol;
+        parsing_table.end_symbol = follow_set.end_symbol;
+        for (const auto &terminal : expanded_cfg.terminals)
+        {
+            parsing_table.all_symbols.insert(terminal);
+        }
+        for (const auto &non_terminal : working_cfg.non_terminals)
+        {
+            parsing_table.all_symbols.insert(non_terminal);
+        }
+
+        size_t prediction_count = 0;
+        for (uint32_t production_index = 0; production_index < grammar.productions.size(); ++production_index)
+        {
+            const cfg_model::IndexedProduction &production = grammar.productions[production_index];
+            if (production.lhs == grammar.start_symbol)
+            {
+                continue;
+            }
+            const cfg_model::symbol &lhs = grammar.interner.symbol_of(production.lhs);
+            std::vector<cfg_model::symbol> rhs;
+            rhs.reserve(production.rhs.size());
+            for (const auto id : production.rhs)
+            {
+                rhs.push_back(grammar.interner.symbol_of(id));
+            }
+            // a ∈ FIRST(α)
+            analyzer.getSuffixFirst(production_index, 0).for_each([&](size_t bit) {
+                if (parsing_table.add_prediction(lhs, analyzer.getTerminalOfBit(bit), rhs))
+                {
+                    prediction_count++;
+                }
+            });
+            // a ∈ FOLLOW(A) if α =>* ε
+            if (analyzer.isSuffixNullable(production_index, 0))
+            {
+                auto follow_it = follow_set.follow_set.find(lhs);
+                if (follow_it == follow_set.follow_set.end())
+                {
+                    continue;
+                }
+                for (const auto &lookahead : follow_it->second)
+                {
+                    if (parsing_table.add_prediction(lhs, lookahead, rhs))
+                    {
+                        prediction_count++;
+                    }
+                }
+            }
+        }
+
+        last_conflicts = parsing_table.find_conflicts();
+        for (const auto &conflict : last_conflicts)
+        {
+            spdlog::warn("LL(1) conflict: {}", std::string(conflict));
+        }
+        spdlog::info("LL(1) parsing table generated with {} predictions and {} conflicts", prediction_count, last_conflicts.size());
+        return parsing_table;
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error generating LL(1) parsing table: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
@@ -0,0 +1,105 @@
+#include "ll_parsing_model.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ll_parsing_model
+{
+    namespace
+    {
+        std::string rhs_to_string(const std::vector<cfg_model::symbol> &rhs)
+        {
+            if (rhs.empty())
+            {
+                return "ε";
+            }
+            std::string result;
+            for (const auto &s : rhs)
+            {
+                if (!result.empty())
+                {
+                    result += " ";
+                }
+                result += s.name;
+            }
+            return result;
+        }
+
+        std::vector<std::string> rhs_names(const std::vector<cfg_model::symbol> &rhs)
+        {
+            std::vector<std::string> names;
+            names.reserve(rhs.size());
+            for (const auto &s : rhs)
+            {
+                names.push_back(s.name);
+            }
+            return names;
+        }
+    }
+
+    LL1Conflict::operator std::string() const
+    {
+        std::string result = "M[" + non_terminal.name + ", " + lookahead.name + "] = {";
+        for (size_t i = 0; i < candidate_rhs.size(); ++i)
+        {
+            result += (i == 0 ? " " : " | ") + non_terminal.name + " -> " + rhs_to_string(candidate_rhs[i]);
+        }
+        result += " }";
+        return result;
+    }
+
+    bool LL1ParsingTable::add_prediction(const cfg_model::symbol &non_terminal, const cfg_model::symbol &lookahead, const std::vector<cfg_model::symbol> &rhs)
+    {
+        auto &cell = prediction_table[non_terminal][lookahead];
+        return cell.insert(rhs).second;
+    }
+
+    const std::unordered_set<std::vector<cfg_model::symbol>> *LL1ParsingTable::get_predictions(const cfg_model::symbol &non_terminal, const cfg_model::symbol &lookahead) const
+    {
+        auto row = prediction_table.find(non_terminal);
+        if (row == prediction_table.end())
+        {
+            return nullptr;
+        }
+        auto cell = row->second.find(lookahead);
+        if (cell == row->second.end() || cell->second.empty())
+        {
+            return nullptr;
+        }
+        return &cell->second;
+    }
+
+    std::vector<LL1Conflict> LL1ParsingTable::find_conflicts() const
+    {
+        std::vector<LL1Conflict> conflicts;
+        for (const auto &row : prediction_table)
+        {
+            for (const auto &cell : row.second)
+            {
+                if (cell.second.size() <= 1)
+                {
+                    continue;
+                }
+                LL1Conflict conflict;
+                conflict.non_terminal = row.first;
+                conflict.lookahead = cell.first;
+                conflict.candidate_rhs.assign(cell.second.begin(), cell.second.end());
+                std::sort(conflict.candidate_rhs.begin(), conflict.candidate_rhs.end(), [](const auto &a, const auto &b) {
+                    return rhs_names(a) < rhs_names(b);
+                });
+                conflicts.push_back(std::move(conflict));
+            }
+        }
+        // hash order is not stable, report in name order
+        std::sort(conflicts.begin(), conflicts.end(), [](const LL1Conflict &a, const LL1Conflict &b) {
+            if (a.non_terminal.name != b.non_terminal.name)
+            {
+                return a.non_terminal.name < b.non_terminal.name;
+            }
+            return a.lookahead.name < b.lookahead.name;
+        });
+        spdlog::debug("Found {} conflicts in LL(1) prediction table", conflicts.size());
+        return conflicts;
+    }
+
+} // namespace ll_parsing_model
@@ -1,18 +1,288 @@
 #include "cfg_model.h"
 #include "lr_parsing_model.h"
 #include "dfa_model.h"
+#include "dfa_builder.h"
 #include "itemset_generator.h"
 #include "lr1_parsing_table_generator.h"
 #include "spdlog/spdlog.h"
+#include "log_macros.h"
 #include "cfg_analyzer.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    // fixed set of workers running tasks that may spawn more tasks, the calling thread is worker 0
+    // a worker runs its own newest task first and steals the oldest task of another worker when it runs dry
+    class WorkStealingPool
+    {
+    public:
+        using Task = std::function<void(size_t worker)>;
+
+        explicit WorkStealingPool(size_t worker_count) : queues(worker_count) {}
+
+        // queue a task on a worker, a running task hands its follow-up work to its own worker
+        void submit(size_t worker, Task task)
+        {
+            pending.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(queues[worker].mutex);
+                queues[worker].tasks.push_back(std::move(task));
+            }
+            queued.fetch_add(1, std::memory_order_release);
+            wake(false);
+        }
+
+        // returns once every task, spawned ones included, is done, rethrows the first exception of a task
+        void run()
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(queues.size() - 1);
+            for (size_t worker = 1; worker < queues.size(); ++worker)
+            {
+                threads.emplace_back([this, worker]() { work_loop(worker); });
+            }
+            work_loop(0);
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+        std::vector<WorkerQueue> queues;
+        // submitted but not finished, a task submits its children before it counts as finished
+        std::atomic<size_t> pending{0};
+        // in some queue and not taken yet, what an idle worker waits for
+        std::atomic<size_t> queued{0};
+        std::atomic<bool> failed{false};
+        // idle workers sleep here instead of spinning, woken by a submit or by the last task finishing
+        std::mutex idle_mutex;
+        std::condition_variable work_available;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        bool take(size_t worker, Task &task)
+        {
+            {
+                WorkerQueue &own = queues[worker];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty())
+                {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            for (size_t offset = 1; offset < queues.size(); ++offset)
+            {
+                WorkerQueue &victim = queues[(worker + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool finished() const
+        {
+            return pending.load(std::memory_order_acquire) == 0 || failed.load(std::memory_order_relaxed);
+        }
+
+        // the lock orders the notify after a waiter's check of the predicate, no wakeup is lost
+        void wake(bool all)
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex);
+            if (all)
+            {
+                work_available.notify_all();
+            }
+            else
+            {
+                work_available.notify_one();
+            }
+        }
+
+        void work_loop(size_t worker)
+        {
+            Task task;
+            while (!finished())
+            {
+                if (!take(worker, task))
+                {
+                    std::unique_lock<std::mutex> lock(idle_mutex);
+                    work_available.wait(lock, [this]() { return finished() || queued.load(std::memory_order_acquire) != 0; });
+                    continue;
+                }
+                try
+                {
+                    task(worker);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                    wake(true);
+                }
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    wake(true);
+                }
+            }
+        }
+    };
+
+    // the states reachable from initial_state, breadth-first with successors in symbol name order, edges renumbered
+    // states is indexed by the old ids and is moved from
+    template <typename States>
+    std::vector<lr1_parsing_table_generator_helper::LR1KernelState> reachable_states_in_bfs_order(States &states, uint32_t state_count, uint32_t initial_state)
+    {
+        constexpr uint32_t unreachable = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> new_id(state_count, unreachable);
+        std::vector<uint32_t> order = {initial_state};
+        new_id[initial_state] = 0;
+        std::vector<std::pair<std::string, uint32_t>> successors;
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            successors.clear();
+            for (const auto &successor : states[order[i]].successors)
+            {
+                successors.emplace_back(std::string(successor.first), successor.second);
+            }
+            std::sort(successors.begin(), successors.end());
+            for (const auto &successor : successors)
+            {
+                if (new_id[successor.second] == unreachable)
+                {
+                    new_id[successor.second] = static_cast<uint32_t>(order.size());
+                    order.push_back(successor.second);
+                }
+            }
+        }
+        std::vector<lr1_parsing_table_generator_helper::LR1KernelState> reachable_states;
+        reachable_states.reserve(order.size());
+        for (const auto old_id : order)
+        {
+            lr1_parsing_table_generator_helper::LR1KernelState state = std::move(states[old_id]);
+            for (auto &successor : state.successors)
+            {
+                successor.second = new_id[successor.second];
+            }
+            reachable_states.push_back(std::move(state));
+        }
+        return reachable_states;
+    }
+}
+
+LR1ItemPool::LR1ItemPool() : arena_(std::make_shared<Arena>()), shards_(new Shard[shard_count])
+{
+}
+
+void LR1ItemPool::reset(std::shared_ptr<lr_parsing_model::LookaheadSetTable> lookahead_table)
+{
+    lookahead_table_ = std::move(lookahead_table);
+    production_table_ = nullptr;
+    // items handed out keep the old arena alive
+    arena_ = std::make_shared<Arena>();
+    for (size_t i = 0; i < shard_count; ++i)
+    {
+        shards_[i].handles.clear();
+    }
+}
+
+LR1ItemPool::Handle LR1ItemPool::intern(const lr_parsing_model::Item &item, uint32_t lookahead_set_id)
+{
+    checked_lookahead_table();
+    check_production_table(item);
+    uint64_t key = static_cast<uint64_t>(item.packed) << 32 | lookahead_set_id;
+    // the top bits of a multiplicative hash pick the shard
+    Shard &shard = shards_[(key * 0x9e3779b97f4a7c15ull) >> 60];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.handles.find(key);
+    if (it != shard.handles.end())
+    {
+        return it->second;
+    }
+    // written before the handle is published under the shard lock
+    Handle handle = arena_->allocate();
+    (*arena_)[handle] = lr_parsing_model::LR1Item(item, lookahead_table_, lookahead_set_id);
+    shard.handles.emplace(key, handle);
+    return handle;
+}
+
+LR1ItemPool::Handle LR1ItemPool::intern(const lr_parsing_model::Item &item, const cfg_model::TerminalSet &lookahead_bits)
+{
+    return intern(item, checked_lookahead_table().intern(lookahead_bits));
+}
+
+LR1ItemPool::Handle LR1ItemPool::intern(const lr_parsing_model::LR1Item &item)
+{
+    if (item.lookahead_table == lookahead_table_)
+    {
+        return intern(static_cast<const lr_parsing_model::Item &>(item), item.lookahead_set_id);
+    }
+    return intern(static_cast<const lr_parsing_model::Item &>(item), checked_lookahead_table().intern(item.lookahead_symbols()));
+}
+
+std::shared_ptr<lr_parsing_model::LR1Item> LR1ItemPool::item_ptr(Handle handle) const
+{
+    // aliasing constructor: shares the arena's ownership, no allocation per item
+    return std::shared_ptr<lr_parsing_model::LR1Item>(arena_, &(*arena_)[handle]);
+}
+
+lr_parsing_model::LookaheadSetTable &LR1ItemPool::checked_lookahead_table() const
+{
+    if (lookahead_table_ == nullptr)
+    {
+        throw std::runtime_error("LR1ItemPool has no lookahead set table, reset it for the grammar first");
+    }
+    return *lookahead_table_;
+}
+
+void LR1ItemPool::check_production_table(const lr_parsing_model::Item &item)
+{
+    // cores are only unique within one production table
+    const lr_parsing_model::ProductionTable *expected = nullptr;
+    if (!production_table_.compare_exchange_strong(expected, item.production_table.get()) && expected != item.production_table.get())
+    {
+        throw std::runtime_error("LR1ItemPool got an item of another production table: " + std::string(item));
+    }
+}
 
 lr_parsing_model::ItemSet LR1ParsingTableGenerator::generate_item_set(const cfg_model::CFG &cfg)
 {
     try
     {
-        // Generate the item set
+        // Generate the item set from the reduced grammar
         ItemSetGenerator item_set_generator;
-        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(cfg);
+        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(prepare_cfg(cfg));
 
         return item_set;
     }
@@ -28,22 +298,27 @@ lr_parsing_model::LR1ItemSetDFAGenerationResult LR1ParsingTableGenerator::genera
 {
     try
     {
-        spdlog::debug("Generating item set DFA for LR(1) parsing table...");
+        LAB_LOG_DEBUG("Generating item set DFA for LR(1) parsing table...");
         // preparation: LR(0) item set, blank LR(1) item set, first/follow sets, and an empty DFA
+        // both are built from the reduced grammar
+        cfg_model::CFG reduced_cfg = prepare_cfg(cfg);
+        ItemSetGenerator item_set_generator;
         lr_parsing_model::ItemSet lr0_item_set;
-        lr0_item_set = generate_item_set(cfg);
+        lr0_item_set = item_set_generator.generate_item_set(reduced_cfg);
         // get the expanded cfg
-        cfg_model::CFG expanded_cfg = itemset_generator_helper::expand_cfg(cfg);
-        // generate the blank LR(1) item set from the LR(0) item set
-        lr_parsing_model::ItemSet new_lr1_item_set = lr1_parsing_table_generator_helper::generate_blank_lr1_item_set(lr0_item_set, pool_);
+        cfg_model::CFG expanded_cfg = itemset_generator_helper::expand_cfg(reduced_cfg);
         // generate first and follow sets
         CFGAnalyzer cfg_analyzer(expanded_cfg);
         cfg_analyzer.computeFirstSet();
         cfg_analyzer.computeFollowSet();
-        // get the first and follow sets
-        const cfg_model::FirstSet &first_set = cfg_analyzer.getFirstSet();
-        const cfg_model::FollowSet &follow_set = cfg_analyzer.getFollowSet();
-        dfa_model::DFA<std::string> item_set_dfa;
+        // closure lookaheads are read from the precomputed FIRST of each production suffix
+        cfg_analyzer.computeSuffixFirstSets();
+        // lookahead sets are interned as bitsets over the analyzer's terminal bits
+        pool_.reset(lr1_parsing_table_generator_helper::make_lookahead_set_table(cfg_analyzer));
+        // generate the blank LR(1) item set from the LR(0) item set
+        lr_parsing_model::ItemSet new_lr1_item_set = lr1_parsing_table_generator_helper::generate_blank_lr1_item_set(lr0_item_set, pool_);
+        // the DFA is assembled in bulk and validated once when it is built
+        dfa_model::DFABuilder<std::string> item_set_dfa_builder;
         lr_parsing_model::ItemSetDFAMapping item_set_dfa_mapping;
         // generate the character set for the DFA from the item set symbols
         for (const auto &symbol : new_lr1_item_set.symbol_set)
@@ -51,138 +326,91 @@ lr_parsing_model::LR1ItemSetDFAGenerationResult LR1ParsingTableGenerator::genera
             // generate a unique name for the DFA character
             std::string dfa_character_name = std::string(symbol);
             // check if the character name already exists
-            if (item_set_dfa.character_set.find(dfa_character_name) != item_set_dfa.character_set.end())
+            if (item_set_dfa_builder.find_symbol(dfa_character_name) != dfa_model::DFABuilder<std::string>::invalid_id)
             {
                 std::string error_msg = "Error: DFA character name already exists: " + dfa_character_name;
                 spdlog::error(error_msg);
                 throw std::runtime_error(error_msg);
             }
             // add the character to the DFA
-            item_set_dfa.character_set.insert(dfa_character_name);
+            item_set_dfa_builder.add_symbol(dfa_character_name);
             // add the symbol to the mapping
             item_set_dfa_mapping.item_set_symbol_to_dfa_character[symbol] = dfa_character_name;
             item_set_dfa_mapping.dfa_character_to_item_set_symbol[dfa_character_name] = symbol;
-            spdlog::debug("Generated CFG-DFA character mapping: {} -> {}", symbol.name, dfa_character_name);
+            LAB_LOG_DEBUG("Generated CFG-DFA character mapping: {} -> {}", symbol.name, dfa_character_name);
         }
 
-        spdlog::debug("Generating item set DFA from LR(1) item set...");
+        LAB_LOG_DEBUG("Generating item set DFA from LR(1) item set...");
 
         // generate the item set DFA
-        // generate all closure items
-        std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> initial_items;
-        initial_items.insert(pool_.get_or_create(std::static_pointer_cast<lr_parsing_model::LR1Item>(new_lr1_item_set.start_item)));
-        std::unordered_set<std::string> dfa_states = {};
-        auto initial_closure = lr1_parsing_table_generator_helper::grow_closure(initial_items, lr0_item_set, expanded_cfg, first_set, follow_set, pool_);
-        // generate the initial DFA state name
-        std::string initial_dfa_state_name = lr1_parsing_table_generator_helper::generate_lr1_closure_name(initial_closure);
-        // add the initial state to the DFA
-        item_set_dfa.states_set.insert(initial_dfa_state_name);
-        item_set_dfa.initial_state = initial_dfa_state_name;
-        item_set_dfa.accepting_states.insert(initial_dfa_state_name);
-        // add the initial closure to the mapping
-        for (const auto &item : initial_closure)
-        {
-            item_set_dfa_mapping.item_set_to_dfa_state[item].insert(initial_dfa_state_name);
-            item_set_dfa_mapping.dfa_state_to_item_set[initial_dfa_state_name].insert(item);
-        }
-        dfa_states.insert(initial_dfa_state_name);
-        bool changed = true;
-        while (changed)
-        {
-            changed = false;
-            std::vector<std::string> dfa_states_vec(dfa_states.begin(), dfa_states.end());
-            for (const auto &dfa_state_name : dfa_states_vec)
-            {
-                spdlog::debug("Processing DFA state: {}", dfa_state_name);
-                // restore the closure
-                std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> closure_items;
-                if (item_set_dfa_mapping.dfa_state_to_item_set.find(dfa_state_name) != item_set_dfa_mapping.dfa_state_to_item_set.end())
-                {
-                    auto item_set = item_set_dfa_mapping.dfa_state_to_item_set[dfa_state_name];
-                    for (const auto &item : item_set)
-                    {
-                        closure_items.insert(pool_.get_or_create(std::static_pointer_cast<lr_parsing_model::LR1Item>(item)));
-                    }
-                }
-                else
-                {
-                    spdlog::warn("DFA state {} not found in mapping, skipping...", dfa_state_name);
-                    continue;
-                }
-
-                // for each symbol in the item set, generate the next state and grow the closure(if needed)
-                for (const auto &symbol : new_lr1_item_set.symbol_set)
-                {
-                    spdlog::debug("Processing symbol: {}", std::string(symbol));
-
-                    // check if there is a transition for this symbol in the closure items
-                    auto generation_items = lr1_parsing_table_generator_helper::generate_initial_closure(
-                        closure_items, lr0_item_set, symbol, expanded_cfg, first_set, follow_set, pool_);
-                    if (generation_items.empty())
-                    {
-                        spdlog::debug("No generation items found for symbol: {}", std::string(symbol));
-                        continue; // no items can be generated with this symbol
-                    }
-                    else
-                    {
-                        auto new_closure = lr1_parsing_table_generator_helper::grow_closure(generation_items, lr0_item_set, expanded_cfg, first_set, follow_set, pool_);
-
-                        // generate a unique name for the new DFA state
-                        std::string new_dfa_state_name = lr1_parsing_table_generator_helper::generate_lr1_closure_name(new_closure);
-                        spdlog::debug("Generated new DFA state: {}", new_dfa_state_name);
-                        // check if the new state already exists
-                        if (item_set_dfa.states_set.find(new_dfa_state_name) == item_set_dfa.states_set.end())
-                        {
-                            // add the new state to the DFA
-                            item_set_dfa.states_set.insert(new_dfa_state_name);
-                            dfa_states.insert(new_dfa_state_name);
-                            spdlog::debug("Added new DFA state: {}", new_dfa_state_name);
-                            changed = true; // we have added a new state, so we need to continue processing
-
-                            // add to mapping
-                            for (const auto &item : new_closure)
-                            {
-                                item_set_dfa_mapping.item_set_to_dfa_state[item].insert(new_dfa_state_name);
-                                item_set_dfa_mapping.dfa_state_to_item_set[new_dfa_state_name].insert(item);
-                            }
-
-                            // iterate over the closure for accepting states
-                            if (std::any_of(new_closure.begin(), new_closure.end(),
-                                            [](const std::shared_ptr<lr_parsing_model::LR1Item> &item)
-                                            {
-                                                return item->is_accepting();
-                                            }))
-                            {
-                                item_set_dfa.accepting_states.insert(new_dfa_state_name);
-                                spdlog::debug("New DFA state {} is accepting", new_dfa_state_name);
-                            }
-                            else
-                            {
-                                spdlog::debug("New DFA state {} is not accepting", new_dfa_state_name);
-                            }
-                            spdlog::debug("DFA state {} added with {} items", new_dfa_state_name, new_closure.size());
-                        }
-                        else
-                        {
-                            spdlog::debug("DFA state {} already exists, skipping...", new_dfa_state_name);
-                        }
-                        // even if the state already exists, we still need to add the transition
-                        // add the transition to the DFA
-                        item_set_dfa.add_transition(dfa_state_name, item_set_dfa_mapping.item_set_symbol_to_dfa_character[symbol], new_dfa_state_name);
-                    }
-                }
+        // every state is expanded exactly once from a queue, and only along the symbols that follow a dot in it
+        lr1_parsing_table_generator_helper::LR0ItemIndex lr0_item_index(lr0_item_set);
+        // closing a kernel only instantiates these, no closure runs to a fixpoint of its own
+        lr1_parsing_table_generator_helper::LR1ClosureTemplates closure_templates(lr0_item_index, cfg_analyzer);
+        lr1_parsing_table_generator_helper::LR1ItemHandles initial_items = {
+            pool_.intern(*std::static_pointer_cast<lr_parsing_model::LR1Item>(new_lr1_item_set.start_item))};
+        // register a closure as a new DFA state, returns its id
+        // exploration only passes handles around, the mapping is where items become shared_ptrs
+        uint32_t state_count = 0;
+        auto add_closure_state = [&](const lr1_parsing_table_generator_helper::LR1ItemHandles &closure) {
+            std::string dfa_state_name = lr1_parsing_table_generator_helper::generate_lr1_state_name(state_count++);
+            bool accepting = std::any_of(closure.begin(), closure.end(), [this](LR1ItemPool::Handle handle) {
+                return pool_.item(handle).is_accepting();
+            });
+            uint32_t state_id = item_set_dfa_builder.add_state(dfa_state_name, accepting);
+            for (const auto handle : closure)
+            {
+                std::shared_ptr<lr_parsing_model::LR1Item> item = pool_.item_ptr(handle);
+                item_set_dfa_mapping.item_set_to_dfa_state[item].insert(dfa_state_name);
+                item_set_dfa_mapping.dfa_state_to_item_set[dfa_state_name].insert(item);
+            }
+            LAB_LOG_DEBUG("DFA state {} added with {} items", dfa_state_name, closure.size());
+            return state_id;
+        };
+        last_merge_count = 0;
+        // the automaton is settled first, its states only get names once their ids are final
+        std::vector<lr1_parsing_table_generator_helper::LR1KernelState> explored_states;
+        if (state_merging == StateMerging::PAGER_WEAK_COMPATIBILITY)
+        {
+            explored_states = lr1_parsing_table_generator_helper::explore_merged_states(initial_items, lr0_item_index, closure_templates, pool_, last_merge_count);
+            spdlog::info("LR(1) automaton merged to {} states with {} merges", explored_states.size(), last_merge_count);
+        }
+        else
+        {
+            // canonical states are told apart by their kernels, a closure is only grown for a kernel seen the first time
+            explored_states = lr1_parsing_table_generator_helper::explore_canonical_states(initial_items, lr0_item_index, closure_templates, pool_, thread_count);
+        }
+        std::vector<uint32_t> builder_ids;
+        builder_ids.reserve(explored_states.size());
+        for (auto &explored_state : explored_states)
+        {
+            builder_ids.push_back(add_closure_state(explored_state.closure));
+        }
+        for (size_t i = 0; i < explored_states.size(); ++i)
+        {
+            for (const auto &successor : explored_states[i].successors)
+            {
+                // even if the state already exists, we still need to add the transition
+                item_set_dfa_builder.add_transition(builder_ids[i],
+                                                    item_set_dfa_builder.find_symbol(item_set_dfa_mapping.item_set_symbol_to_dfa_character.at(successor.first)),
+                                                    builder_ids[successor.second]);
             }
         }
-        spdlog::debug("Item set DFA generation completed with {} states, {} accepting states, and {} characters",
+        // the initial state is always marked accepting
+        uint32_t initial_state_id = builder_ids[0];
+        item_set_dfa_builder.set_initial_state(initial_state_id);
+        item_set_dfa_builder.set_accepting(initial_state_id);
+
+        // build & validate the DFA in one pass
+        dfa_model::DFA<std::string> item_set_dfa = item_set_dfa_builder.build();
+        LAB_LOG_DEBUG("Item set DFA generation completed with {} states, {} accepting states, and {} characters",
                       item_set_dfa.states_set.size(), item_set_dfa.accepting_states.size(), item_set_dfa.character_set.size());
-        // check the DFA configuration
-        dfa_model_helper::check_dfa_configuration<std::string>(item_set_dfa);
 
         // !!! flush every item in the mapping to the new item set
         // iterate through each DFA state and find the corresponding LR(1) items in the mapping
         for (const auto &dfa_state : item_set_dfa.states_set)
         {
-            spdlog::debug("Processing DFA state: {}", dfa_state);
+            LAB_LOG_DEBUG("Processing DFA state: {}", dfa_state);
             if (item_set_dfa_mapping.dfa_state_to_item_set.find(dfa_state) != item_set_dfa_mapping.dfa_state_to_item_set.end())
             {
                 auto items = item_set_dfa_mapping.dfa_state_to_item_set[dfa_state];
@@ -200,7 +428,7 @@ lr_parsing_model::LR1ItemSetDFAGenerationResult LR1ParsingTableGenerator::genera
         {
             if (symbol.special_property == "END")
             {
-                spdlog::debug("Found end symbol: {}", std::string(symbol));
+                LAB_LOG_DEBUG("Found end symbol: {}", std::string(symbol));
                 end_symbol = symbol;
                 end_symbol_count++;
             }
@@ -216,12 +444,12 @@ lr_parsing_model::LR1ItemSetDFAGenerationResult LR1ParsingTableGenerator::genera
         for (const auto &item : new_lr1_item_set.items)
         {
             auto lr1_item = std::static_pointer_cast<lr_parsing_model::LR1Item>(item);
-            if (lr1_item->left_side_symbol == new_lr1_item_set.start_item->left_side_symbol && lr1_item->sequence_already_parsed.size() == 1 && lr1_item->sequence_to_parse.empty() && lr1_item->lookahead_symbols.size() == 1 && lr1_item->lookahead_symbols.find(end_symbol) != lr1_item->lookahead_symbols.end())
+            if (lr1_item->left_side_symbol() == new_lr1_item_set.start_item->left_side_symbol() && lr1_item->dot() == 1 && lr1_item->is_accepting() && lr1_item->lookahead_symbols().size() == 1 && lr1_item->lookahead_symbols().count(end_symbol) != 0)
             {
                 // this is the end item
                 new_lr1_item_set.end_item = pool_.get_or_create(lr1_item);
                 end_item_count++;
-                spdlog::debug("Found end item: {}", std::string(*new_lr1_item_set.end_item));
+                LAB_LOG_DEBUG("Found end item: {}", std::string(*new_lr1_item_set.end_item));
             }
         }
         if (end_item_count != 1)
@@ -236,7 +464,7 @@ lr_parsing_model::LR1ItemSetDFAGenerationResult LR1ParsingTableGenerator::genera
         result.dfa = item_set_dfa;
         result.item_set_dfa_mapping = item_set_dfa_mapping;
         result.lr1_item_set = new_lr1_item_set;
-        spdlog::debug("Returning item set DFA generation result");
+        LAB_LOG_DEBUG("Returning item set DFA generation result");
         return result;
     }
     catch (const std::exception &e)
@@ -251,225 +479,242 @@ lr_parsing_model::LRParsingTable LR1ParsingTableGenerator::generate_parsing_tabl
 {
     try
     {
-        spdlog::debug("Generating LR(1) parsing table for CFG: {}", cfg.start_symbol.name);
+        LAB_LOG_DEBUG("Generating LR(1) parsing table for CFG: {}", cfg.start_symbol.name);
         // generate the item set DFA
         lr_parsing_model::LR1ItemSetDFAGenerationResult item_set_dfa_result = generate_item_set_dfa(cfg);
 
-        dfa_model::DFA<std::string> dfa = item_set_dfa_result.dfa;
-        lr_parsing_model::ItemSetDFAMapping item_set_dfa_mapping = item_set_dfa_result.item_set_dfa_mapping;
-        lr_parsing_model::ItemSet lr1_item_set = item_set_dfa_result.lr1_item_set;
+        return lr1_parsing_table_generator_helper::build_parsing_table(item_set_dfa_result);
+    }
+    catch (const std::exception &e)
+    {
+        std::string error_msg = "Error generating parsing table: " + std::string(e.what());
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
 
-        // build the parsing table
-        lr_parsing_model::LRParsingTable new_parsing_table;
-        // 1. add all symbols from the ItemSet and all states from the DFA to the parsing table
-        for (const auto &symbol : lr1_item_set.symbol_set)
-        {
-            new_parsing_table.all_symbols.insert(symbol);
-        }
-        for (const auto &state : dfa.states_set)
+// helper functions
+namespace lr1_parsing_table_generator_helper
+{
+    lr_parsing_model::LRParsingTable build_parsing_table(const lr_parsing_model::LR1ItemSetDFAGenerationResult &item_set_dfa_result)
+    {
+        try
         {
-            new_parsing_table.all_states.insert(state);
-        }
-        // 2. find all shift actions and goto states
-        int added_shift_actions = 0;
-        int added_goto_states = 0;
+            dfa_model::DFA<std::string> dfa = item_set_dfa_result.dfa;
+            lr_parsing_model::ItemSetDFAMapping item_set_dfa_mapping = item_set_dfa_result.item_set_dfa_mapping;
+            lr_parsing_model::ItemSet lr1_item_set = item_set_dfa_result.lr1_item_set;
 
-        for (const auto &state_transitions : dfa.transitions)
-        {
-            const std::string &state = state_transitions.first;
-            const auto &transitions = state_transitions.second;
-            // iterate over all transitions for the current state
-            for (const auto &transition : transitions)
+            // build the parsing table
+            lr_parsing_model::LRParsingTable new_parsing_table;
+            // 1. add all symbols from the ItemSet and all states from the DFA to the parsing table
+            for (const auto &symbol : lr1_item_set.symbol_set)
+            {
+                new_parsing_table.all_symbols.insert(symbol);
+            }
+            for (const auto &state : dfa.states_set)
             {
+                new_parsing_table.all_states.insert(state);
+            }
+            // 2. find all shift actions and goto states
+            int added_shift_actions = 0;
+            int added_goto_states = 0;
 
-                std::string input_char = transition.first;
-                std::string next_state = transition.second;
-                spdlog::debug("Processing transition: {} --{}--> {}", state, input_char, next_state);
-                cfg_model::symbol corresponding_symbol = item_set_dfa_mapping.dfa_character_to_item_set_symbol.at(input_char);
-                // get all the items in the next state
-                auto items_in_next_state = item_set_dfa_mapping.dfa_state_to_item_set.at(next_state);
-                spdlog::debug("Item number in next state for this transition: {}", items_in_next_state.size());
-                // iterate over all items in the next state
-                for (const auto &item : items_in_next_state)
+            for (const auto &state_transitions : dfa.transitions)
+            {
+                const std::string &state = state_transitions.first;
+                const auto &transitions = state_transitions.second;
+                // iterate over all transitions for the current state
+                for (const auto &transition : transitions)
                 {
-                    // for terminal symbols, add a shift action
-                    if (corresponding_symbol.is_terminal)
-                    {
-                        lr_parsing_model::Action shift_action;
-                        shift_action.action_type = "shift";
-                        shift_action.target_state = next_state;
-                        // add the action to the parsing table
-                        bool added = new_parsing_table.add_action(state, corresponding_symbol, shift_action);
-                        if (added)
-                            added_shift_actions++;
-                    }
-                    // for non-terminals, always add a goto state
-                    else
+
+                    std::string input_char = transition.first;
+                    std::string next_state = transition.second;
+                    LAB_LOG_DEBUG("Processing transition: {} --{}--> {}", state, input_char, next_state);
+                    cfg_model::symbol corresponding_symbol = item_set_dfa_mapping.dfa_character_to_item_set_symbol.at(input_char);
+                    // get all the items in the next state
+                    auto items_in_next_state = item_set_dfa_mapping.dfa_state_to_item_set.at(next_state);
+                    LAB_LOG_DEBUG("Item number in next state for this transition: {}", items_in_next_state.size());
+                    // iterate over all items in the next state
+                    for (const auto &item : items_in_next_state)
                     {
-                        // add a goto state
-                        bool added = new_parsing_table.add_goto(state, corresponding_symbol, next_state);
-                        if (added)
-                            added_goto_states++;
+                        // for terminal symbols, add a shift action
+                        if (corresponding_symbol.is_terminal)
+                        {
+                            lr_parsing_model::Action shift_action;
+                            shift_action.action_type = "shift";
+                            shift_action.target_state = next_state;
+                            // add the action to the parsing table
+                            bool added = new_parsing_table.add_action(state, corresponding_symbol, shift_action);
+                            if (added)
+                                added_shift_actions++;
+                        }
+                        // for non-terminals, always add a goto state
+                        else
+                        {
+                            // add a goto state
+                            bool added = new_parsing_table.add_goto(state, corresponding_symbol, next_state);
+                            if (added)
+                                added_goto_states++;
+                        }
                     }
                 }
             }
-        }
-        spdlog::debug("Added {} shift actions and {} goto states to the parsing table", added_shift_actions, added_goto_states);
-        // 3. find all reduce actions
-        // iterate over all accepting states in the DFA
-        int added_reduce_actions = 0;
-        for (const auto &accepting_state : dfa.accepting_states)
-        {
-            // get all items in the accepting state
-            auto items_in_accepting_state = item_set_dfa_mapping.dfa_state_to_item_set.at(accepting_state);
-            // iterate over all items in the accepting state
-            for (const auto &item : items_in_accepting_state)
+            LAB_LOG_DEBUG("Added {} shift actions and {} goto states to the parsing table", added_shift_actions, added_goto_states);
+            // 3. find all reduce actions
+            // iterate over all accepting states in the DFA
+            int added_reduce_actions = 0;
+            for (const auto &accepting_state : dfa.accepting_states)
             {
-                // check if the item is an accepting state and not the end item
-                // !!! IMPORTANT: THIS IS LR1 ANALYSIS, SO WE NEED TO CHECK THE LOOKAHEAD SYMBOLS
-                auto lr1_item = std::static_pointer_cast<lr_parsing_model::LR1Item>(item);
-                if (item->sequence_to_parse.empty() && item != lr1_item_set.end_item)
+                // get all items in the accepting state
+                auto items_in_accepting_state = item_set_dfa_mapping.dfa_state_to_item_set.at(accepting_state);
+                // iterate over all items in the accepting state
+                for (const auto &item : items_in_accepting_state)
                 {
-                    // create a reduce action
-                    lr_parsing_model::Action reduce_action;
-                    reduce_action.action_type = "reduce";
-                    reduce_action.reduce_rule_lhs = item->left_side_symbol;
-                    reduce_action.reduce_rule_rhs = item->sequence_already_parsed;
-                    // add the action to the parsing table for all symbols
-                    for (const auto &symbol : lr1_item_set.symbol_set)
+                    // check if the item is an accepting state and not the end item
+                    // !!! IMPORTANT: THIS IS LR1 ANALYSIS, SO WE NEED TO CHECK THE LOOKAHEAD SYMBOLS
+                    auto lr1_item = std::static_pointer_cast<lr_parsing_model::LR1Item>(item);
+                    if (item->sequence_to_parse().empty() && item != lr1_item_set.end_item)
                     {
-                        // add the action to the parsing if the symbol is a terminal
-                        // !!! AND the lookahead symbol is in the lookahead set of the item
-                        if (symbol.is_terminal && lr1_item->lookahead_symbols.find(symbol) != lr1_item->lookahead_symbols.end())
+                        // create a reduce action
+                        lr_parsing_model::Action reduce_action;
+                        reduce_action.action_type = "reduce";
+                        reduce_action.reduce_production = item->production_id();
+                        // add the action to the parsing table for all symbols
+                        for (const auto &symbol : lr1_item_set.symbol_set)
                         {
-                            // add the action to the parsing table
-                            bool added = new_parsing_table.add_action(accepting_state, symbol, reduce_action);
-                            if (added)
+                            // add the action to the parsing if the symbol is a terminal
+                            // !!! AND the lookahead symbol is in the lookahead set of the item
+                            if (symbol.is_terminal && lr1_item->lookahead_symbols().count(symbol) != 0)
                             {
-                                added_reduce_actions++;
+                                // add the action to the parsing table
+                                bool added = new_parsing_table.add_action(accepting_state, symbol, reduce_action);
+                                if (added)
+                                {
+                                    added_reduce_actions++;
+                                }
                             }
                         }
                     }
                 }
             }
-        }
-        spdlog::debug("Added {} reduce actions to the parsing table", added_reduce_actions);
-        // 4. find the accept action
-        // get the end item from the item set and find the corresponding state
-        auto end_item = lr1_item_set.end_item;
-        std::unordered_set<std::string> end_item_states;
-        end_item_states = item_set_dfa_mapping.item_set_to_dfa_state.at(end_item);
-        std::string end_item_state = "";
-        // there should be only one end item state
-        if (end_item_states.size() != 1)
-        {
-            std::string error_msg = "Error: End item state not found or multiple end item states found";
-            spdlog::error(error_msg);
-            throw std::runtime_error(error_msg);
-        }
-        else
-        {
-            end_item_state = *end_item_states.begin();
-        }
-        // get the end symbol
-        cfg_model::symbol end_symbol;
-        int end_symbol_count = 0;
-        for (const auto &symbol : lr1_item_set.symbol_set)
-        {
-            if (symbol.special_property == "END")
+            LAB_LOG_DEBUG("Added {} reduce actions to the parsing table", added_reduce_actions);
+            // 4. find the accept action
+            // get the end item from the item set and find the corresponding state
+            auto end_item = lr1_item_set.end_item;
+            std::unordered_set<std::string> end_item_states;
+            end_item_states = item_set_dfa_mapping.item_set_to_dfa_state.at(end_item);
+            std::string end_item_state = "";
+            // there should be only one end item state
+            if (end_item_states.size() != 1)
             {
-                spdlog::debug("Found end symbol: {}", std::string(symbol));
-                end_symbol = symbol;
-                end_symbol_count++;
+                std::string error_msg = "Error: End item state not found or multiple end item states found";
+                spdlog::error(error_msg);
+                throw std::runtime_error(error_msg);
             }
-        }
-        if (end_symbol_count != 1)
-        {
-            std::string error_msg = "Error: End symbol not found or multiple end symbols found";
-            spdlog::error(error_msg);
-            throw std::runtime_error(error_msg);
-        }
-        // create an accept action
-        lr_parsing_model::Action accept_action;
-        accept_action.action_type = "accept";
-        new_parsing_table.add_action(end_item_state, end_symbol, accept_action);
-        spdlog::debug("Added accept action for state {} and symbol {}", end_item_state, std::string(end_symbol));
-        // 5. fill all the empty cells in the parsing table with empty actions
-        int patched_cells = 0;
-        for (const auto &state : dfa.states_set)
-        {
+            else
+            {
+                end_item_state = *end_item_states.begin();
+            }
+            // get the end symbol
+            cfg_model::symbol end_symbol;
+            int end_symbol_count = 0;
             for (const auto &symbol : lr1_item_set.symbol_set)
             {
-                // check if the cell is empty
-                if (new_parsing_table.check_cell_empty(state, symbol))
+                if (symbol.special_property == "END")
                 {
-                    // check if the symbol is a terminal or non-terminal
-                    if (!symbol.is_terminal)
-                    {
-                        // fill in the goto state with an empty string
-                        std::string next_state = "";
-                        bool added = new_parsing_table.add_goto(state, symbol, next_state);
-                        if (added)
-                            patched_cells++;
-                    }
-                    else
+                    LAB_LOG_DEBUG("Found end symbol: {}", std::string(symbol));
+                    end_symbol = symbol;
+                    end_symbol_count++;
+                }
+            }
+            if (end_symbol_count != 1)
+            {
+                std::string error_msg = "Error: End symbol not found or multiple end symbols found";
+                spdlog::error(error_msg);
+                throw std::runtime_error(error_msg);
+            }
+            // create an accept action
+            lr_parsing_model::Action accept_action;
+            accept_action.action_type = "accept";
+            new_parsing_table.add_action(end_item_state, end_symbol, accept_action);
+            LAB_LOG_DEBUG("Added accept action for state {} and symbol {}", end_item_state, std::string(end_symbol));
+            // 5. fill all the empty cells in the parsing table with empty actions
+            int patched_cells = 0;
+            for (const auto &state : dfa.states_set)
+            {
+                for (const auto &symbol : lr1_item_set.symbol_set)
+                {
+                    // check if the cell is empty
+                    if (new_parsing_table.check_cell_empty(state, symbol))
                     {
-                        // fill in the action with an empty action
-                        lr_parsing_model::Action empty_action;
-                        empty_action.action_type = "empty";
-                        bool added = new_parsing_table.add_action(state, symbol, empty_action);
-                        if (added)
-                            patched_cells++;
+                        // check if the symbol is a terminal or non-terminal
+                        if (!symbol.is_terminal)
+                        {
+                            // fill in the goto state with an empty string
+                            std::string next_state = "";
+                            bool added = new_parsing_table.add_goto(state, symbol, next_state);
+                            if (added)
+                                patched_cells++;
+                        }
+                        else
+                        {
+                            // fill in the action with an empty action
+                            lr_parsing_model::Action empty_action;
+                            empty_action.action_type = "empty";
+                            bool added = new_parsing_table.add_action(state, symbol, empty_action);
+                            if (added)
+                                patched_cells++;
+                        }
                     }
                 }
             }
+            LAB_LOG_DEBUG("Patched {} empty cells in the parsing table", patched_cells);
+            // 6. find the start state and append to the parsing table
+            // the start state is the state that corresponds to the start item in the item set
+            std::unordered_set<std::string> start_item_states;
+            start_item_states = item_set_dfa_mapping.item_set_to_dfa_state.at(lr1_item_set.start_item);
+            // there should be only one start item state, otherwise, it's an error
+            if (start_item_states.size() != 1)
+            {
+                std::string error_msg = "Error: Start item state not found or multiple start item states found";
+                spdlog::error(error_msg);
+                throw std::runtime_error(error_msg);
+            }
+            std::string start_item_state = *start_item_states.begin();
+            // add the start state to the parsing table
+            new_parsing_table.start_state = start_item_state;
+            new_parsing_table.production_table = lr1_item_set.production_table;
+            LAB_LOG_DEBUG("Start state of the parsing table: {}", start_item_state);
+            // 7. return the parsing table & update the class member variable
+            LAB_LOG_DEBUG("Parsing table built successfully, with {} states and {} symbols", new_parsing_table.all_states.size(), new_parsing_table.all_symbols.size());
+            if (LAB_LOG_DEBUG_ENABLED())
+            {
+                for (const auto &state : new_parsing_table.all_states)
+                {
+                    LAB_LOG_DEBUG("State: {}", state);
+                }
+                for (const auto &symbol : new_parsing_table.all_symbols)
+                {
+                    LAB_LOG_DEBUG("Symbol: {}", symbol.name);
+                }
+            }
+
+            // Last step: resolve the conflicts in the action table
+            // generate itemset-parsing table mapping
+            lr_parsing_model::ItemSetParsingTableMapping item_set_parsing_table_mapping;
+            item_set_parsing_table_mapping = generate_item_set_parsing_table_mapping(
+                new_parsing_table, lr1_item_set, item_set_dfa_mapping);
+
+            return resolve_conflicts(new_parsing_table, item_set_parsing_table_mapping);
         }
-        spdlog::debug("Patched {} empty cells in the parsing table", patched_cells);
-        // 6. find the start state and append to the parsing table
-        // the start state is the state that corresponds to the start item in the item set
-        std::unordered_set<std::string> start_item_states;
-        start_item_states = item_set_dfa_mapping.item_set_to_dfa_state.at(lr1_item_set.start_item);
-        // there should be only one start item state, otherwise, it's an error
-        if (start_item_states.size() != 1)
+        catch (const std::exception &e)
         {
-            std::string error_msg = "Error: Start item state not found or multiple start item states found";
+            std::string error_msg = "Error building LR(1) parsing table: " + std::string(e.what());
             spdlog::error(error_msg);
             throw std::runtime_error(error_msg);
         }
-        std::string start_item_state = *start_item_states.begin();
-        // add the start state to the parsing table
-        new_parsing_table.start_state = start_item_state;
-        spdlog::debug("Start state of the parsing table: {}", start_item_state);
-        // 7. return the parsing table & update the class member variable
-        spdlog::debug("Parsing table built successfully, with {} states and {} symbols", new_parsing_table.all_states.size(), new_parsing_table.all_symbols.size());
-        for (const auto &state : new_parsing_table.all_states)
-        {
-            spdlog::debug("State: {}", state);
-        }
-        for (const auto &symbol : new_parsing_table.all_symbols)
-        {
-            spdlog::debug("Symbol: {}", symbol.name);
-        }
-
-        // Last step: resolve the conflicts in the action table
-        // generate itemset-parsing table mapping
-        lr_parsing_model::ItemSetParsingTableMapping item_set_parsing_table_mapping;
-        item_set_parsing_table_mapping = lr1_parsing_table_generator_helper::generate_item_set_parsing_table_mapping(
-            new_parsing_table, lr1_item_set, item_set_dfa_mapping);
-
-        return lr1_parsing_table_generator_helper::resolve_conflicts(new_parsing_table, item_set_parsing_table_mapping);
-    }
-    catch (const std::exception &e)
-    {
-        std::string error_msg = "Error generating parsing table: " + std::string(e.what());
-        spdlog::error(error_msg);
-        throw std::runtime_error(error_msg);
     }
-}
 
-// helper functions
-namespace lr1_parsing_table_generator_helper
-{
     lr_parsing_model::ItemSet generate_blank_lr1_item_set(const lr_parsing_model::ItemSet &item_set, LR1ItemPool &pool)
     {
         try
@@ -482,7 +727,7 @@ namespace lr1_parsing_table_generator_helper
             {
                 if (symbol.special_property == "END")
                 {
-                    spdlog::debug("Found end symbol: {}", std::string(symbol));
+                    LAB_LOG_DEBUG("Found end symbol: {}", std::string(symbol));
                     end_symbol = symbol;
                     end_symbol_count++;
                 }
@@ -497,16 +742,17 @@ namespace lr1_parsing_table_generator_helper
                 throw std::runtime_error(error_msg);
             }
             auto start_item = pool.get_or_create(*item_set.start_item, end_symbol);
-            spdlog::debug("Generated start item: {}", std::string(*start_item));
+            LAB_LOG_DEBUG("Generated start item: {}", std::string(*start_item));
             auto end_item = pool.get_or_create(*item_set.end_item, end_symbol);
-            spdlog::debug("Generated end item: {}", std::string(*end_item));
+            LAB_LOG_DEBUG("Generated end item: {}", std::string(*end_item));
             blank_lr1_item_set.start_item = start_item;
             blank_lr1_item_set.end_item = end_item;
             blank_lr1_item_set.items.insert(start_item);
             // NOT adding the end item to the items set, this will be handled later and have checking purpose
-            // copy the symbol set from the original item set
+            // copy the symbol set and the productions from the original item set
             blank_lr1_item_set.symbol_set = item_set.symbol_set;
-            spdlog::debug("Generated blank LR(1) item set with start item: {}, end item: {}, and {} symbols",
+            blank_lr1_item_set.production_table = item_set.production_table;
+            LAB_LOG_DEBUG("Generated blank LR(1) item set with start item: {}, end item: {}, and {} symbols",
                           std::string(*start_item), std::string(*end_item), blank_lr1_item_set.symbol_set.size());
             return blank_lr1_item_set;
         }
@@ -518,103 +764,569 @@ namespace lr1_parsing_table_generator_helper
         }
     }
 
+    LR0ItemIndex::LR0ItemIndex(const lr_parsing_model::ItemSet &lr0_item_set)
+    {
+        items_by_content.reserve(lr0_item_set.items.size());
+        for (const auto &item : lr0_item_set.items)
+        {
+            items_by_content.emplace(*item, item);
+            ids_by_content.emplace(*item, static_cast<uint32_t>(ids_by_content.size()));
+            if (item->sequence_already_parsed().empty())
+            {
+                initial_items_by_lhs[item->left_side_symbol()].push_back(item);
+            }
+        }
+    }
+
+    uint32_t LR0ItemIndex::item_id(const lr_parsing_model::Item &item) const
+    {
+        auto it = ids_by_content.find(item);
+        if (it == ids_by_content.end())
+        {
+            throw std::runtime_error("Item not found in reference item set: " + std::string(item));
+        }
+        return it->second;
+    }
+
+    std::shared_ptr<lr_parsing_model::LookaheadSetTable> make_lookahead_set_table(const CFGAnalyzer &cfg_analyzer)
+    {
+        std::vector<cfg_model::symbol> terminals;
+        terminals.reserve(cfg_analyzer.getTerminalCount());
+        for (size_t bit = 0; bit < cfg_analyzer.getTerminalCount(); ++bit)
+        {
+            terminals.push_back(cfg_analyzer.getTerminalOfBit(bit));
+        }
+        return std::make_shared<lr_parsing_model::LookaheadSetTable>(std::move(terminals));
+    }
+
+    LR1KernelKey make_kernel_key(const LR1ItemHandles &kernel)
+    {
+        LR1KernelKey key;
+        key.items = kernel;
+        size_t seed = key.items.size();
+        for (const auto handle : key.items)
+        {
+            seed ^= static_cast<size_t>(handle) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        key.hash = seed;
+        return key;
+    }
+
+    const std::vector<std::shared_ptr<lr_parsing_model::Item>> &LR0ItemIndex::initial_items(const cfg_model::symbol &lhs) const
+    {
+        static const std::vector<std::shared_ptr<lr_parsing_model::Item>> no_items;
+        auto it = initial_items_by_lhs.find(lhs);
+        return it == initial_items_by_lhs.end() ? no_items : it->second;
+    }
+
+    const std::shared_ptr<lr_parsing_model::Item> &LR0ItemIndex::advance(const lr_parsing_model::Item &item) const
+    {
+        lr_parsing_model::Item next_item = item.advanced();
+        auto it = items_by_content.find(next_item);
+        if (it == items_by_content.end())
+        {
+            throw std::runtime_error("Next item not found in reference item set: " + std::string(next_item));
+        }
+        return it->second;
+    }
+
     // generate a set of LR(1) items from an LR(0) item and their lookahead symbols
     std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> grow_closure(
         const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &initial_items,
         const lr_parsing_model::ItemSet &reference_lr0_item_set,
-        const cfg_model::CFG &cfg,
-        const cfg_model::FirstSet &first_set,
-        const cfg_model::FollowSet &follow_set,
+        const CFGAnalyzer &cfg_analyzer,
         LR1ItemPool &pool)
+    {
+        return grow_closure(initial_items, LR0ItemIndex(reference_lr0_item_set), cfg_analyzer, pool);
+    }
+
+    std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> grow_closure(
+        const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &initial_items,
+        const LR0ItemIndex &lr0_item_index,
+        const CFGAnalyzer &cfg_analyzer,
+        LR1ItemPool &pool)
+    {
+        return grow_closure(initial_items, LR1ClosureTemplates(lr0_item_index, cfg_analyzer), pool);
+    }
+
+    LR1ClosureTemplates::LR1ClosureTemplates(const LR0ItemIndex &lr0_item_index, const CFGAnalyzer &cfg_analyzer)
+        : terminal_count(cfg_analyzer.getTerminalCount())
     {
         try
         {
-            std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> closure_items = initial_items;
-            // start the closure process
-            bool changed = true;
-            while (changed)
+            // 1. the rule of every item with a non-terminal after its dot, templates are numbered as they are met
+            for (const auto &item_entry : lr0_item_index.items_by_content)
             {
-                changed = false;
-                int previous_size = closure_items.size();
-                std::vector<std::shared_ptr<lr_parsing_model::LR1Item>> closure_vec(closure_items.begin(), closure_items.end());
-                for (const auto &item : closure_vec)
+                const lr_parsing_model::Item &item = *item_entry.second;
+                if (item.is_accepting() || item.sequence_to_parse()[0].is_terminal)
                 {
-                    // prepare the lookahead symbols of the items to be generated
-                    std::unordered_set<cfg_model::symbol> lookahead_symbols;
-                    // 1. if the item is accepting(or complete), or the next symbol is terminal, skip it as it won't generate new items
-                    if (item->is_accepting())
+                    continue;
+                }
+                const lr_parsing_model::Production &production = item.production();
+                uint32_t production_index = cfg_analyzer.getProductionIndex(production.lhs, production.rhs);
+                if (production_index == cfg_model::invalid_symbol_id)
+                {
+                    throw std::runtime_error("Item does not belong to any production: " + std::string(item));
+                }
+                size_t beta_start = item.dot() + 1;
+                auto template_id = template_ids.emplace(item.sequence_to_parse()[0], static_cast<uint32_t>(template_ids.size())).first->second;
+                rules_by_core.emplace(item.packed, ItemRule{template_id,
+                                                            cfg_analyzer.getSuffixFirst(production_index, beta_start),
+                                                            cfg_analyzer.isSuffixNullable(production_index, beta_start)});
+            }
+
+            // 2. the closure of each non-terminal B, starting from B -> · γ with no spontaneous lookaheads, propagated
+            //    an item A -> α · C β of the closure passes FIRST(β) on to C -> · δ as spontaneous lookaheads,
+            //    and if β =>* ε its own spontaneous lookaheads and whether it propagates as well
+            templates.resize(template_ids.size());
+            for (const auto &template_entry : template_ids)
+            {
+                std::vector<Entry> &entries = templates[template_entry.second];
+                std::unordered_map<uint32_t, size_t> entry_by_core;
+                std::vector<size_t> worklist;
+                auto add_core = [&](const std::shared_ptr<lr_parsing_model::Item> &core, const cfg_model::TerminalSet &spontaneous, bool propagated) {
+                    auto inserted = entry_by_core.emplace(core->packed, entries.size());
+                    if (inserted.second)
                     {
-                        continue;
+                        entries.push_back(Entry{core, spontaneous, propagated});
+                        worklist.push_back(inserted.first->second);
+                        return;
                     }
-                    else if (item->sequence_to_parse[0].is_terminal)
+                    Entry &entry = entries[inserted.first->second];
+                    bool grown = entry.spontaneous.union_with(spontaneous);
+                    if (propagated && !entry.propagated)
+                    {
+                        entry.propagated = true;
+                        grown = true;
+                    }
+                    if (grown)
+                    {
+                        worklist.push_back(inserted.first->second);
+                    }
+                };
+                for (const auto &initial_item : lr0_item_index.initial_items(template_entry.first))
+                {
+                    add_core(initial_item, cfg_model::TerminalSet(terminal_count), true);
+                }
+                cfg_model::TerminalSet spontaneous(terminal_count);
+                while (!worklist.empty())
+                {
+                    size_t entry_index = worklist.back();
+                    worklist.pop_back();
+                    const ItemRule *item_rule = rule(*entries[entry_index].core);
+                    if (item_rule == nullptr)
                     {
                         continue;
                     }
-                    // 2. if the next symbol is the last one in the sequence to parse, inherit the lookahead symbols from the item
-                    if (item->sequence_to_parse.size() == 1)
+                    spontaneous = item_rule->first_of_rest;
+                    bool propagated = false;
+                    if (item_rule->rest_nullable)
                     {
-                        lookahead_symbols = item->lookahead_symbols;
+                        spontaneous.union_with(entries[entry_index].spontaneous);
+                        propagated = entries[entry_index].propagated;
                     }
-                    else
+                    const lr_parsing_model::Item &item = *entries[entry_index].core;
+                    for (const auto &next_item : lr0_item_index.initial_items(item.sequence_to_parse()[0]))
                     {
-                        cfg_model::symbol next_symbol_to_parse = item->sequence_to_parse[0];
-                        cfg_model::symbol lookup_generation_symbol = item->sequence_to_parse[1];
+                        // entries may be reallocated by add_core, nothing of them is held across it
+                        add_core(next_item, spontaneous, propagated);
+                    }
+                }
+                LAB_LOG_DEBUG("Closure template of {} has {} items", template_entry.first.name, entries.size());
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_message = "Error generating closure templates: ";
+            error_message += e.what();
+            spdlog::error(error_message);
+            throw std::runtime_error(error_message);
+        }
+    }
 
-                        // get the first set of lookup_generation_symbol, also check if it has epsilon
-                        if (first_set.first_set.find(lookup_generation_symbol) != first_set.first_set.end())
-                        {
-                            auto first_set_symbols = first_set.first_set.at(lookup_generation_symbol);
-                            // if the first set size is 0, check if it has epsilon
-                            if (first_set_symbols.size() == 0 && first_set.symbols_with_epsilon.find(lookup_generation_symbol) != first_set.symbols_with_epsilon.end())
-                            {
-                                // this is a pure epsilon, inherit the lookahead symbols from the item
-                                lookahead_symbols = item->lookahead_symbols;
-                                spdlog::debug("Inheriting lookahead symbols from item: {}", std::string(*item));
-                            }
-                            else
-                            {
-                                // otherwise, add the first set symbols to the lookahead symbols
-                                lookahead_symbols.insert(first_set_symbols.begin(), first_set_symbols.end());
-                            }
-                        }
+    const LR1ClosureTemplates::ItemRule *LR1ClosureTemplates::rule(const lr_parsing_model::Item &item) const
+    {
+        auto it = rules_by_core.find(item.packed);
+        return it == rules_by_core.end() ? nullptr : &it->second;
+    }
+
+    const std::vector<LR1ClosureTemplates::Entry> &LR1ClosureTemplates::closure_template(const cfg_model::symbol &non_terminal) const
+    {
+        static const std::vector<Entry> no_entries;
+        auto it = template_ids.find(non_terminal);
+        return it == template_ids.end() ? no_entries : templates[it->second];
+    }
+
+    std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> grow_closure(
+        const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &initial_items,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool &pool)
+    {
+        LR1ItemHandles kernel;
+        kernel.reserve(initial_items.size());
+        for (const auto &item : initial_items)
+        {
+            kernel.push_back(pool.intern(*item));
+        }
+        std::sort(kernel.begin(), kernel.end());
+        std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> closure_items;
+        for (const auto handle : grow_closure(kernel, closure_templates, pool))
+        {
+            closure_items.insert(pool.item_ptr(handle));
+        }
+        return closure_items;
+    }
+
+    LR1ItemHandles grow_closure(
+        const LR1ItemHandles &kernel,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool &pool)
+    {
+        try
+        {
+            const std::shared_ptr<lr_parsing_model::LookaheadSetTable> &lookahead_table = pool.get_lookahead_table();
+            if (lookahead_table == nullptr || lookahead_table->get_terminals().size() != closure_templates.terminal_count)
+            {
+                throw std::runtime_error("The item pool's lookahead sets do not match the analyzer's terminals");
+            }
+            // one entry per LR(0) core, keyed by the packed core, lookaheads of a core are united
+            std::unordered_map<uint32_t, std::pair<const lr_parsing_model::Item *, cfg_model::TerminalSet>> lookaheads_by_core;
+            auto add_core = [&](const lr_parsing_model::Item &core, const cfg_model::TerminalSet &lookahead_bits) {
+                auto inserted = lookaheads_by_core.emplace(core.packed, std::make_pair(&core, lookahead_bits));
+                if (!inserted.second)
+                {
+                    inserted.first->second.second.union_with(lookahead_bits);
+                }
+            };
+            // 1. the kernel items themselves, and the lookaheads each template is introduced with
+            std::unordered_map<uint32_t, cfg_model::TerminalSet> introduced_lookaheads;
+            for (const auto handle : kernel)
+            {
+                const lr_parsing_model::LR1Item &item = pool.item(handle);
+                add_core(item, item.lookahead_bits());
+                const LR1ClosureTemplates::ItemRule *rule = closure_templates.rule(item);
+                if (rule == nullptr)
+                {
+                    continue;
+                }
+                auto inserted = introduced_lookaheads.emplace(rule->template_id, rule->first_of_rest);
+                if (!inserted.second)
+                {
+                    inserted.first->second.union_with(rule->first_of_rest);
+                }
+                if (rule->rest_nullable)
+                {
+                    inserted.first->second.union_with(item.lookahead_bits());
+                }
+            }
+            // 2. each template once: spontaneous lookaheads, plus the introduced ones where they propagate
+            cfg_model::TerminalSet lookahead_bits(closure_templates.terminal_count);
+            for (const auto &introduced : introduced_lookaheads)
+            {
+                for (const auto &entry : closure_templates.templates[introduced.first])
+                {
+                    if (!entry.propagated)
+                    {
+                        add_core(*entry.core, entry.spontaneous);
+                        continue;
                     }
+                    lookahead_bits = entry.spontaneous;
+                    lookahead_bits.union_with(introduced.second);
+                    add_core(*entry.core, lookahead_bits);
+                }
+            }
+
+            LR1ItemHandles closure;
+            closure.reserve(lookaheads_by_core.size());
+            for (const auto &core_entry : lookaheads_by_core)
+            {
+                closure.push_back(pool.intern(*core_entry.second.first, core_entry.second.second));
+            }
+            std::sort(closure.begin(), closure.end());
 
-                    // 2. generate the next item from the current item
-                    std::unordered_set<std::shared_ptr<lr_parsing_model::Item>> next_items = reference_lr0_item_set.get_generation_items(item->sequence_to_parse[0]);
+            LAB_LOG_DEBUG("Closure generation completed, total items: {}", closure.size());
+            // document the closure items
+            if (LAB_LOG_DEBUG_ENABLED())
+            {
+                LAB_LOG_DEBUG("Closure items:");
+                for (const auto handle : closure)
+                {
+                    LAB_LOG_DEBUG("{}", std::string(pool.item(handle)));
+                }
+            }
+            return closure;
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_message = "Error generating closure: ";
+            error_message += e.what();
+            spdlog::error(error_message);
+            throw std::runtime_error(error_message);
+        }
+    }
 
-                    // 3. for each next item, create a new LR(1) item with the lookahead symbols and append it to the closure items
-                    for (const auto &next_item : next_items)
+    std::unordered_map<cfg_model::symbol, LR1ItemHandles> generate_goto_kernels(
+        const LR1ItemHandles &closure,
+        const LR0ItemIndex &lr0_item_index,
+        LR1ItemPool &pool)
+    {
+        try
+        {
+            // symbol -> advanced core -> united lookaheads, closures are core-merged already but their callers may not be
+            std::unordered_map<cfg_model::symbol, std::unordered_map<uint32_t, std::pair<const lr_parsing_model::Item *, cfg_model::TerminalSet>>> kernel_lookaheads;
+            for (const auto handle : closure)
+            {
+                const lr_parsing_model::LR1Item &item = pool.item(handle);
+                if (item.sequence_to_parse().empty())
+                {
+                    continue;
+                }
+                const auto &next_item = lr0_item_index.advance(item);
+                auto &kernel = kernel_lookaheads[item.sequence_to_parse()[0]];
+                auto inserted = kernel.emplace(next_item->packed, std::make_pair(next_item.get(), item.lookahead_bits()));
+                if (!inserted.second)
+                {
+                    inserted.first->second.second.union_with(item.lookahead_bits());
+                }
+            }
+            std::unordered_map<cfg_model::symbol, LR1ItemHandles> goto_kernels;
+            for (const auto &symbol_kernel : kernel_lookaheads)
+            {
+                LR1ItemHandles &kernel = goto_kernels[symbol_kernel.first];
+                kernel.reserve(symbol_kernel.second.size());
+                for (const auto &core_entry : symbol_kernel.second)
+                {
+                    kernel.push_back(pool.intern(*core_entry.second.first, core_entry.second.second));
+                }
+                std::sort(kernel.begin(), kernel.end());
+            }
+            LAB_LOG_DEBUG("Generated {} goto kernels from a closure of {} items", goto_kernels.size(), closure.size());
+            return goto_kernels;
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_message = "Error generating goto kernels: ";
+            error_message += e.what();
+            spdlog::error(error_message);
+            throw std::runtime_error(error_message);
+        }
+    }
+
+    bool weakly_compatible(
+        const std::vector<cfg_model::TerminalSet> &lookaheads,
+        const std::vector<cfg_model::TerminalSet> &other_lookaheads)
+    {
+        for (size_t i = 0; i < lookaheads.size(); ++i)
+        {
+            for (size_t j = i + 1; j < lookaheads.size(); ++j)
+            {
+                if (!lookaheads[i].intersects(other_lookaheads[j]) && !other_lookaheads[i].intersects(lookaheads[j]))
+                {
+                    continue;
+                }
+                if (lookaheads[i].intersects(lookaheads[j]) || other_lookaheads[i].intersects(other_lookaheads[j]))
+                {
+                    continue;
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<LR1KernelState> explore_merged_states(
+        const LR1ItemHandles &initial_kernel,
+        const LR0ItemIndex &lr0_item_index,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool &pool,
+        size_t &merge_count)
+    {
+        try
+        {
+            merge_count = 0;
+            std::vector<LR1KernelState> states;
+            std::map<std::vector<uint32_t>, std::vector<uint32_t>> states_by_core;
+            std::deque<uint32_t> unexpanded_states;
+            std::vector<uint8_t> queued;
+
+            // the state a kernel goes to: an identical one, a weakly compatible one (merged), or a new one
+            auto add_kernel = [&](const LR1ItemHandles &kernel_items) {
+                // one entry per core item in item id order, lookaheads of the same core item are united
+                std::map<uint32_t, std::pair<const lr_parsing_model::Item *, cfg_model::TerminalSet>> kernel;
+                for (const auto handle : kernel_items)
+                {
+                    const lr_parsing_model::LR1Item &item = pool.item(handle);
+                    auto inserted = kernel.emplace(lr0_item_index.item_id(item), std::make_pair(&item, item.lookahead_bits()));
+                    if (!inserted.second)
                     {
-                        auto new_lr1_item = pool.get_or_create(*next_item, lookahead_symbols);
-                        // check if the new item is already in the closure items
-                        if (closure_items.find(new_lr1_item) == closure_items.end())
-                        {
-                            closure_items.insert(new_lr1_item);
-                            spdlog::debug("Added LR(1) item to closure: {}", std::string(*new_lr1_item));
-                        }
+                        inserted.first->second.second.union_with(item.lookahead_bits());
                     }
                 }
+                std::vector<uint32_t> core_key;
+                std::vector<const lr_parsing_model::Item *> core_items;
+                std::vector<cfg_model::TerminalSet> lookaheads;
+                for (auto &core_entry : kernel)
+                {
+                    core_key.push_back(core_entry.first);
+                    core_items.push_back(core_entry.second.first);
+                    lookaheads.push_back(std::move(core_entry.second.second));
+                }
+                std::vector<uint32_t> &candidates = states_by_core[core_key];
+                for (const auto candidate : candidates)
+                {
+                    if (states[candidate].lookaheads == lookaheads)
+                    {
+                        return candidate;
+                    }
+                }
+                for (const auto candidate : candidates)
+                {
+                    if (!weakly_compatible(states[candidate].lookaheads, lookaheads))
+                    {
+                        continue;
+                    }
+                    bool grown = false;
+                    for (size_t i = 0; i < lookaheads.size(); ++i)
+                    {
+                        grown |= states[candidate].lookaheads[i].union_with(lookaheads[i]);
+                    }
+                    merge_count++;
+                    LAB_LOG_DEBUG("Merged a kernel of {} items into state {}", lookaheads.size(), candidate);
+                    // the successors have to see the new lookaheads
+                    if (grown && !queued[candidate])
+                    {
+                        queued[candidate] = 1;
+                        unexpanded_states.push_back(candidate);
+                    }
+                    return candidate;
+                }
+                uint32_t state_id = static_cast<uint32_t>(states.size());
+                LR1KernelState state;
+                for (const auto core_item : core_items)
+                {
+                    state.core.push_back(lr0_item_index.items_by_content.at(*core_item));
+                }
+                state.lookaheads = std::move(lookaheads);
+                states.push_back(std::move(state));
+                candidates.push_back(state_id);
+                queued.push_back(1);
+                unexpanded_states.push_back(state_id);
+                return state_id;
+            };
 
-                // check if the closure size has changed
-                if (closure_items.size() > previous_size)
+            add_kernel(initial_kernel);
+            while (!unexpanded_states.empty())
+            {
+                uint32_t state_id = unexpanded_states.front();
+                unexpanded_states.pop_front();
+                queued[state_id] = 0;
+                LR1ItemHandles kernel_items;
+                kernel_items.reserve(states[state_id].core.size());
+                for (size_t i = 0; i < states[state_id].core.size(); ++i)
+                {
+                    kernel_items.push_back(pool.intern(*states[state_id].core[i], states[state_id].lookaheads[i]));
+                }
+                std::sort(kernel_items.begin(), kernel_items.end());
+                auto closure = grow_closure(kernel_items, closure_templates, pool);
+                auto goto_kernels = generate_goto_kernels(closure, lr0_item_index, pool);
+                // which state a merge lands in depends on the order kernels arrive, keep it independent of hashing
+                std::vector<cfg_model::symbol> goto_symbols;
+                for (const auto &symbol_kernel : goto_kernels)
+                {
+                    goto_symbols.push_back(symbol_kernel.first);
+                }
+                std::sort(goto_symbols.begin(), goto_symbols.end(), [](const cfg_model::symbol &a, const cfg_model::symbol &b) {
+                    return std::string(a) < std::string(b);
+                });
+                std::unordered_map<cfg_model::symbol, uint32_t> successors;
+                for (const auto &symbol : goto_symbols)
                 {
-                    changed = true;
-                    spdlog::debug("Closure size changed: {} -> {}", previous_size, closure_items.size());
+                    successors[symbol] = add_kernel(goto_kernels.at(symbol));
                 }
+                // add_kernel may have reallocated the states, do not hold references across it
+                states[state_id].closure = std::move(closure);
+                states[state_id].successors = std::move(successors);
             }
 
-            spdlog::debug("Closure generation completed, total items: {}", closure_items.size());
-            // document the closure items
-            spdlog::debug("Closure items:");
-            for (const auto &item : closure_items)
+            // a re-expanded state may have moved its edges away from states that nothing reaches any more
+            std::vector<LR1KernelState> reachable_states = reachable_states_in_bfs_order(states, static_cast<uint32_t>(states.size()), 0);
+            LAB_LOG_DEBUG("Merged LR(1) exploration: {} states explored, {} reachable, {} merges", states.size(), reachable_states.size(), merge_count);
+            return reachable_states;
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_message = "Error exploring merged LR(1) states: ";
+            error_message += e.what();
+            spdlog::error(error_message);
+            throw std::runtime_error(error_message);
+        }
+    }
+
+    std::vector<LR1KernelState> explore_canonical_states(
+        const LR1ItemHandles &initial_kernel,
+        const LR0ItemIndex &lr0_item_index,
+        const LR1ClosureTemplates &closure_templates,
+        LR1ItemPool &pool,
+        unsigned thread_count)
+    {
+        try
+        {
+            if (thread_count == 0)
             {
-                spdlog::debug("{}", std::string(*item));
+                thread_count = std::max(1u, std::thread::hardware_concurrency());
             }
-            return closure_items;
+            // states by discovery id, which depends on the scheduling, a state never moves once allocated
+            lr_parsing_model::MonotonicArena<LR1KernelState> states;
+            // concurrent state table, kernel key -> discovery id
+            constexpr size_t shard_count = 64;
+            struct StateShard
+            {
+                std::mutex mutex;
+                std::unordered_map<LR1KernelKey, uint32_t, LR1KernelKeyHash> ids;
+            };
+            std::vector<StateShard> shards(shard_count);
+            WorkStealingPool workers(thread_count);
+
+            std::function<void(size_t, uint32_t)> expand_state;
+            // the state of a kernel, a new state gets its closure grown and is queued for expansion on this worker
+            auto find_or_add_state = [&](size_t worker, const LR1ItemHandles &kernel_items) {
+                LR1KernelKey kernel_key = make_kernel_key(kernel_items);
+                StateShard &shard = shards[kernel_key.hash % shard_count];
+                uint32_t state_id;
+                {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    auto existing = shard.ids.find(kernel_key);
+                    if (existing != shard.ids.end())
+                    {
+                        return existing->second;
+                    }
+                    state_id = states.allocate();
+                    shard.ids.emplace(std::move(kernel_key), state_id);
+                }
+                // other threads only take the id, the state is read by its expansion task queued below
+                states[state_id].closure = grow_closure(kernel_items, closure_templates, pool);
+                workers.submit(worker, [&expand_state, state_id](size_t running_worker) { expand_state(running_worker, state_id); });
+                return state_id;
+            };
+            expand_state = [&](size_t worker, uint32_t state_id) {
+                auto goto_kernels = generate_goto_kernels(states[state_id].closure, lr0_item_index, pool);
+                std::unordered_map<cfg_model::symbol, uint32_t> successors;
+                for (const auto &symbol_kernel : goto_kernels)
+                {
+                    successors[symbol_kernel.first] = find_or_add_state(worker, symbol_kernel.second);
+                }
+                states[state_id].successors = std::move(successors);
+            };
+
+            uint32_t initial_state = find_or_add_state(0, initial_kernel);
+            workers.run();
+            std::vector<LR1KernelState> reachable_states = reachable_states_in_bfs_order(states, states.size(), initial_state);
+            LAB_LOG_DEBUG("Canonical LR(1) exploration: {} states on {} thread(s)", reachable_states.size(), thread_count);
+            return reachable_states;
         }
         catch (const std::exception &e)
         {
-            std::string error_message = "Error generating closure: ";
+            std::string error_message = "Error exploring canonical LR(1) states: ";
             error_message += e.what();
             spdlog::error(error_message);
             throw std::runtime_error(error_message);
@@ -639,21 +1351,16 @@ namespace lr1_parsing_table_generator_helper
             for (const auto &item : closure_items)
             {
                 // check if the item can generate new items with the next symbol
-                if (item->sequence_to_parse.size() > 0 && item->sequence_to_parse[0] == next_symbol)
+                if (item->sequence_to_parse().size() > 0 && item->sequence_to_parse()[0] == next_symbol)
                 {
-                    // generate the next item from the current item
-                    // move the next symbol from sequence_to_parse to sequence_already_parsed
-                    std::vector<cfg_model::symbol> new_sequence_already_parsed = item->sequence_already_parsed;
-                    new_sequence_already_parsed.push_back(next_symbol);
-                    std::vector<cfg_model::symbol> new_sequence_to_parse(item->sequence_to_parse.begin() + 1, item->sequence_to_parse.end());
+                    // generate the next item from the current item, the dot moves over the next symbol
+                    lr_parsing_model::Item new_item = item->advanced();
                     // find the corresponding LR(0) item
                     std::shared_ptr<lr_parsing_model::Item> next_item;
                     bool found = false;
                     for (const auto &item_set_item : reference_lr0_item_set.items)
                     {
-                        if (item_set_item->left_side_symbol == item->left_side_symbol &&
-                            item_set_item->sequence_already_parsed == new_sequence_already_parsed &&
-                            item_set_item->sequence_to_parse == new_sequence_to_parse)
+                        if (*item_set_item == new_item)
                         {
                             next_item = item_set_item;
                             found = true;
@@ -665,28 +1372,29 @@ namespace lr1_parsing_table_generator_helper
                         spdlog::error("Error: Next item not found in reference item set for symbol: {}", std::string(next_symbol));
                         throw std::runtime_error("Next item not found in reference item set");
                     }
-                    auto new_lr1_item = pool.get_or_create(*next_item, item->lookahead_symbols);
+                    auto new_lr1_item = pool.get_or_create(*next_item, item->lookahead_set_id);
 
                     // add the new LR(1) item to the initial closure items
                     if (initial_closure_items.find(new_lr1_item) == initial_closure_items.end())
                     {
                         initial_closure_items.insert(new_lr1_item);
-                        spdlog::debug("Added initial LR(1) item to closure: {}", std::string(*new_lr1_item));
+                        LAB_LOG_DEBUG("Added initial LR(1) item to closure: {}", std::string(*new_lr1_item));
                     }
                 }
             }
 
-            spdlog::debug("Initial closure generation completed, total items: {}", initial_closure_items.size());
+            LAB_LOG_DEBUG("Initial closure generation completed, total items: {}", initial_closure_items.size());
             if (initial_closure_items.empty())
             {
-                spdlog::warn("No initial closure items generated for symbol: {}", std::string(next_symbol));
+                // not an error, most symbols have no transition from a given state
+                LAB_LOG_DEBUG("No initial closure items generated for symbol: {}", std::string(next_symbol));
             }
-            else
+            else if (LAB_LOG_DEBUG_ENABLED())
             {
-                spdlog::debug("Initial closure items:");
+                LAB_LOG_DEBUG("Initial closure items:");
                 for (const auto &item : initial_closure_items)
                 {
-                    spdlog::debug("{}", std::string(*item));
+                    LAB_LOG_DEBUG("{}", std::string(*item));
                 }
             }
             // return the initial closure items
@@ -701,6 +1409,11 @@ namespace lr1_parsing_table_generator_helper
         }
     }
 
+    std::string generate_lr1_state_name(uint32_t state_id)
+    {
+        return "I" + std::to_string(state_id);
+    }
+
     std::string generate_lr1_closure_name(const std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> &closure_items)
     {
         try
@@ -746,19 +1459,20 @@ namespace lr1_parsing_table_generator_helper
     {
         try
         {
-            spdlog::debug("Resolving conflicts in the parsing table");
+            LAB_LOG_DEBUG("Resolving conflicts in the parsing table");
             lr_parsing_model::LRParsingTable resolved_parsing_table;
             resolved_parsing_table.all_symbols = parsing_table_to_be_resolved.all_symbols;
             resolved_parsing_table.all_states = parsing_table_to_be_resolved.all_states;
             resolved_parsing_table.action_table = parsing_table_to_be_resolved.action_table;
             resolved_parsing_table.goto_table = parsing_table_to_be_resolved.goto_table;
             resolved_parsing_table.start_state = parsing_table_to_be_resolved.start_state;
+            resolved_parsing_table.production_table = parsing_table_to_be_resolved.production_table;
 
             // find all conflicts in the action table
             auto conflicts = resolved_parsing_table.find_conflicts();
             if (conflicts.empty())
             {
-                spdlog::debug("No conflicts found in the parsing table");
+                LAB_LOG_DEBUG("No conflicts found in the parsing table");
                 return resolved_parsing_table; // no conflicts to resolve
             }
 
@@ -778,7 +1492,7 @@ namespace lr1_parsing_table_generator_helper
 
                 // 1. get the items from the item set parsing table mapping for the current state
                 auto items = item_set_parsing_table_mapping.parsing_table_cell_to_item_set.at(state).at(symbol);
-                spdlog::debug("Found {} items for state {} and symbol {}", items.size(), state, std::string(symbol));
+                LAB_LOG_DEBUG("Found {} items for state {} and symbol {}", items.size(), state, std::string(symbol));
                 // 2. categorize the items into shift and reduce actions
                 std::vector<std::shared_ptr<lr_parsing_model::LR1Item>> shift_items;
                 std::vector<std::shared_ptr<lr_parsing_model::LR1Item>> reduce_items;
@@ -798,7 +1512,7 @@ namespace lr1_parsing_table_generator_helper
                 // this will remove the not-reducable items, solving reduce-reduce conflicts and also preparing for shift-reduce conflicts
                 if (reduce_items.size() == 0)
                 {
-                    spdlog::debug("No reduce items found in state {} for symbol {}, all actions are shift actions", state, std::string(symbol));
+                    LAB_LOG_DEBUG("No reduce items found in state {} for symbol {}, all actions are shift actions", state, std::string(symbol));
                 }
                 else
                 {
@@ -807,18 +1521,17 @@ namespace lr1_parsing_table_generator_helper
                     std::vector<lr_parsing_model::Action> reduce_actions_to_erase;
                     for (const auto &reduce_item : reduce_items)
                     {
-                        if (reduce_item->lookahead_symbols.find(symbol) == reduce_item->lookahead_symbols.end())
+                        if (reduce_item->lookahead_symbols().count(symbol) == 0)
                         {
-                            spdlog::debug("Removing reduce item {} from state {} for symbol {}: lookahead symbols do not contain the current symbol",
+                            LAB_LOG_DEBUG("Removing reduce item {} from state {} for symbol {}: lookahead symbols do not contain the current symbol",
                                           std::string(*reduce_item), state, std::string(symbol));
                             reduce_items_to_erase.push_back(reduce_item);
                             // also find the corresponding action in the conflict actions
                             for (const auto &action : conflict_actions)
                             {
-                                if (action.action_type == "reduce" && action.reduce_rule_lhs == reduce_item->left_side_symbol &&
-                                    action.reduce_rule_rhs == reduce_item->sequence_already_parsed)
+                                if (action.action_type == "reduce" && action.reduce_production == reduce_item->production_id())
                                 {
-                                    spdlog::debug("Removing action of item {} from state {} for symbol {}: it corresponds to the reduce item being removed",
+                                    LAB_LOG_DEBUG("Removing action of item {} from state {} for symbol {}: it corresponds to the reduce item being removed",
                                                   std::string(*reduce_item), state, std::string(symbol));
                                     reduce_actions_to_erase.push_back(action);
                                 }
@@ -844,7 +1557,7 @@ namespace lr1_parsing_table_generator_helper
                     }
                     else
                     {
-                        spdlog::debug("RR conflict resolved in state {} for symbol {}: {}", state, std::string(symbol), std::string(*reduce_items[0]));
+                        LAB_LOG_DEBUG("RR conflict resolved in state {} for symbol {}: {}", state, std::string(symbol), std::string(*reduce_items[0]));
                     }
                 }
                 // 4. then resolve shift-reduce conflicts
@@ -852,7 +1565,7 @@ namespace lr1_parsing_table_generator_helper
                 if (reduce_items.empty())
                 {
                     // conflict resolved successfully for this state and symbol
-                    spdlog::debug("Conflict resolved in state {} for symbol {}: no reduce items left", state, std::string(symbol));
+                    LAB_LOG_DEBUG("Conflict resolved in state {} for symbol {}: no reduce items left", state, std::string(symbol));
                     // add all shift actions back to the action table
                     for (const auto &action : conflict_actions)
                     {
@@ -886,7 +1599,7 @@ namespace lr1_parsing_table_generator_helper
                         if (strategy == LR1ConflictResolutionStrategy::SHIFT_OVER_REDUCE)
                         {
                             // prefer shift action, so we will keep the shift actions and discard the reduce action
-                            spdlog::debug("Resolving conflict by preferring shift action in state {} for symbol {}", state, std::string(symbol));
+                            LAB_LOG_DEBUG("Resolving conflict by preferring shift action in state {} for symbol {}", state, std::string(symbol));
                             for (const auto &action : conflict_actions)
                             {
                                 if (action.action_type == "shift")
@@ -898,7 +1611,7 @@ namespace lr1_parsing_table_generator_helper
                         else if (strategy == LR1ConflictResolutionStrategy::REDUCE_OVER_SHIFT)
                         {
                             // prefer reduce action, so we will keep the reduce action and discard the shift actions
-                            spdlog::debug("Resolving conflict by preferring reduce action in state {} for symbol {}", state, std::string(symbol));
+                            LAB_LOG_DEBUG("Resolving conflict by preferring reduce action in state {} for symbol {}", state, std::string(symbol));
                             for (const auto &action : conflict_actions)
                             {
                                 if (action.action_type == "reduce")
@@ -913,12 +1626,12 @@ namespace lr1_parsing_table_generator_helper
                             spdlog::error(error_message);
                             throw std::runtime_error(error_message);
                         }
-                        spdlog::debug("Conflict resolved in state {} for symbol {}: using strategy {}", state, std::string(symbol), strategy == LR1ConflictResolutionStrategy::SHIFT_OVER_REDUCE ? "PREFER_SHIFT" : "PREFER_REDUCE");
+                        LAB_LOG_DEBUG("Conflict resolved in state {} for symbol {}: using strategy {}", state, std::string(symbol), strategy == LR1ConflictResolutionStrategy::SHIFT_OVER_REDUCE ? "PREFER_SHIFT" : "PREFER_REDUCE");
                     }
                 }
             }
 
-            spdlog::debug("Conflicts resolved successfully in the parsing table");
+            LAB_LOG_DEBUG("Conflicts resolved successfully in the parsing table");
             // return the resolved parsing table
             return resolved_parsing_table;
         }
@@ -966,7 +1679,7 @@ namespace lr1_parsing_table_generator_helper
             }
             // update the class member variable
             new_item_set_parsing_table_mapping;
-            spdlog::debug("ItemSet parsing table mapping generated successfully");
+            LAB_LOG_DEBUG("ItemSet parsing table mapping generated successfully");
             return new_item_set_parsing_table_mapping;
         }
         catch (const std::exception &e)
@@ -5,16 +5,93 @@
 namespace lr_parsing_model
 {
 
+    // ProductionTable member functions
+    ProductionTable::ProductionTable(const cfg_model::ProductionNumbering &numbering)
+    {
+        for (cfg_model::production_id id = 0; id < numbering.size(); ++id)
+        {
+            add_production(numbering.lhs_of(id), numbering.rhs_of(id));
+        }
+    }
+
+    uint32_t ProductionTable::add_production(const cfg_model::symbol &lhs, const std::vector<cfg_model::symbol> &rhs)
+    {
+        uint32_t production_id = find_production(lhs, rhs);
+        if (production_id != invalid_production)
+        {
+            return production_id;
+        }
+        if (productions.size() > Item::max_production_id)
+        {
+            throw std::runtime_error("Too many productions for the item encoding: " + std::to_string(productions.size()));
+        }
+        Production production;
+        production.lhs = lhs;
+        production.rhs = rhs;
+        size_t seed = std::hash<cfg_model::symbol>()(lhs) + 0x9e3779b9;
+        for (const auto &s : rhs)
+        {
+            seed ^= std::hash<cfg_model::symbol>()(s) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        production.hash = seed;
+        production_id = static_cast<uint32_t>(productions.size());
+        productions.push_back(std::move(production));
+        productions_by_lhs[lhs].push_back(production_id);
+        return production_id;
+    }
+
+    uint32_t ProductionTable::find_production(const cfg_model::symbol &lhs, const std::vector<cfg_model::symbol> &rhs) const
+    {
+        auto it = productions_by_lhs.find(lhs);
+        if (it == productions_by_lhs.end())
+        {
+            return invalid_production;
+        }
+        for (const auto production_id : it->second)
+        {
+            if (productions[production_id].rhs == rhs)
+            {
+                return production_id;
+            }
+        }
+        return invalid_production;
+    }
+
     // Item member functions
+    Item::Item(std::shared_ptr<const ProductionTable> production_table, uint32_t production_id, uint32_t dot)
+        : production_table(std::move(production_table))
+    {
+        if (this->production_table == nullptr || production_id >= this->production_table->size())
+        {
+            throw std::runtime_error("Item refers to an unknown production: " + std::to_string(production_id));
+        }
+        if (dot > max_dot || dot > this->production_table->production(production_id).rhs.size())
+        {
+            throw std::runtime_error("Item dot out of range: " + std::to_string(dot));
+        }
+        packed = production_id << dot_bits | dot;
+    }
+
+    Item Item::advanced() const
+    {
+        if (is_accepting())
+        {
+            throw std::runtime_error("Cannot advance a complete item: " + std::string(*this));
+        }
+        Item next_item = *this;
+        next_item.packed++;
+        return next_item;
+    }
+
     Item::operator std::string() const
     {
-        std::string result = "[" + left_side_symbol.name + " -> ";
-        for (const auto &s : sequence_already_parsed)
+        std::string result = "[" + left_side_symbol().name + " -> ";
+        for (const auto &s : sequence_already_parsed())
         {
             result += std::string(s) + " ";
         }
         result += " · ";
-        for (const auto &s : sequence_to_parse)
+        for (const auto &s : sequence_to_parse())
         {
             result += " " + std::string(s);
         }
@@ -24,25 +101,116 @@ namespace lr_parsing_model
 
     LR1Item::operator std::string() const
     {
-        std::string result = "[" + left_side_symbol.name + " -> ";
-        for (const auto &s : sequence_already_parsed)
+        std::string result = "[" + left_side_symbol().name + " -> ";
+        for (const auto &s : sequence_already_parsed())
         {
             result += std::string(s) + " ";
         }
         result += " · ";
-        for (const auto &s : sequence_to_parse)
+        for (const auto &s : sequence_to_parse())
         {
             result += " " + std::string(s);
         }
         result += ", ";
-        for (const auto &lookahead : lookahead_symbols)
+        if (lookahead_table != nullptr)
         {
-            result += std::string(lookahead) + " ";
+            // in bit order, equal items print the same
+            const auto &terminals = lookahead_table->get_terminals();
+            lookahead_bits().for_each([&](size_t bit)
+                                      { result += std::string(terminals[bit]) + " "; });
         }
         result += "]";
         return result;
     }
 
+    const std::unordered_set<cfg_model::symbol> &LR1Item::lookahead_symbols() const
+    {
+        static const std::unordered_set<cfg_model::symbol> no_symbols;
+        return lookahead_table == nullptr ? no_symbols : lookahead_table->symbols(lookahead_set_id);
+    }
+
+    const cfg_model::TerminalSet &LR1Item::lookahead_bits() const
+    {
+        static const cfg_model::TerminalSet no_bits;
+        return lookahead_table == nullptr ? no_bits : lookahead_table->bits(lookahead_set_id);
+    }
+
+    // LookaheadSetTable member functions
+    LookaheadSetTable::LookaheadSetTable(std::vector<cfg_model::symbol> terminals) : terminals(std::move(terminals))
+    {
+        for (uint32_t bit = 0; bit < this->terminals.size(); ++bit)
+        {
+            bits_by_terminal.emplace(this->terminals[bit], bit);
+        }
+        // the empty set is always there as id 0
+        intern(cfg_model::TerminalSet(this->terminals.size()));
+    }
+
+    uint32_t LookaheadSetTable::intern(const cfg_model::TerminalSet &bits)
+    {
+        if (bits.size() != terminals.size())
+        {
+            throw std::runtime_error("Lookahead set of " + std::to_string(bits.size()) + " bits for " + std::to_string(terminals.size()) + " terminals");
+        }
+        size_t seed = 0;
+        for (const auto word : bits.data())
+        {
+            seed ^= std::hash<uint64_t>()(word) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        std::lock_guard<std::mutex> lock(intern_mutex);
+        auto &candidates = ids_by_hash[seed];
+        for (const auto lookahead_set_id : candidates)
+        {
+            if (sets[lookahead_set_id].bits == bits)
+            {
+                return lookahead_set_id;
+            }
+        }
+        uint32_t lookahead_set_id = sets.allocate();
+        LookaheadSet &lookahead_set = sets[lookahead_set_id];
+        lookahead_set.bits = bits;
+        bits.for_each([&](size_t bit)
+                      { lookahead_set.symbols.insert(terminals[bit]); });
+        lookahead_set.hash = seed;
+        candidates.push_back(lookahead_set_id);
+        return lookahead_set_id;
+    }
+
+    uint32_t LookaheadSetTable::intern(const std::unordered_set<cfg_model::symbol> &symbols)
+    {
+        cfg_model::TerminalSet bits(terminals.size());
+        for (const auto &symbol : symbols)
+        {
+            uint32_t bit = terminal_bit(symbol);
+            if (bit == cfg_model::invalid_symbol_id)
+            {
+                throw std::runtime_error("Lookahead symbol is not a terminal of the grammar: " + std::string(symbol));
+            }
+            bits.set(bit);
+        }
+        return intern(bits);
+    }
+
+    uint32_t LookaheadSetTable::unite(uint32_t lookahead_set_id, uint32_t other_lookahead_set_id)
+    {
+        if (lookahead_set_id == other_lookahead_set_id || other_lookahead_set_id == empty_set)
+        {
+            return lookahead_set_id;
+        }
+        cfg_model::TerminalSet bits = sets[lookahead_set_id].bits;
+        if (!bits.union_with(sets[other_lookahead_set_id].bits))
+        {
+            return lookahead_set_id;
+        }
+        return intern(bits);
+    }
+
+    uint32_t LookaheadSetTable::terminal_bit(const cfg_model::symbol &terminal) const
+    {
+        auto it = bits_by_terminal.find(terminal);
+        return it == bits_by_terminal.end() ? cfg_model::invalid_symbol_id : it->second;
+    }
+
     // LRParsingTable member functions
     bool LRParsingTable::add_action(const std::string &state, const cfg_model::symbol &symbol, const Action &action)
     {
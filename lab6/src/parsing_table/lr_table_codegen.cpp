@@ -0,0 +1,419 @@
+#include "lr_table_codegen.h"
+#include "compiled_lr_table.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+    bool is_identifier(const std::string &name)
+    {
+        if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+        {
+            return false;
+        }
+        for (const char c : name)
+        {
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string quoted(const std::string &text)
+    {
+        std::string result = "\"";
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                result += '\\';
+                result += c;
+            }
+            else if (c == '\n')
+            {
+                result += "\\n";
+            }
+            else
+            {
+                result += c;
+            }
+        }
+        return result + "\"";
+    }
+
+    // "static constexpr <type> <name>[] = {...};", 16 values a line
+    // C++ has no zero-length arrays, an empty one gets a single unused 0 (the counts say how much is real)
+    template <typename T>
+    void emit_array(std::ostringstream &out, const char *type, const char *name, const std::vector<T> &values)
+    {
+        out << "    static constexpr " << type << " " << name << "[] = {";
+        if (values.empty())
+        {
+            out << "0};\n";
+            return;
+        }
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            out << (i % 16 == 0 ? "\n        " : " ") << values[i] << ",";
+        }
+        out << "\n    };\n";
+    }
+
+    void emit_strings(std::ostringstream &out, const char *name, const std::vector<std::string> &values)
+    {
+        std::vector<std::string> quoted_values;
+        quoted_values.reserve(values.size());
+        for (const auto &value : values)
+        {
+            quoted_values.push_back(quoted(value));
+        }
+        if (quoted_values.empty())
+        {
+            quoted_values.push_back("\"\"");
+        }
+        out << "    static constexpr const char *" << name << "[] = {";
+        for (size_t i = 0; i < quoted_values.size(); ++i)
+        {
+            out << "\n        " << quoted_values[i] << ",";
+        }
+        out << "\n    };\n";
+    }
+
+    // the goto cells of each state, (non-terminal id, target state id) in non-terminal order
+    using StateGotos = std::vector<std::vector<std::pair<uint32_t, uint32_t>>>;
+
+    // one case body of a state's lookahead switch
+    // a shift enters the target state and continues with whatever it leaves to pop, a reduce returns its length
+    // (an epsilon reduce goes straight to the goto switch of the same state)
+    void emit_action(std::ostringstream &out, const lr_parsing_model::CompiledLRTable &compiled_table, uint32_t state, int32_t action,
+                     const std::vector<std::string> &production_texts, bool &continues)
+    {
+        using lr_parsing_model::CompiledLRTable;
+        const char *indent = "                ";
+        switch (CompiledLRTable::action_kind(action))
+        {
+        case CompiledLRTable::SHIFT:
+            out << indent << "context.listener.shift(context.index++);\n";
+            out << indent << "remaining = state_" << CompiledLRTable::action_value(action) << "(context) - 1;\n";
+            out << indent << "break;\n";
+            continues = true;
+            return;
+        case CompiledLRTable::REDUCE:
+        {
+            uint32_t production = CompiledLRTable::action_value(action);
+            if (production < production_texts.size())
+            {
+                out << indent << "// " << production_texts[production] << "\n";
+            }
+            out << indent << "context.lhs = " << compiled_table.productions[production].lhs << ";\n";
+            out << indent << "context.listener.reduce(" << production << ");\n";
+            if (compiled_table.productions[production].rhs_length == 0)
+            {
+                out << indent << "remaining = 0;\n" << indent << "break;\n";
+                continues = true;
+            }
+            else
+            {
+                out << indent << "return " << compiled_table.productions[production].rhs_length << ";\n";
+            }
+            return;
+        }
+        case CompiledLRTable::ACCEPT:
+            out << indent << "context.accepted = true;\n" << indent << "return accept_unwind;\n";
+            return;
+        default:
+            out << indent << "fail(" << state << ", context.terminals[context.index], " << (action == CompiledLRTable::conflict_action ? "true" : "false") << ");\n";
+        }
+    }
+
+    // struct RecursiveAscentParser, nested in the table struct: one function per state, called once the state is entered,
+    // returning how many states a reduce still has to pop, its own included
+    void emit_recursive_ascent(std::ostringstream &out, const lr_parsing_model::CompiledLRTable &compiled_table, const StateGotos &state_gotos,
+                               const std::vector<std::string> &production_texts)
+    {
+        out << "\n    // recursive ascent parser: the call stack is the state stack, every cell is a case of a switch\n";
+        out << "    // a state function returns how many states a reduce still has to pop, its own included\n";
+        out << "    struct RecursiveAscentParser\n    {\n";
+        out << "        // big enough that no stack unwinds it to 0\n";
+        out << "        static constexpr uint32_t accept_unwind = 0x80000000u;\n\n";
+        out << "        template <typename Listener>\n        struct Context\n        {\n";
+        out << "            const uint32_t *terminals;\n            size_t index;\n            Listener &listener;\n";
+        out << "            uint32_t lhs;\n            bool accepted;\n        };\n\n";
+        out << "        [[noreturn]] static void fail(uint32_t state, uint32_t terminal, bool conflict)\n        {\n";
+        out << "            throw std::runtime_error(std::string(conflict ? \"Multiple actions found for state \" : \"Parsing failed due to empty action for state \") +\n";
+        out << "                                     std::to_string(state) + \" and terminal \" + terminal_names[terminal]);\n        }\n\n";
+        out << "        [[noreturn]] static void fail_goto(uint32_t state, uint32_t non_terminal)\n        {\n";
+        out << "            throw std::runtime_error(\"No goto for state \" + std::to_string(state) + \" and non-terminal \" + non_terminal_names[non_terminal]);\n        }\n\n";
+        out << "        // same contract as lr_parsing_model::StaticLRParser::parse\n";
+        out << "        template <typename Listener>\n";
+        out << "        static void parse(const std::vector<uint32_t> &terminals, Listener &listener)\n        {\n";
+        out << "            if (terminals.empty() || terminals.back() != end_terminal)\n            {\n";
+        out << "                throw std::runtime_error(\"The terminals do not end with the end terminal.\");\n            }\n";
+        out << "            Context<Listener> context{terminals.data(), 0, listener, 0, false};\n";
+        out << "            state_" << compiled_table.start_state << "(context);\n";
+        out << "            if (!context.accepted)\n            {\n";
+        out << "                throw std::runtime_error(\"Parsing failed. No accept action found.\");\n            }\n        }\n";
+
+        const uint32_t terminal_count = static_cast<uint32_t>(compiled_table.terminals.size());
+        for (uint32_t state = 0; state < compiled_table.state_count; ++state)
+        {
+            // terminals grouped by action, the state's default action last
+            int32_t default_action = compiled_table.default_actions[state];
+            std::vector<std::pair<int32_t, std::vector<uint32_t>>> cases;
+            for (uint32_t terminal = 0; terminal < terminal_count; ++terminal)
+            {
+                int32_t action = compiled_table.action(state, terminal);
+                if (action == default_action)
+                {
+                    continue;
+                }
+                auto case_it = std::find_if(cases.begin(), cases.end(), [action](const auto &c) { return c.first == action; });
+                if (case_it == cases.end())
+                {
+                    cases.push_back({action, {terminal}});
+                }
+                else
+                {
+                    case_it->second.push_back(terminal);
+                }
+            }
+
+            std::ostringstream body;
+            bool continues = false;
+            body << "            switch (context.terminals[context.index])\n            {\n";
+            for (const auto &c : cases)
+            {
+                for (const uint32_t terminal : c.second)
+                {
+                    body << "            case " << terminal << ": // " << compiled_table.terminals[terminal].name << "\n";
+                }
+                emit_action(body, compiled_table, state, c.first, production_texts, continues);
+            }
+            body << "            default:\n";
+            emit_action(body, compiled_table, state, default_action, production_texts, continues);
+            body << "            }\n";
+
+            out << "\n        template <typename Listener>\n";
+            out << "        static uint32_t state_" << state << "(Context<Listener> &context)\n        {\n";
+            if (continues)
+            {
+                out << "            uint32_t remaining;\n";
+            }
+            out << body.str();
+            if (continues)
+            {
+                // back in this state after a reduce, go to the state of its lhs until something is left to pop
+                out << "            while (remaining == 0)\n            {\n";
+                out << "                switch (context.lhs)\n                {\n";
+                for (const auto &cell : state_gotos[state])
+                {
+                    out << "                case " << cell.first << ": // " << compiled_table.non_terminals[cell.first].name << "\n";
+                    out << "                    remaining = state_" << cell.second << "(context) - 1;\n";
+                    out << "                    break;\n";
+                }
+                out << "                default:\n";
+                out << "                    fail_goto(" << state << ", context.lhs);\n";
+                out << "                }\n            }\n";
+                out << "            return remaining;\n";
+            }
+            out << "        }\n";
+        }
+        out << "    };\n";
+    }
+
+    std::string emit_table_header(const lr_parsing_model::StoredLRTable &table, const lr_table_codegen_helper::TableHeaderOptions &options,
+                                  const StateGotos *state_gotos)
+    {
+        using lr_table_codegen_helper::no_node_type;
+        if (!is_identifier(options.table_name))
+        {
+            throw std::runtime_error("table name is not an identifier: " + options.table_name);
+        }
+        if (!is_identifier(options.namespace_name))
+        {
+            throw std::runtime_error("namespace name is not an identifier: " + options.namespace_name);
+        }
+        const lr_parsing_model::CompiledLRTable &compiled_table = table.compiled_table;
+        const size_t production_count = compiled_table.productions.size();
+        if (options.node_type_names.size() > production_count || options.node_type_ids.size() > production_count)
+        {
+            throw std::runtime_error("more node types than productions");
+        }
+
+        std::vector<uint32_t> production_lengths, production_lhs;
+        std::vector<int32_t> node_type_ids(production_count, no_node_type);
+        std::vector<std::string> node_type_names(production_count);
+        for (size_t id = 0; id < production_count; ++id)
+        {
+            production_lengths.push_back(compiled_table.productions[id].rhs_length);
+            production_lhs.push_back(compiled_table.productions[id].lhs);
+            if (id < options.node_type_ids.size())
+            {
+                node_type_ids[id] = options.node_type_ids[id];
+            }
+            if (id < options.node_type_names.size())
+            {
+                node_type_names[id] = options.node_type_names[id];
+            }
+        }
+        std::vector<std::string> terminal_names, non_terminal_names;
+        for (const auto &terminal : compiled_table.terminals)
+        {
+            terminal_names.push_back(terminal.name);
+        }
+        for (const auto &non_terminal : compiled_table.non_terminals)
+        {
+            non_terminal_names.push_back(non_terminal.name);
+        }
+        std::vector<std::string> production_texts;
+        if (table.production_table)
+        {
+            for (uint32_t id = 0; id < table.production_table->size(); ++id)
+            {
+                const lr_parsing_model::Production &production = table.production_table->production(id);
+                std::string text = production.lhs.name + " ->";
+                for (const auto &symbol : production.rhs)
+                {
+                    text += " " + symbol.name;
+                }
+                production_texts.push_back(text);
+            }
+        }
+
+        std::string guard = "GENERATED_LR_TABLE_" + options.table_name + "_H";
+        for (auto &c : guard)
+        {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        char hash_text[19];
+        std::snprintf(hash_text, sizeof(hash_text), "0x%016llx", static_cast<unsigned long long>(table.key.grammar_hash));
+
+        std::ostringstream out;
+        out << "// generated by tablegen, do not edit\n";
+        if (!options.source.empty())
+        {
+            out << "// from " << options.source << "\n";
+        }
+        out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+        out << "#include <cstdint>\n";
+        if (state_gotos != nullptr)
+        {
+            out << "#include <cstddef>\n#include <stdexcept>\n#include <string>\n#include <vector>\n";
+        }
+        out << "\n";
+        out << "namespace " << options.namespace_name << "\n{\n";
+        out << "struct " << options.table_name << "\n{\n";
+        out << "    static constexpr const char *generator = " << quoted(lr_table_file_helper::generator_name(table.key.generator)) << ";\n";
+        out << "    static constexpr uint64_t grammar_hash = " << hash_text << "ull;\n";
+        out << "    static constexpr uint32_t state_count = " << compiled_table.state_count << ";\n";
+        out << "    static constexpr uint32_t start_state = " << compiled_table.start_state << ";\n";
+        out << "    static constexpr uint32_t end_terminal = " << compiled_table.end_terminal << "u;\n";
+        out << "    static constexpr uint32_t terminal_count = " << compiled_table.terminals.size() << ";\n";
+        out << "    static constexpr uint32_t non_terminal_count = " << compiled_table.non_terminals.size() << ";\n";
+        out << "    static constexpr uint32_t production_count = " << production_count << ";\n\n";
+        out << "    // actions: low 2 bits error / shift / reduce / accept, the rest the target state or production id\n";
+        emit_array(out, "int32_t", "default_actions", compiled_table.default_actions);
+        emit_array(out, "uint32_t", "action_base", compiled_table.action_rows.base);
+        emit_array(out, "int32_t", "action_values", compiled_table.action_rows.values);
+        emit_array(out, "uint32_t", "action_check", compiled_table.action_rows.check);
+        out << "\n    // gotos: one comb-vector row per non-terminal, columns are states\n";
+        emit_array(out, "uint32_t", "default_gotos", compiled_table.default_gotos);
+        emit_array(out, "uint32_t", "goto_base", compiled_table.goto_columns.base);
+        emit_array(out, "int32_t", "goto_values", compiled_table.goto_columns.values);
+        emit_array(out, "uint32_t", "goto_check", compiled_table.goto_columns.check);
+        out << "\n    // productions by id: what a reduce pops, the non-terminal it goes to, the AST node it builds (-1: none)\n";
+        emit_array(out, "uint32_t", "production_lengths", production_lengths);
+        emit_array(out, "uint32_t", "production_lhs", production_lhs);
+        emit_array(out, "int32_t", "production_node_types", node_type_ids);
+        emit_strings(out, "production_node_type_names", node_type_names);
+        emit_strings(out, "production_texts", production_texts);
+        out << "\n    // terminal ids follow name order, token types are looked up by binary search\n";
+        emit_strings(out, "terminal_names", terminal_names);
+        emit_strings(out, "non_terminal_names", non_terminal_names);
+        if (state_gotos != nullptr)
+        {
+            emit_recursive_ascent(out, compiled_table, *state_gotos, production_texts);
+        }
+        out << "};\n";
+        out << "} // namespace " << options.namespace_name << "\n\n";
+        out << "#endif // !" << guard << "\n";
+        return out.str();
+    }
+}
+
+namespace lr_table_codegen_helper
+{
+    std::string generate_table_header(const lr_parsing_model::StoredLRTable &table, const TableHeaderOptions &options)
+    {
+        try
+        {
+            return emit_table_header(table, options, nullptr);
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_msg = "Error generating the table header " + options.table_name + ": " + e.what();
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+
+    std::string generate_recursive_ascent_header(const lr_parsing_model::LRParsingTable &parsing_table, const lr_parsing_model::LRTableFileKey &key,
+                                                 const TableHeaderOptions &options)
+    {
+        try
+        {
+            lr_parsing_model::StoredLRTable table;
+            table.key = key;
+            table.compiled_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+            table.production_table = parsing_table.production_table;
+            const lr_parsing_model::CompiledLRTable &compiled_table = table.compiled_table;
+
+            // the compiled goto columns answer for any state, the source table says which cells are real
+            std::unordered_map<std::string, uint32_t> state_ids;
+            for (uint32_t state = 0; state < compiled_table.state_count; ++state)
+            {
+                state_ids.emplace(compiled_table.state_names[state], state);
+            }
+            StateGotos state_gotos(compiled_table.state_count);
+            for (const auto &state_row : parsing_table.goto_table)
+            {
+                auto state_it = state_ids.find(state_row.first);
+                if (state_it == state_ids.end())
+                {
+                    continue;
+                }
+                for (const auto &cell : state_row.second)
+                {
+                    // empty targets are placeholders for cells without a goto
+                    auto non_terminal_it = compiled_table.non_terminal_ids.find(cell.first);
+                    bool has_target = std::any_of(cell.second.begin(), cell.second.end(), [](const std::string &target) { return !target.empty(); });
+                    if (non_terminal_it == compiled_table.non_terminal_ids.end() || !has_target)
+                    {
+                        continue;
+                    }
+                    uint32_t target = compiled_table.goto_state(state_it->second, non_terminal_it->second);
+                    if (target != lr_parsing_model::CompiledLRTable::invalid_id)
+                    {
+                        state_gotos[state_it->second].emplace_back(non_terminal_it->second, target);
+                    }
+                }
+                std::sort(state_gotos[state_it->second].begin(), state_gotos[state_it->second].end());
+            }
+            return emit_table_header(table, options, &state_gotos);
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_msg = "Error generating the recursive ascent parser " + options.table_name + ": " + e.what();
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+}
@@ -0,0 +1,701 @@
+#include "lr_table_file.h"
+#include "lr1_parsing_table_generator.h"
+#include "lalr1_parsing_table_generator.h"
+#include "slr1_parsing_table_generator.h"
+#include "simple_lr_parsing_table_generator.h"
+#include "yaml_cfg_loader.h"
+#include "spdlog/spdlog.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    using lr_parsing_model::LRTableFileSectionId;
+
+    // bytes per record of each section, in LRTableFileSectionId order
+    constexpr size_t record_sizes[LRTableFileSectionId::SECTION_COUNT] = {
+        4,  // TABLE_SCALARS
+        8,  // STATE_NAMES
+        16, // TERMINALS
+        16, // NON_TERMINALS
+        12, // PRODUCTIONS
+        20, // PRODUCTION_SYMBOLS
+        4,  // DEFAULT_ACTIONS
+        4,  // ACTION_BASE
+        4,  // ACTION_VALUES
+        4,  // ACTION_CHECK
+        4,  // DEFAULT_GOTOS
+        4,  // GOTO_BASE
+        4,  // GOTO_VALUES
+        4,  // GOTO_CHECK
+        1,  // STRING_DATA
+    };
+    constexpr size_t table_scalar_count = 3;
+
+    size_t align_up(size_t value) { return (value + 7) & ~static_cast<size_t>(7); }
+
+    // the sections of a file being written, as 32-bit words except for the string data
+    class TableFileBuilder
+    {
+    public:
+        std::vector<uint32_t> &words(LRTableFileSectionId id) { return section_words[id]; }
+
+        // append (offset, length) of a string to a section, equal strings share their bytes
+        void add_string(LRTableFileSectionId id, const std::string &value)
+        {
+            auto it = string_offsets.find(value);
+            if (it == string_offsets.end())
+            {
+                it = string_offsets.emplace(value, static_cast<uint32_t>(string_data.size())).first;
+                string_data.insert(string_data.end(), value.begin(), value.end());
+            }
+            section_words[id].push_back(it->second);
+            section_words[id].push_back(static_cast<uint32_t>(value.size()));
+        }
+
+        void add_symbol(LRTableFileSectionId id, const cfg_model::symbol &symbol)
+        {
+            add_string(id, symbol.name);
+            add_string(id, symbol.special_property);
+        }
+
+        std::vector<char> build(const lr_parsing_model::LRTableFileKey &key) const
+        {
+            size_t offset = align_up(sizeof(lr_parsing_model::LRTableFileHeader) +
+                                     sizeof(lr_parsing_model::LRTableFileSection) * LRTableFileSectionId::SECTION_COUNT);
+            lr_parsing_model::LRTableFileSection directory[LRTableFileSectionId::SECTION_COUNT];
+            for (uint32_t id = 0; id < LRTableFileSectionId::SECTION_COUNT; ++id)
+            {
+                size_t byte_count = id == LRTableFileSectionId::STRING_DATA ? string_data.size() : section_words[id].size() * sizeof(uint32_t);
+                directory[id].offset = offset;
+                directory[id].count = byte_count / record_sizes[id];
+                offset = align_up(offset + byte_count);
+            }
+
+            std::vector<char> buffer(offset, 0);
+            lr_parsing_model::LRTableFileHeader header{};
+            std::memcpy(header.magic, lr_table_file_helper::file_magic, sizeof(header.magic));
+            header.format_version = lr_table_file_helper::format_version;
+            header.generator = static_cast<uint32_t>(key.generator);
+            header.grammar_hash = key.grammar_hash;
+            header.file_size = buffer.size();
+            header.section_count = LRTableFileSectionId::SECTION_COUNT;
+            header.generator_version = key.generator_version;
+            std::memcpy(buffer.data(), &header, sizeof(header));
+            std::memcpy(buffer.data() + sizeof(header), directory, sizeof(directory));
+            for (uint32_t id = 0; id < LRTableFileSectionId::SECTION_COUNT; ++id)
+            {
+                if (id == LRTableFileSectionId::STRING_DATA)
+                {
+                    std::memcpy(buffer.data() + directory[id].offset, string_data.data(), string_data.size());
+                }
+                else
+                {
+                    std::memcpy(buffer.data() + directory[id].offset, section_words[id].data(), section_words[id].size() * sizeof(uint32_t));
+                }
+            }
+            return buffer;
+        }
+
+    private:
+        std::vector<uint32_t> section_words[LRTableFileSectionId::SECTION_COUNT];
+        std::vector<char> string_data;
+        std::unordered_map<std::string, uint32_t> string_offsets;
+    };
+
+    void add_comb_vector(TableFileBuilder &builder, const lr_parsing_model::CombVector &comb_vector,
+                         LRTableFileSectionId base, LRTableFileSectionId values, LRTableFileSectionId check)
+    {
+        builder.words(base) = comb_vector.base;
+        for (const auto value : comb_vector.values)
+        {
+            builder.words(values).push_back(static_cast<uint32_t>(value));
+        }
+        builder.words(check) = comb_vector.check;
+    }
+
+    void write_compiled_table(const std::string &path, const lr_parsing_model::LRTableFileKey &key,
+                              const lr_parsing_model::CompiledLRTable &compiled_table, const lr_parsing_model::ProductionTable &production_table)
+    {
+        if (compiled_table.productions.size() != production_table.size())
+        {
+            throw std::runtime_error("Compiled table and production table differ in their production count");
+        }
+        TableFileBuilder builder;
+        builder.words(LRTableFileSectionId::TABLE_SCALARS) = {compiled_table.state_count, compiled_table.start_state, compiled_table.end_terminal};
+        for (const auto &state_name : compiled_table.state_names)
+        {
+            builder.add_string(LRTableFileSectionId::STATE_NAMES, state_name);
+        }
+        for (const auto &terminal : compiled_table.terminals)
+        {
+            builder.add_symbol(LRTableFileSectionId::TERMINALS, terminal);
+        }
+        for (const auto &non_terminal : compiled_table.non_terminals)
+        {
+            builder.add_symbol(LRTableFileSectionId::NON_TERMINALS, non_terminal);
+        }
+        uint32_t symbol_index = 0;
+        for (uint32_t id = 0; id < production_table.size(); ++id)
+        {
+            const lr_parsing_model::Production &production = production_table.production(id);
+            builder.words(LRTableFileSectionId::PRODUCTIONS).insert(builder.words(LRTableFileSectionId::PRODUCTIONS).end(),
+                                                                    {compiled_table.productions[id].lhs, compiled_table.productions[id].rhs_length, symbol_index});
+            builder.add_symbol(LRTableFileSectionId::PRODUCTION_SYMBOLS, production.lhs);
+            builder.words(LRTableFileSectionId::PRODUCTION_SYMBOLS).push_back(production.lhs.is_terminal ? 1 : 0);
+            for (const auto &symbol : production.rhs)
+            {
+                builder.add_symbol(LRTableFileSectionId::PRODUCTION_SYMBOLS, symbol);
+                builder.words(LRTableFileSectionId::PRODUCTION_SYMBOLS).push_back(symbol.is_terminal ? 1 : 0);
+            }
+            symbol_index += static_cast<uint32_t>(production.rhs.size()) + 1;
+        }
+        for (const auto action : compiled_table.default_actions)
+        {
+            builder.words(LRTableFileSectionId::DEFAULT_ACTIONS).push_back(static_cast<uint32_t>(action));
+        }
+        add_comb_vector(builder, compiled_table.action_rows, LRTableFileSectionId::ACTION_BASE, LRTableFileSectionId::ACTION_VALUES, LRTableFileSectionId::ACTION_CHECK);
+        builder.words(LRTableFileSectionId::DEFAULT_GOTOS) = compiled_table.default_gotos;
+        add_comb_vector(builder, compiled_table.goto_columns, LRTableFileSectionId::GOTO_BASE, LRTableFileSectionId::GOTO_VALUES, LRTableFileSectionId::GOTO_CHECK);
+        std::vector<char> buffer = builder.build(key);
+
+        // written next to the target and renamed over it, a reader never maps a half-written file
+        std::filesystem::path target(path);
+        if (target.has_parent_path())
+        {
+            std::filesystem::create_directories(target.parent_path());
+        }
+        // unique per process, two writers of the same table do not share a temporary file
+        std::string temporary_path = path + "." + std::to_string(::getpid()) + ".tmp";
+        try
+        {
+            {
+                std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+                if (!file.is_open())
+                {
+                    throw std::runtime_error("Cannot open " + temporary_path + " for writing");
+                }
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                if (!file)
+                {
+                    throw std::runtime_error("Cannot write " + temporary_path);
+                }
+            }
+            std::filesystem::rename(temporary_path, target);
+        }
+        catch (...)
+        {
+            // a failed write leaves no temporary file behind
+            std::error_code ignored;
+            std::filesystem::remove(temporary_path, ignored);
+            throw;
+        }
+        spdlog::info("LR table file {} written: {} bytes", path, buffer.size());
+    }
+
+    // a string of the STRING_DATA section, throws if it is out of the section
+    std::string read_string(const char *string_data, size_t string_data_size, const uint32_t *pair)
+    {
+        if (static_cast<size_t>(pair[0]) + pair[1] > string_data_size)
+        {
+            throw std::runtime_error("String out of the string data");
+        }
+        return std::string(string_data + pair[0], pair[1]);
+    }
+
+    std::string describe_action(int32_t action)
+    {
+        using lr_parsing_model::CompiledLRTable;
+        switch (CompiledLRTable::action_kind(action))
+        {
+        case CompiledLRTable::SHIFT:
+            return "s" + std::to_string(CompiledLRTable::action_value(action));
+        case CompiledLRTable::REDUCE:
+            return "r" + std::to_string(CompiledLRTable::action_value(action));
+        case CompiledLRTable::ACCEPT:
+            return "acc";
+        default:
+            return action == CompiledLRTable::conflict_action ? "conflict" : "error";
+        }
+    }
+}
+
+namespace lr_parsing_model
+{
+    MappedLRTableFile::MappedLRTableFile(const std::string &path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open LR table file " + path);
+        }
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(LRTableFileHeader)))
+        {
+            ::close(fd);
+            throw std::runtime_error("LR table file " + path + " is too short");
+        }
+        size = static_cast<size_t>(file_stat.st_size);
+        void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map LR table file " + path);
+        }
+        data = static_cast<const char *>(mapping);
+        try
+        {
+            check_layout();
+        }
+        catch (const std::exception &e)
+        {
+            ::munmap(const_cast<char *>(data), size);
+            throw std::runtime_error("LR table file " + path + ": " + e.what());
+        }
+    }
+
+    MappedLRTableFile::~MappedLRTableFile()
+    {
+        if (data != nullptr)
+        {
+            ::munmap(const_cast<char *>(data), size);
+        }
+    }
+
+    LRTableFileKey MappedLRTableFile::key() const
+    {
+        LRTableFileKey file_key;
+        file_key.grammar_hash = header().grammar_hash;
+        file_key.generator = static_cast<TableGeneratorKind>(header().generator);
+        file_key.generator_version = header().generator_version;
+        return file_key;
+    }
+
+    void MappedLRTableFile::check_layout() const
+    {
+        const LRTableFileHeader &file_header = header();
+        if (std::memcmp(file_header.magic, lr_table_file_helper::file_magic, sizeof(file_header.magic)) != 0)
+        {
+            throw std::runtime_error("not an LR table file");
+        }
+        if (file_header.format_version != lr_table_file_helper::format_version)
+        {
+            throw std::runtime_error("format version " + std::to_string(file_header.format_version) + ", expected " +
+                                     std::to_string(lr_table_file_helper::format_version));
+        }
+        if (file_header.file_size != size)
+        {
+            throw std::runtime_error("size " + std::to_string(size) + " does not match the header's " + std::to_string(file_header.file_size));
+        }
+        if (file_header.section_count != LRTableFileSectionId::SECTION_COUNT ||
+            size < sizeof(LRTableFileHeader) + sizeof(LRTableFileSection) * LRTableFileSectionId::SECTION_COUNT)
+        {
+            throw std::runtime_error("unexpected section directory");
+        }
+        for (uint32_t id = 0; id < LRTableFileSectionId::SECTION_COUNT; ++id)
+        {
+            const LRTableFileSection &entry = sections()[id];
+            if (entry.offset % 8 != 0 || entry.offset > size || entry.count > (size - entry.offset) / record_sizes[id])
+            {
+                throw std::runtime_error("section " + std::to_string(id) + " out of the file");
+            }
+        }
+    }
+
+    StoredLRTable MappedLRTableFile::load() const
+    {
+        StoredLRTable stored;
+        stored.key = key();
+        CompiledLRTable &compiled_table = stored.compiled_table;
+        size_t count = 0;
+
+        size_t string_data_size = 0;
+        const char *string_data = section<char>(LRTableFileSectionId::STRING_DATA, string_data_size);
+        auto read_symbols = [&](LRTableFileSectionId id, bool is_terminal, std::vector<cfg_model::symbol> &symbols) {
+            const uint32_t *records = section<uint32_t>(id, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const uint32_t *record = records + i * 4;
+                symbols.push_back({read_string(string_data, string_data_size, record), is_terminal, read_string(string_data, string_data_size, record + 2)});
+            }
+        };
+
+        // 1. scalars, states and symbols
+        const uint32_t *scalars = section<uint32_t>(LRTableFileSectionId::TABLE_SCALARS, count);
+        if (count != table_scalar_count)
+        {
+            throw std::runtime_error("Unexpected table scalars in the LR table file");
+        }
+        compiled_table.state_count = scalars[0];
+        compiled_table.start_state = scalars[1];
+        compiled_table.end_terminal = scalars[2];
+        const uint32_t *state_names = section<uint32_t>(LRTableFileSectionId::STATE_NAMES, count);
+        if (count != compiled_table.state_count || compiled_table.start_state >= compiled_table.state_count)
+        {
+            throw std::runtime_error("Unexpected states in the LR table file");
+        }
+        compiled_table.state_names.reserve(count);
+        for (size_t state = 0; state < count; ++state)
+        {
+            compiled_table.state_names.push_back(read_string(string_data, string_data_size, state_names + state * 2));
+        }
+        read_symbols(LRTableFileSectionId::TERMINALS, true, compiled_table.terminals);
+        read_symbols(LRTableFileSectionId::NON_TERMINALS, false, compiled_table.non_terminals);
+        if (compiled_table.end_terminal != CompiledLRTable::invalid_id && compiled_table.end_terminal >= compiled_table.terminals.size())
+        {
+            throw std::runtime_error("End terminal out of the LR table file's terminals");
+        }
+        for (uint32_t terminal = 0; terminal < compiled_table.terminals.size(); ++terminal)
+        {
+            compiled_table.terminal_ids_by_name.emplace(compiled_table.terminals[terminal].name, terminal);
+        }
+        for (uint32_t non_terminal = 0; non_terminal < compiled_table.non_terminals.size(); ++non_terminal)
+        {
+            compiled_table.non_terminal_ids.emplace(compiled_table.non_terminals[non_terminal], non_terminal);
+        }
+
+        // 2. productions, the production table is rebuilt in id order
+        size_t symbol_count = 0;
+        const uint32_t *production_symbols = section<uint32_t>(LRTableFileSectionId::PRODUCTION_SYMBOLS, symbol_count);
+        auto read_production_symbol = [&](size_t index) {
+            const uint32_t *record = production_symbols + index * 5;
+            return cfg_model::symbol{read_string(string_data, string_data_size, record), record[4] != 0, read_string(string_data, string_data_size, record + 2)};
+        };
+        const uint32_t *productions = section<uint32_t>(LRTableFileSectionId::PRODUCTIONS, count);
+        auto production_table = std::make_shared<ProductionTable>();
+        compiled_table.productions.reserve(count);
+        for (size_t id = 0; id < count; ++id)
+        {
+            const uint32_t *record = productions + id * 3;
+            uint32_t lhs = record[0], rhs_length = record[1], first_symbol = record[2];
+            if ((lhs != CompiledLRTable::invalid_id && lhs >= compiled_table.non_terminals.size()) ||
+                static_cast<size_t>(first_symbol) + rhs_length + 1 > symbol_count)
+            {
+                throw std::runtime_error("Production " + std::to_string(id) + " out of the LR table file");
+            }
+            std::vector<cfg_model::symbol> rhs;
+            rhs.reserve(rhs_length);
+            for (uint32_t i = 0; i < rhs_length; ++i)
+            {
+                rhs.push_back(read_production_symbol(first_symbol + 1 + i));
+            }
+            if (production_table->add_production(read_production_symbol(first_symbol), rhs) != id)
+            {
+                throw std::runtime_error("Duplicate production " + std::to_string(id) + " in the LR table file");
+            }
+            compiled_table.productions.push_back({lhs, rhs_length});
+        }
+        stored.production_table = production_table;
+
+        // 3. the integer tables, copied straight out of the mapping
+        auto copy_section = [&](LRTableFileSectionId id, auto &target, size_t expected_count) {
+            using value_type = typename std::decay_t<decltype(target)>::value_type;
+            const value_type *values = section<value_type>(id, count);
+            if (expected_count != std::numeric_limits<size_t>::max() && count != expected_count)
+            {
+                throw std::runtime_error("Section " + std::to_string(static_cast<uint32_t>(id)) + " of the LR table file has an unexpected size");
+            }
+            target.assign(values, values + count);
+        };
+        constexpr size_t any_count = std::numeric_limits<size_t>::max();
+        copy_section(LRTableFileSectionId::DEFAULT_ACTIONS, compiled_table.default_actions, compiled_table.state_count);
+        copy_section(LRTableFileSectionId::ACTION_BASE, compiled_table.action_rows.base, compiled_table.state_count);
+        copy_section(LRTableFileSectionId::ACTION_VALUES, compiled_table.action_rows.values, any_count);
+        copy_section(LRTableFileSectionId::ACTION_CHECK, compiled_table.action_rows.check, compiled_table.action_rows.values.size());
+        copy_section(LRTableFileSectionId::DEFAULT_GOTOS, compiled_table.default_gotos, compiled_table.non_terminals.size());
+        copy_section(LRTableFileSectionId::GOTO_BASE, compiled_table.goto_columns.base, compiled_table.non_terminals.size());
+        copy_section(LRTableFileSectionId::GOTO_VALUES, compiled_table.goto_columns.values, any_count);
+        copy_section(LRTableFileSectionId::GOTO_CHECK, compiled_table.goto_columns.check, compiled_table.goto_columns.values.size());
+        // lookups index base + column without a bounds check, hold the file to the padding compile_lr_table gives
+        for (const auto base : compiled_table.action_rows.base)
+        {
+            if (static_cast<size_t>(base) + compiled_table.terminals.size() > compiled_table.action_rows.check.size())
+            {
+                throw std::runtime_error("Action row out of the LR table file's comb vector");
+            }
+        }
+        for (const auto base : compiled_table.goto_columns.base)
+        {
+            if (static_cast<size_t>(base) + compiled_table.state_count > compiled_table.goto_columns.check.size())
+            {
+                throw std::runtime_error("Goto column out of the LR table file's comb vector");
+            }
+        }
+        // the driver follows actions and gotos without a bounds check either, every target must be a state or a reducible production
+        auto check_action = [&compiled_table](int32_t action) {
+            uint32_t value = CompiledLRTable::action_value(action);
+            switch (CompiledLRTable::action_kind(action))
+            {
+            case CompiledLRTable::SHIFT:
+                return value < compiled_table.state_count;
+            case CompiledLRTable::REDUCE:
+                return value < compiled_table.productions.size() && compiled_table.productions[value].lhs != CompiledLRTable::invalid_id;
+            case CompiledLRTable::ACCEPT:
+                return action == CompiledLRTable::accept_action;
+            default:
+                return action == CompiledLRTable::error_action || action == CompiledLRTable::conflict_action;
+            }
+        };
+        for (uint32_t state = 0; state < compiled_table.state_count; ++state)
+        {
+            if (!check_action(compiled_table.default_actions[state]))
+            {
+                throw std::runtime_error("Default action of state " + std::to_string(state) + " out of the LR table file");
+            }
+        }
+        for (size_t slot = 0; slot < compiled_table.action_rows.values.size(); ++slot)
+        {
+            if (compiled_table.action_rows.check[slot] != CombVector::empty_slot && !check_action(compiled_table.action_rows.values[slot]))
+            {
+                throw std::runtime_error("Action " + std::to_string(slot) + " out of the LR table file");
+            }
+        }
+        for (uint32_t non_terminal = 0; non_terminal < compiled_table.non_terminals.size(); ++non_terminal)
+        {
+            uint32_t target = compiled_table.default_gotos[non_terminal];
+            if (target != CompiledLRTable::invalid_id && target >= compiled_table.state_count)
+            {
+                throw std::runtime_error("Default goto of " + compiled_table.non_terminals[non_terminal].name + " out of the LR table file");
+            }
+        }
+        for (size_t slot = 0; slot < compiled_table.goto_columns.values.size(); ++slot)
+        {
+            if (compiled_table.goto_columns.check[slot] != CombVector::empty_slot &&
+                static_cast<uint32_t>(compiled_table.goto_columns.values[slot]) >= compiled_table.state_count)
+            {
+                throw std::runtime_error("Goto " + std::to_string(slot) + " out of the LR table file");
+            }
+        }
+        return stored;
+    }
+};
+
+namespace lr_table_file_helper
+{
+    uint64_t hash_grammar_file(const std::string &grammar_path)
+    {
+        std::ifstream file(grammar_path, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::string error_msg = "Error hashing grammar file: cannot open " + grammar_path;
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        uint64_t hash = 14695981039346656037ull;
+        char buffer[4096];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        {
+            for (std::streamsize i = 0; i < file.gcount(); ++i)
+            {
+                hash ^= static_cast<unsigned char>(buffer[i]);
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    std::string generator_name(lr_parsing_model::TableGeneratorKind generator)
+    {
+        switch (generator)
+        {
+        case lr_parsing_model::TableGeneratorKind::SIMPLE_LR:
+            return "simple_lr";
+        case lr_parsing_model::TableGeneratorKind::SLR1:
+            return "slr1";
+        case lr_parsing_model::TableGeneratorKind::LR1:
+            return "lr1";
+        case lr_parsing_model::TableGeneratorKind::LR1_PAGER:
+            return "lr1_pager";
+        case lr_parsing_model::TableGeneratorKind::LALR1:
+            return "lalr1";
+        }
+        return "unknown(" + std::to_string(static_cast<uint32_t>(generator)) + ")";
+    }
+
+    lr_parsing_model::TableGeneratorKind parse_generator_name(const std::string &name)
+    {
+        for (uint32_t kind = 0; kind <= static_cast<uint32_t>(lr_parsing_model::TableGeneratorKind::LALR1); ++kind)
+        {
+            if (generator_name(static_cast<lr_parsing_model::TableGeneratorKind>(kind)) == name)
+            {
+                return static_cast<lr_parsing_model::TableGeneratorKind>(kind);
+            }
+        }
+        std::string error_msg = "Error: unknown table generator " + name;
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    lr_parsing_model::LRParsingTable generate_parsing_table(const cfg_model::CFG &cfg, lr_parsing_model::TableGeneratorKind generator)
+    {
+        switch (generator)
+        {
+        case lr_parsing_model::TableGeneratorKind::SIMPLE_LR:
+            return SimpleLRParsingTableGenerator().generate_parsing_table(cfg);
+        case lr_parsing_model::TableGeneratorKind::SLR1:
+            return SLR1ParsingTableGenerator().generate_parsing_table(cfg);
+        case lr_parsing_model::TableGeneratorKind::LR1:
+            return LR1ParsingTableGenerator().generate_parsing_table(cfg);
+        case lr_parsing_model::TableGeneratorKind::LR1_PAGER:
+        {
+            LR1ParsingTableGenerator lr1_generator;
+            lr1_generator.set_state_merging(LR1ParsingTableGenerator::StateMerging::PAGER_WEAK_COMPATIBILITY);
+            return lr1_generator.generate_parsing_table(cfg);
+        }
+        case lr_parsing_model::TableGeneratorKind::LALR1:
+            return LALR1ParsingTableGenerator().generate_parsing_table(cfg);
+        }
+        std::string error_msg = "Error: unknown table generator " + generator_name(generator);
+        spdlog::error(error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    void write_table_file(const std::string &path, const lr_parsing_model::LRTableFileKey &key, const lr_parsing_model::LRParsingTable &parsing_table)
+    {
+        try
+        {
+            if (!parsing_table.production_table)
+            {
+                throw std::runtime_error("the parsing table has no production table");
+            }
+            write_compiled_table(path, key, compiled_lr_table_helper::compile_lr_table(parsing_table), *parsing_table.production_table);
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_msg = "Error writing LR table file " + path + ": " + e.what();
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+
+    lr_parsing_model::StoredLRTable read_table_file(const std::string &path)
+    {
+        try
+        {
+            lr_parsing_model::MappedLRTableFile mapped_file(path);
+            return mapped_file.load();
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_msg = "Error reading LR table file " + path + ": " + e.what();
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+
+    lr_parsing_model::StoredLRTable load_or_generate(const std::string &grammar_path, lr_parsing_model::TableGeneratorKind generator, const std::string &table_path)
+    {
+        try
+        {
+            lr_parsing_model::LRTableFileKey key;
+            key.grammar_hash = hash_grammar_file(grammar_path);
+            key.generator = generator;
+            if (std::filesystem::exists(table_path))
+            {
+                // a file that cannot be used is regenerated, not an error
+                try
+                {
+                    lr_parsing_model::MappedLRTableFile mapped_file(table_path);
+                    if (mapped_file.key() == key)
+                    {
+                        spdlog::info("LR table of {} loaded from {}", grammar_path, table_path);
+                        return mapped_file.load();
+                    }
+                    spdlog::info("LR table file {} is stale, regenerating", table_path);
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::warn("LR table file {} is unusable, regenerating: {}", table_path, e.what());
+                }
+            }
+
+            YAML_CFG_Loader cfg_loader;
+            cfg_model::CFG cfg = cfg_loader.LoadCFG(grammar_path);
+            lr_parsing_model::LRParsingTable parsing_table = generate_parsing_table(cfg, generator);
+            lr_parsing_model::StoredLRTable stored;
+            stored.key = key;
+            stored.compiled_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+            stored.production_table = parsing_table.production_table;
+            if (!stored.production_table)
+            {
+                throw std::runtime_error("the generated table has no production table");
+            }
+            write_compiled_table(table_path, key, stored.compiled_table, *stored.production_table);
+            return stored;
+        }
+        catch (const std::exception &e)
+        {
+            std::string error_msg = "Error loading the LR table of " + grammar_path + ": " + e.what();
+            spdlog::error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+
+    std::string describe_table(const lr_parsing_model::StoredLRTable &table, bool with_cells)
+    {
+        const lr_parsing_model::CompiledLRTable &compiled_table = table.compiled_table;
+        std::ostringstream out;
+        char hash_text[17];
+        std::snprintf(hash_text, sizeof(hash_text), "%016llx", static_cast<unsigned long long>(table.key.grammar_hash));
+        out << "generator: " << generator_name(table.key.generator) << "\n";
+        out << "grammar hash: " << hash_text << "\n";
+        out << "generator version: " << table.key.generator_version << "\n";
+        out << "states: " << compiled_table.state_count << ", terminals: " << compiled_table.terminals.size()
+            << ", non-terminals: " << compiled_table.non_terminals.size() << ", productions: " << compiled_table.productions.size() << "\n";
+        out << "action comb vector: " << compiled_table.action_rows.values.size() << " slots for "
+            << static_cast<size_t>(compiled_table.state_count) * compiled_table.terminals.size() << " cells\n";
+        out << "goto comb vector: " << compiled_table.goto_columns.values.size() << " slots for "
+            << static_cast<size_t>(compiled_table.state_count) * compiled_table.non_terminals.size() << " cells\n";
+        out << "start state: " << compiled_table.state_names[compiled_table.start_state] << "\n";
+        out << "productions:\n";
+        for (uint32_t id = 0; id < compiled_table.productions.size(); ++id)
+        {
+            out << "  " << id << ": ";
+            if (table.production_table)
+            {
+                const lr_parsing_model::Production &production = table.production_table->production(id);
+                out << production.lhs.name << " ->";
+                for (const auto &symbol : production.rhs)
+                {
+                    out << " " << symbol.name;
+                }
+            }
+            if (compiled_table.productions[id].lhs == lr_parsing_model::CompiledLRTable::invalid_id)
+            {
+                out << " (never reduced)";
+            }
+            out << "\n";
+        }
+        if (with_cells)
+        {
+            out << "actions:\n";
+            for (uint32_t state = 0; state < compiled_table.state_count; ++state)
+            {
+                out << "  " << state << ":";
+                for (uint32_t terminal = 0; terminal < compiled_table.terminals.size(); ++terminal)
+                {
+                    int32_t action = compiled_table.action(state, terminal);
+                    if (action != lr_parsing_model::CompiledLRTable::error_action)
+                    {
+                        out << " " << compiled_table.terminals[terminal].name << "=" << describe_action(action);
+                    }
+                }
+                out << "\n";
+            }
+        }
+        return out.str();
+    }
+}
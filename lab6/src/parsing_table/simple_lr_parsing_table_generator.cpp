@@ -11,9 +11,9 @@ lr_parsing_model::ItemSet SimpleLRParsingTableGenerator::generate_item_set(const
 {
     try
     {
-        // Generate the item set
+        // Generate the item set from the reduced grammar
         ItemSetGenerator item_set_generator;
-        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(cfg);
+        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(prepare_cfg(cfg));
 
         return item_set;
     }
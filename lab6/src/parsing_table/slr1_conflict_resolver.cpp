@@ -26,6 +26,7 @@ bool SLR1ConflictResolver::resolve_conflicts()
         resolved_parsing_table.action_table = parsing_table.action_table;
         resolved_parsing_table.goto_table = parsing_table.goto_table;
         resolved_parsing_table.start_state = parsing_table.start_state;
+        resolved_parsing_table.production_table = parsing_table.production_table;
         // get the conflicts in the parsing table
         auto conflicts = parsing_table.find_conflicts();
         // check if there are any conflicts
@@ -66,7 +67,7 @@ bool SLR1ConflictResolver::resolve_conflicts()
                 if (item->is_accepting())
                 {
                     // get the follow set of the item
-                    std::unordered_set<cfg_model::symbol> current_item_follow_set = follow_set.follow_set.at(item->left_side_symbol);
+                    std::unordered_set<cfg_model::symbol> current_item_follow_set = follow_set.follow_set.at(item->left_side_symbol());
                     // add the follow set to the total symbols
                     total_symbols.insert(current_item_follow_set.begin(), current_item_follow_set.end());
                     expected_total_symbols_count += current_item_follow_set.size();
@@ -89,8 +90,8 @@ bool SLR1ConflictResolver::resolve_conflicts()
                 {
                     if (item->is_accepting())
                     {
-                        std::unordered_set<cfg_model::symbol> current_item_follow_set = follow_set.follow_set.at(item->left_side_symbol);
-                        std::string follow_set_str = "Follow set for item " + std::string(item->left_side_symbol) + ": ";
+                        std::unordered_set<cfg_model::symbol> current_item_follow_set = follow_set.follow_set.at(item->left_side_symbol());
+                        std::string follow_set_str = "Follow set for item " + std::string(item->left_side_symbol()) + ": ";
                         for (const auto &follow_symbol : current_item_follow_set)
                         {
                             follow_set_str += std::string(follow_symbol) + ", ";
@@ -143,15 +144,14 @@ bool SLR1ConflictResolver::resolve_conflicts()
                 if (item->is_accepting())
                 {
                     // get the follow set of the item
-                    std::unordered_set<cfg_model::symbol> current_item_follow_set = follow_set.follow_set.at(item->left_side_symbol);
+                    std::unordered_set<cfg_model::symbol> current_item_follow_set = follow_set.follow_set.at(item->left_side_symbol());
                     // check if the symbol is in the follow set
                     if (current_item_follow_set.find(symbol) != current_item_follow_set.end())
                     {
                         // create a reduce action
                         lr_parsing_model::Action reduce_action;
                         reduce_action.action_type = "reduce";
-                        reduce_action.reduce_rule_lhs = item->left_side_symbol;
-                        reduce_action.reduce_rule_rhs = item->sequence_already_parsed;
+                        reduce_action.reduce_production = item->production_id();
                         // add the reduce action to the parsing table
                         resolved_parsing_table.add_action(state, symbol, reduce_action);
                         spdlog::debug("Added reduce action for state {} and symbol {}", state, std::string(symbol));
@@ -192,7 +192,7 @@ std::unordered_set<cfg_model::symbol> slr1_conflict_resolver_helper::get_shift_s
         if (!item->is_accepting())
         {
             // get the next symbol to parse
-            cfg_model::symbol next_symbol = item->sequence_to_parse[0];
+            cfg_model::symbol next_symbol = item->sequence_to_parse()[0];
             shift_symbols.insert(next_symbol);
         }
     }
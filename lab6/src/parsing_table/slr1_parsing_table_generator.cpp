@@ -18,9 +18,9 @@ lr_parsing_model::ItemSet SLR1ParsingTableGenerator::generate_item_set(const cfg
 {
     try
     {
-        // Generate the item set
+        // Generate the item set from the reduced grammar
         ItemSetGenerator item_set_generator;
-        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(cfg);
+        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(prepare_cfg(cfg));
 
         return item_set;
     }
@@ -36,9 +36,11 @@ lr_parsing_model::LRParsingTable SLR1ParsingTableGenerator::generate_parsing_tab
 {
     try
     {
-        // Generate the item set
-        lr_parsing_model::ItemSet item_set = generate_item_set(cfg);
-        cfg_model::CFG expanded_cfg = itemset_generator_helper::expand_cfg(cfg);
+        // Generate the item set, the conflict resolver works on the same reduced grammar
+        cfg_model::CFG reduced_cfg = prepare_cfg(cfg);
+        ItemSetGenerator item_set_generator;
+        lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(reduced_cfg);
+        cfg_model::CFG expanded_cfg = itemset_generator_helper::expand_cfg(reduced_cfg);
 
         // Create an instance of ItemSetToParsingTable
         ItemSetToParsingTable item_set_to_parsing_table(item_set);
@@ -5,6 +5,7 @@
 #include "logical_env_simulator.h"
 #include "scope_table.h"
 #include "spdlog/spdlog.h"
+#include "log_macros.h"
 #include "symbol_table.h"
 #include <fstream>
 #include <stdexcept>
@@ -27,7 +28,7 @@ void IntermCodeGenerator::produce_intermediate_code(const std::string& output_fi
         spdlog::error("AST tree is empty. Cannot generate intermediate code.");
         throw std::runtime_error("AST tree is empty.");
     }
-    spdlog::debug("Iterating through the AST tree with {} nodes.", current_ast_tree.size());
+    LAB_LOG_DEBUG("Iterating through the AST tree with {} nodes.", current_ast_tree.size());
     // 3. start iterating through the AST tree
     recursive_iterate_ast_tree(current_ast_tree.begin());
     spdlog::info("Intermediate code generation completed successfully.");
@@ -46,7 +47,7 @@ void IntermCodeGenerator::produce_intermediate_code(const std::string& output_fi
     for (const auto& code : interm_code_list) {
         // Format the index with a fixed width, e.g., 3 characters, left-aligned
         output_stream << std::left << std::setw(3) << index++ << ". " << code->toString() << "\n";
-        spdlog::debug("Written intermediate code {}: {}", index - 1, code->toString());
+        LAB_LOG_DEBUG("Written intermediate code {}: {}", index - 1, code->toString());
     }
 }
 
@@ -66,7 +67,7 @@ void IntermCodeGenerator::recursive_iterate_ast_tree(
 
     // post-order processing of the current node
     current_node.node->data->generate_intermediate_code(logical_env_simulator);
-    spdlog::debug("Generated intermediate code for node: {}", current_node.node->data->to_string());
+    LAB_LOG_DEBUG("Generated intermediate code for node: {}", current_node.node->data->to_string());
 
     return; // return to the caller
 }
\ No newline at end of file
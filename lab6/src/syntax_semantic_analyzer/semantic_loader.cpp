@@ -9,6 +9,9 @@ syntax_semantic_model::ProductionInfoMapping load_semantic_info(const std::strin
     {
         syntax_semantic_model::ProductionInfoMapping production_info_mapping;
         YAML::Node config = YAML::LoadFile(filename);
+        // node types are also stored by production id, the ids of target_cfg
+        cfg_model_helper::number_cfg_productions(target_cfg);
+        production_info_mapping.node_types.assign(target_cfg.production_numbering.size(), "");
         int total_loaded_production_rules = 0;
 
         // load the production rules
@@ -77,6 +80,15 @@ syntax_semantic_model::ProductionInfoMapping load_semantic_info(const std::strin
             }
 
             // finalize the production rule
+            cfg_model::production_id production = target_cfg.production_numbering.id_of(lhs, rhs_symbols);
+            if (production != cfg_model::invalid_production_id)
+            {
+                production_info_mapping.node_types[production] = semantic_info;
+            }
+            else
+            {
+                spdlog::warn("Production with node type {} of {} is not a production of the CFG", semantic_info, lhs.name);
+            }
             if (is_epsilon_production)
             {
                 production_info_mapping.production_info[lhs][{}] = semantic_info;
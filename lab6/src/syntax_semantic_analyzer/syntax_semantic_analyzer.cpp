@@ -3,6 +3,36 @@
 #include "scope_table.h"
 #include "tree.hh"
 #include "spdlog/spdlog.h"
+#include "log_macros.h"
+
+namespace {
+    // reduce actions carry the grammar's production ids, so the node types stored by id must come from the same grammar
+    void check_production_ids(
+        const lr_parsing_model::LRParsingTable& parsing_table,
+        const syntax_semantic_model::ProductionInfoMapping& production_info_mapping
+    ) {
+        if (!parsing_table.production_table) {
+            return;
+        }
+        const auto& node_types = production_info_mapping.node_types;
+        for (uint32_t id = 0; id < parsing_table.production_table->size() && id < node_types.size(); ++id) {
+            if (node_types[id].empty()) {
+                continue;
+            }
+            const lr_parsing_model::Production& production = parsing_table.production_table->production(id);
+            auto lhs_it = production_info_mapping.production_info.find(production.lhs);
+            bool same = lhs_it != production_info_mapping.production_info.end();
+            if (same) {
+                auto rhs_it = lhs_it->second.find(production.rhs);
+                same = rhs_it != lhs_it->second.end() && rhs_it->second == node_types[id];
+            }
+            if (!same) {
+                spdlog::error("Production id {} ({}) of the parsing table does not match the production info mapping.", id, production.lhs.name);
+                throw std::runtime_error("Production ids of the parsing table and the production info mapping differ.");
+            }
+        }
+    }
+}
 
 std::shared_ptr<ast_model::ASTNodeContent> syntax_semantic_analyzer::create_ast_node(
     const std::string& node_type,
@@ -125,9 +155,9 @@ SyntaxSemanticAnalyzer::SyntaxSemanticAnalyzer() {
 };
 
 void SyntaxSemanticAnalyzer::reset() {
-    current_symbol_stack.clear();
     current_state_stack.clear();
     current_ast_subtree_stack.clear();
+    current_ll1_stack.clear();
     current_token_index = 0;
     symbol_table = std::make_shared<SymbolTable>();
     scope_table = std::make_shared<ScopeTable>();
@@ -137,9 +167,22 @@ void SyntaxSemanticAnalyzer::prepair_new_analysis(
     const lr_parsing_model::LRParsingTable& slr1_parsing_table,
     const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
     const std::vector<Token>& tokens
+) {
+    if (!slr1_parsing_table.filling_check()) {
+        spdlog::error("SLR(1) parsing table is not filled correctly.");
+        throw std::runtime_error("SLR(1) parsing table is not filled correctly.");
+    }
+    check_production_ids(slr1_parsing_table, production_info_mapping);
+    prepair_new_analysis(compiled_lr_table_helper::compile_lr_table(slr1_parsing_table), production_info_mapping, tokens);
+}
+
+void SyntaxSemanticAnalyzer::prepair_new_analysis(
+    const lr_parsing_model::CompiledLRTable& compiled_lr_table,
+    const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+    const std::vector<Token>& tokens
 ) {
     reset();
-    slr1_parsing_table_ref = slr1_parsing_table; // Store the parsing table
+    lr_parsing_table_ref = compiled_lr_table; // Store the parsing table
     production_info_mapping_ref = production_info_mapping; // Store the production info mapping
     tokens_ref = tokens; // Store the token stream
     input_check(); // Check the input validity
@@ -152,7 +195,16 @@ syntax_semantic_analyzer::analysis_result SyntaxSemanticAnalyzer::analyze_syntax
         const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
         const std::vector<Token>& tokens
 ){
-    prepair_new_analysis(slr1_parsing_table, production_info_mapping, tokens);
+    check_production_ids(slr1_parsing_table, production_info_mapping);
+    return analyze_syntax_semantics(compiled_lr_table_helper::compile_lr_table(slr1_parsing_table), production_info_mapping, tokens);
+}
+
+syntax_semantic_analyzer::analysis_result SyntaxSemanticAnalyzer::analyze_syntax_semantics(
+        const lr_parsing_model::CompiledLRTable& compiled_lr_table,
+        const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+        const std::vector<Token>& tokens
+){
+    prepair_new_analysis(compiled_lr_table, production_info_mapping, tokens);
     syntax_anlaysis(); // Perform syntax analysis and build the AST tree
     semantic_analysis(); // Perform semantic analysis on the AST tree
 
@@ -166,6 +218,37 @@ syntax_semantic_analyzer::analysis_result SyntaxSemanticAnalyzer::analyze_syntax
     return result;
 }
 
+void SyntaxSemanticAnalyzer::prepair_new_ll1_analysis(
+    const ll_parsing_model::LL1ParsingTable& ll1_parsing_table,
+    const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+    const std::vector<Token>& tokens
+) {
+    reset();
+    ll1_parsing_table_ref = ll1_parsing_table; // Store the parsing table
+    production_info_mapping_ref = production_info_mapping; // Store the production info mapping
+    tokens_ref = tokens; // Store the token stream
+    ll1_input_check(); // Check the input validity
+}
+
+syntax_semantic_analyzer::analysis_result SyntaxSemanticAnalyzer::analyze_syntax_semantics_ll1(
+        const ll_parsing_model::LL1ParsingTable& ll1_parsing_table,
+        const syntax_semantic_model::ProductionInfoMapping& production_info_mapping,
+        const std::vector<Token>& tokens
+){
+    prepair_new_ll1_analysis(ll1_parsing_table, production_info_mapping, tokens);
+    ll1_syntax_analysis(); // Perform predictive syntax analysis and build the AST tree
+    semantic_analysis(); // Perform semantic analysis on the AST tree
+
+    // Prepare the result
+    syntax_semantic_analyzer::analysis_result result;
+    result.ast_tree = current_ast_tree;
+    result.symbol_table = *symbol_table;
+    result.scope_table = *scope_table;
+
+    spdlog::info("Syntax and semantic analysis completed successfully.");
+    return result;
+}
+
 // get blank AST tree after syntax analysis
 tree<std::shared_ptr<ast_model::ASTNodeContent>> SyntaxSemanticAnalyzer::get_blank_ast_tree(){
     syntax_anlaysis();
@@ -174,6 +257,36 @@ tree<std::shared_ptr<ast_model::ASTNodeContent>> SyntaxSemanticAnalyzer::get_bla
 }
 
 void SyntaxSemanticAnalyzer::input_check() {
+    if (lr_parsing_table_ref.state_count == 0 || lr_parsing_table_ref.start_state == lr_parsing_model::CompiledLRTable::invalid_id) {
+        spdlog::error("LR parsing table is empty.");
+        throw std::runtime_error("LR parsing table is empty.");
+    }
+
+    std::unordered_set<cfg_model::symbol> parsing_table_terminals(lr_parsing_table_ref.terminals.begin(), lr_parsing_table_ref.terminals.end());
+    check_tokens_and_production_info(parsing_table_terminals);
+}
+
+void SyntaxSemanticAnalyzer::ll1_input_check() {
+    if (ll1_parsing_table_ref.prediction_table.empty()) {
+        spdlog::error("LL(1) parsing table is empty.");
+        throw std::runtime_error("LL(1) parsing table is empty.");
+    }
+    // conflicting cells are only an error if the parse actually reaches them
+    std::vector<ll_parsing_model::LL1Conflict> conflicts = ll1_parsing_table_ref.find_conflicts();
+    if (!conflicts.empty()) {
+        spdlog::warn("LL(1) parsing table has {} conflicting cells.", conflicts.size());
+    }
+
+    std::unordered_set<cfg_model::symbol> parsing_table_terminals;
+    for (const auto& symbol : ll1_parsing_table_ref.all_symbols) {
+        if (symbol.is_terminal) {
+            parsing_table_terminals.insert(symbol);
+        }
+    }
+    check_tokens_and_production_info(parsing_table_terminals);
+}
+
+void SyntaxSemanticAnalyzer::check_tokens_and_production_info(const std::unordered_set<cfg_model::symbol>& table_terminals) {
     if (tokens_ref.empty()) {
         spdlog::error("Token stream is empty.");
         throw std::runtime_error("Token stream is empty.");
@@ -182,24 +295,14 @@ void SyntaxSemanticAnalyzer::input_check() {
         spdlog::error("Production info mapping is empty.");
         throw std::runtime_error("Production info mapping is empty.");
     }
-    if (!slr1_parsing_table_ref.filling_check()) {
-        spdlog::error("SLR(1) parsing table is not filled correctly.");
-        throw std::runtime_error("SLR(1) parsing table is not filled correctly.");
-    }
 
     // check if each token type could be translated to parsing table symbol
-    std::unordered_set<cfg_model::symbol> parsing_table_terminals;
-    for (const auto& symbol : slr1_parsing_table_ref.all_symbols) {
-        if (symbol.is_terminal) {
-            parsing_table_terminals.insert(symbol);
-        }
-    }
     for (const auto& token : tokens_ref) {
         cfg_model::symbol token_symbol;
         token_symbol.name = token.type;
         token_symbol.is_terminal = true; // Tokens are always terminal symbols
         token_symbol.special_property = ""; // No special property for tokens
-        if (parsing_table_terminals.find(token_symbol) == parsing_table_terminals.end()) {
+        if (table_terminals.find(token_symbol) == table_terminals.end()) {
             spdlog::error("Token type '{}' is not found in the parsing table symbols.", token.type);
             throw std::runtime_error("Token type is not found in the parsing table symbols.");
         }
@@ -231,160 +334,99 @@ void SyntaxSemanticAnalyzer::input_check() {
 
 void SyntaxSemanticAnalyzer::syntax_anlaysis() {
     spdlog::info("Starting syntax analysis...");
+    using lr_parsing_model::CompiledLRTable;
+    const CompiledLRTable& table = lr_parsing_table_ref;
     // Initialize the parsing stacks
-    current_symbol_stack.clear();
     current_state_stack.clear();
     current_ast_subtree_stack.clear();
     
-    // Initialize the start state and symbol stack
-    current_state_stack.push_back(slr1_parsing_table_ref.start_state);
+    // Initialize the start state
+    current_state_stack.push_back(table.start_state);
     
-    // find the end symbol in the parsing table
-    cfg_model::symbol end_symbol;
-    bool end_symbol_found = false;
-    for (const auto& symbol : slr1_parsing_table_ref.all_symbols) {
-        if (symbol.special_property == "END") {
-            end_symbol = symbol;
-            end_symbol_found = true;
-            break;
-        }
-    }
-    if (!end_symbol_found) {
+    // the end symbol of the parsing table
+    if (table.end_terminal == CompiledLRTable::invalid_id) {
         spdlog::error("End symbol not found in the parsing table.");
         throw std::runtime_error("End symbol not found in the parsing table.");
     }
     Token end_token;
-    end_token.type = end_symbol.name;
+    end_token.type = table.terminals[table.end_terminal].name;
     end_token.value = ""; // End token has no value
     tokens_ref.push_back(end_token); // Add the end token to the token stream
 
+    // token type -> terminal id, once per token before parsing
+    std::vector<uint32_t> token_terminals;
+    token_terminals.reserve(tokens_ref.size());
+    for (const auto& token : tokens_ref) {
+        uint32_t terminal = table.find_terminal(token.type);
+        if (terminal == CompiledLRTable::invalid_id) {
+            spdlog::error("Current token '{}' is not found in the parsing table symbols.", token.type);
+            throw std::runtime_error("Current token is not found in the parsing table symbols.");
+        }
+        token_terminals.push_back(terminal);
+    }
+
     // start parsing
     bool accepted = false;
     while (current_token_index < tokens_ref.size()) {
         // Get the current token
         const Token& current_token = tokens_ref[current_token_index];
-        cfg_model::symbol current_symbol;
-        // lookup the current token in the parsing table using token type
-        bool symbol_found = false;
-        for (const auto& symbol : slr1_parsing_table_ref.all_symbols) {
-            if (symbol.name == current_token.type && symbol.is_terminal) {
-                current_symbol = symbol;
-                symbol_found = true;
-                break;
-            }
-        }
-        if (!symbol_found) {
-            spdlog::error("Current token '{}' is not found in the parsing table symbols.", current_token.type);
-            throw std::runtime_error("Current token is not found in the parsing table symbols.");
-        }
-        spdlog::debug("Current token: {}, index: {}", current_token.type, current_token_index);
+        uint32_t current_terminal = token_terminals[current_token_index];
+        LAB_LOG_DEBUG("Current token: {}, index: {}", current_token.type, current_token_index);
 
-        // get the current action set using the current state and current symbol
-        std::unordered_set<lr_parsing_model::Action> actions = slr1_parsing_table_ref.get_actions(current_state_stack.back(), current_symbol);
-        if (actions.empty()) {
-            spdlog::error("No actions found for state '{}' and symbol '{}'.", current_state_stack.back(), current_symbol.name);
-            throw std::runtime_error("No actions found for current state and symbol.");
-        }
-        else if (actions.size() > 1) {
-            spdlog::error("Multiple actions found for state '{}' and symbol '{}'.", current_state_stack.back(), current_symbol.name);
-            throw std::runtime_error("Multiple actions found for current state and symbol.");
-        }
-        lr_parsing_model::Action current_action = *actions.begin();
-        spdlog::debug("Current action: {}", current_action.action_type);
-        // Perform the action based on its type
-        if (current_action.action_type == "empty")
-        {
-            // parsing failed due to empty action
-            spdlog::error("Parsing failed due to empty action for state '{}' and symbol '{}'.", current_state_stack.back(), current_symbol.name);
-            throw std::runtime_error("Parsing failed due to empty action.");
-        }
-        else if (current_action.action_type == "shift")
-        {
-            // Shift action: push the current token onto the symbol stack and state stack
-            current_symbol_stack.push_back(current_symbol);
-            current_state_stack.push_back(current_action.target_state);
+        // get the current action using the current state and current terminal
+        int32_t current_action = table.action(current_state_stack.back(), current_terminal);
+        LAB_LOG_DEBUG("Current action: {}", current_action);
+        // Perform the action based on its kind
+        switch (CompiledLRTable::action_kind(current_action)) {
+        case CompiledLRTable::SHIFT: {
+            // Shift action: push the target state
+            uint32_t target_state = CompiledLRTable::action_value(current_action);
+            current_state_stack.push_back(target_state);
             // Create a new AST node for the current token
-            auto ast_node = std::make_shared<ast_model::TerminalNode>(current_token.type, current_token.value);
-            tree<std::shared_ptr<ast_model::ASTNodeContent>> ast_subtree;
-            ast_subtree.set_head(ast_node);
-            current_ast_subtree_stack.push_back(ast_subtree);
-            spdlog::debug("Shifted token '{}' to state '{}'.", current_token.type, current_action.target_state);
+            shift_ast_leaf(current_token);
+            LAB_LOG_DEBUG("Shifted token '{}' to state '{}'.", current_token.type, table.state_names[target_state]);
             // Move to the next token
             current_token_index++;
+            break;
         }
-        else if (current_action.action_type == "reduce")
-        {
-            // Reduce action: pop symbols from the symbol stack according to the rule's right-hand side
-            const auto& lhs = current_action.reduce_rule_lhs;
-            const std::vector<cfg_model::symbol>& rhs = current_action.reduce_rule_rhs;
-            std::string rhs_str;
-            for (const auto& symbol : rhs) {
-                rhs_str += symbol.name + " ";
-            }
-            spdlog::debug("Reduce action: LHS: {}, RHS: {}", lhs.name, rhs_str);
-            
-            int rhs_size = rhs.size();
-            if (rhs_size > current_symbol_stack.size()) {
+        case CompiledLRTable::REDUCE: {
+            // Reduce action: pop one state per symbol of the rule's right-hand side, then goto on its left-hand side
+            uint32_t production_id = CompiledLRTable::action_value(current_action);
+            const CompiledLRTable::Production& production = table.productions[production_id];
+            LAB_LOG_DEBUG("Reduce action: production {}, LHS: {}, RHS length: {}", production_id, table.non_terminals[production.lhs].name, production.rhs_length);
+
+            size_t rhs_size = production.rhs_length;
+            if (rhs_size >= current_state_stack.size()) {
                 spdlog::error("Not enough symbols in the stack to perform reduce action.");
                 throw std::runtime_error("Not enough symbols in the stack to perform reduce action.");
             }
-            // pop symbol stack & append lhs to the symbol stack
-            current_symbol_stack.resize(current_symbol_stack.size() - rhs_size);
-            current_symbol_stack.push_back(lhs);
-            // pop state stack & append new state to the state stack
             current_state_stack.resize(current_state_stack.size() - rhs_size);
-            std::unordered_set<std::string> new_states = slr1_parsing_table_ref.get_gotos(current_state_stack.back(), lhs);
-            if (new_states.size() != 1) {
-                spdlog::error("Reduce action for state '{}' and symbol '{}' resulted in multiple or no new states.", current_state_stack.back(), lhs.name);
+            uint32_t new_state = table.goto_state(current_state_stack.back(), production.lhs);
+            if (new_state == CompiledLRTable::invalid_id) {
+                spdlog::error("Reduce action for state '{}' and symbol '{}' resulted in no new state.", table.state_names[current_state_stack.back()], table.non_terminals[production.lhs].name);
                 throw std::runtime_error("Reduce action resulted in multiple or no new states.");
             }
-            std::string new_state = *new_states.begin();
             current_state_stack.push_back(new_state);
             // pop AST subtree stack & grazp the subtrees for the right-hand side
-            // look up the production info to get the node type
-            std::string node_type_str = production_info_mapping_ref.get_node_type(lhs, rhs);
-            ast_model::ASTNodeType node_type = ast_model::string_to_ast_node_type(node_type_str);
-            // create a new AST subtree
-            tree<std::shared_ptr<ast_model::ASTNodeContent>> ast_subtree;
-            auto ast_node = syntax_semantic_analyzer::create_ast_node(node_type_str);
-            ast_subtree.set_head(ast_node);
-        
-            std::vector<tree<std::shared_ptr<ast_model::ASTNodeContent>>> rhs_subtrees;
-            for (int i = 0; i < rhs_size; ++i) {
-                if (current_ast_subtree_stack.empty()) {
-                    spdlog::error("Not enough AST subtrees to perform reduce action.");
-                    throw std::runtime_error("Not enough AST subtrees to perform reduce action.");
-                }
-                rhs_subtrees.push_back(current_ast_subtree_stack.back());
-                current_ast_subtree_stack.pop_back();
-            }
-            // reverse the order of the subtrees
-            std::reverse(rhs_subtrees.begin(), rhs_subtrees.end());
-            // start grafting the subtrees
-            std::vector<std::shared_ptr<ast_model::ASTNodeContent>> sub_ast_contents;
-            int children_counter = 0;
-            for (auto& subtree : rhs_subtrees) {
-                sub_ast_contents.push_back(subtree.head->data);
-                ast_subtree.move_in_as_nth_child(ast_subtree.begin(), children_counter, subtree);
-                children_counter++;
-            };
-            // now we have the complete subtree for the current production, start taking in the subnodes
-            ast_node->subnode_takein(sub_ast_contents);
-            // push the new subtree to the AST subtree stack
-            current_ast_subtree_stack.push_back(ast_subtree);
-            spdlog::debug("Reduced to node type '{}'.", node_type_str);
+            reduce_ast_subtrees(production_info_mapping_ref.get_node_type(production_id), rhs_size);
+            break;
         }
-        else if (current_action.action_type == "accept")
-        {
+        case CompiledLRTable::ACCEPT:
             // Accept action: parsing is successful
             accepted = true;
             spdlog::info("Parsing accepted.");
             break;
+        default:
+            if (current_action == CompiledLRTable::conflict_action) {
+                spdlog::error("Multiple actions found for state '{}' and symbol '{}'.", table.state_names[current_state_stack.back()], current_token.type);
+                throw std::runtime_error("Multiple actions found for current state and symbol.");
+            }
+            // parsing failed due to empty action
+            spdlog::error("Parsing failed due to empty action for state '{}' and symbol '{}'.", table.state_names[current_state_stack.back()], current_token.type);
+            throw std::runtime_error("Parsing failed due to empty action.");
         }
-        else
-        {
-            spdlog::error("Unknown action type: {}", current_action.action_type);
-            throw std::runtime_error("Unknown action type.");
+        if (accepted) {
+            break;
         }
     }
 
@@ -404,6 +446,140 @@ void SyntaxSemanticAnalyzer::syntax_anlaysis() {
     spdlog::info("Syntax analysis completed successfully.");
 }
 
+void SyntaxSemanticAnalyzer::ll1_syntax_analysis() {
+    spdlog::info("Starting LL(1) syntax analysis...");
+    current_ll1_stack.clear();
+    current_ast_subtree_stack.clear();
+
+    const cfg_model::symbol& end_symbol = ll1_parsing_table_ref.end_symbol;
+    if (end_symbol.special_property != "END") {
+        spdlog::error("End symbol not found in the LL(1) parsing table.");
+        throw std::runtime_error("End symbol not found in the LL(1) parsing table.");
+    }
+    Token end_token;
+    end_token.type = end_symbol.name;
+    end_token.value = ""; // End token has no value
+    tokens_ref.push_back(end_token); // Add the end token to the token stream
+
+    // token type -> terminal, looked up once instead of scanning the symbols for every token
+    std::unordered_map<std::string, cfg_model::symbol> terminals_by_name;
+    for (const auto& symbol : ll1_parsing_table_ref.all_symbols) {
+        if (symbol.is_terminal) {
+            terminals_by_name.emplace(symbol.name, symbol);
+        }
+    }
+
+    // the stack only holds symbols still to be matched and node markers, no states
+    current_ll1_stack.push_back({end_symbol, nullptr});
+    current_ll1_stack.push_back({ll1_parsing_table_ref.start_symbol, nullptr});
+
+    bool accepted = false;
+    while (!current_ll1_stack.empty()) {
+        syntax_semantic_analyzer::ll1_stack_entry top = current_ll1_stack.back();
+        current_ll1_stack.pop_back();
+
+        // every symbol of the production has been matched, build its node exactly like an LR reduce
+        if (top.reduce_rhs != nullptr) {
+            reduce_ast_subtrees(production_info_mapping_ref.get_node_type(top.symbol, *top.reduce_rhs), top.reduce_rhs->size());
+            continue;
+        }
+
+        if (current_token_index >= tokens_ref.size()) {
+            spdlog::error("Token stream ended while '{}' was still expected.", top.symbol.name);
+            throw std::runtime_error("Token stream ended before parsing was finished.");
+        }
+        const Token& current_token = tokens_ref[current_token_index];
+        auto symbol_it = terminals_by_name.find(current_token.type);
+        if (symbol_it == terminals_by_name.end()) {
+            spdlog::error("Current token '{}' is not found in the parsing table symbols.", current_token.type);
+            throw std::runtime_error("Current token is not found in the parsing table symbols.");
+        }
+        const cfg_model::symbol& current_symbol = symbol_it->second;
+        LAB_LOG_DEBUG("Current token: {}, index: {}, stack top: {}", current_token.type, current_token_index, top.symbol.name);
+
+        if (top.symbol.is_terminal) {
+            if (!(top.symbol == current_symbol)) {
+                spdlog::error("Parsing failed: expected '{}' but found '{}' at token index {}.", top.symbol.name, current_token.type, current_token_index);
+                throw std::runtime_error("Parsing failed due to unexpected token.");
+            }
+            if (top.symbol == end_symbol) {
+                accepted = true;
+                spdlog::info("Parsing accepted.");
+                break;
+            }
+            shift_ast_leaf(current_token);
+            current_token_index++;
+            continue;
+        }
+
+        const std::unordered_set<std::vector<cfg_model::symbol>>* predictions = ll1_parsing_table_ref.get_predictions(top.symbol, current_symbol);
+        if (predictions == nullptr) {
+            spdlog::error("No prediction found for non-terminal '{}' and symbol '{}'.", top.symbol.name, current_symbol.name);
+            throw std::runtime_error("No prediction found for current non-terminal and symbol.");
+        }
+        else if (predictions->size() > 1) {
+            spdlog::error("Multiple predictions found for non-terminal '{}' and symbol '{}'.", top.symbol.name, current_symbol.name);
+            throw std::runtime_error("Multiple predictions found for current non-terminal and symbol.");
+        }
+        const std::vector<cfg_model::symbol>& rhs = *predictions->begin();
+        // the marker goes below the rhs, so it is popped right after the last rhs symbol is matched
+        current_ll1_stack.push_back({top.symbol, &rhs});
+        for (auto it = rhs.rbegin(); it != rhs.rend(); ++it) {
+            current_ll1_stack.push_back({*it, nullptr});
+        }
+    }
+
+    if (!accepted) {
+        spdlog::error("Parsing failed. End symbol was never matched.");
+        throw std::runtime_error("Parsing failed. End symbol was never matched.");
+    }
+    if (current_ast_subtree_stack.size() != 1) {
+        spdlog::error("Parsing failed. Expected one AST subtree, but found {}.", current_ast_subtree_stack.size());
+        throw std::runtime_error("Parsing failed. Expected one AST subtree.");
+    }
+    current_ast_tree = current_ast_subtree_stack.back();
+    spdlog::info("LL(1) syntax analysis completed successfully.");
+}
+
+void SyntaxSemanticAnalyzer::shift_ast_leaf(const Token& token) {
+    auto ast_node = std::make_shared<ast_model::TerminalNode>(token.type, token.value);
+    tree<std::shared_ptr<ast_model::ASTNodeContent>> ast_subtree;
+    ast_subtree.set_head(ast_node);
+    current_ast_subtree_stack.push_back(ast_subtree);
+}
+
+void SyntaxSemanticAnalyzer::reduce_ast_subtrees(const std::string& node_type_str, size_t rhs_size) {
+    // create a new AST subtree
+    tree<std::shared_ptr<ast_model::ASTNodeContent>> ast_subtree;
+    auto ast_node = syntax_semantic_analyzer::create_ast_node(node_type_str);
+    ast_subtree.set_head(ast_node);
+
+    std::vector<tree<std::shared_ptr<ast_model::ASTNodeContent>>> rhs_subtrees;
+    for (size_t i = 0; i < rhs_size; ++i) {
+        if (current_ast_subtree_stack.empty()) {
+            spdlog::error("Not enough AST subtrees to perform reduce action.");
+            throw std::runtime_error("Not enough AST subtrees to perform reduce action.");
+        }
+        rhs_subtrees.push_back(current_ast_subtree_stack.back());
+        current_ast_subtree_stack.pop_back();
+    }
+    // reverse the order of the subtrees
+    std::reverse(rhs_subtrees.begin(), rhs_subtrees.end());
+    // start grafting the subtrees
+    std::vector<std::shared_ptr<ast_model::ASTNodeContent>> sub_ast_contents;
+    int children_counter = 0;
+    for (auto& subtree : rhs_subtrees) {
+        sub_ast_contents.push_back(subtree.head->data);
+        ast_subtree.move_in_as_nth_child(ast_subtree.begin(), children_counter, subtree);
+        children_counter++;
+    };
+    // now we have the complete subtree for the current production, start taking in the subnodes
+    ast_node->subnode_takein(sub_ast_contents);
+    // push the new subtree to the AST subtree stack
+    current_ast_subtree_stack.push_back(ast_subtree);
+    LAB_LOG_DEBUG("Reduced to node type '{}'.", node_type_str);
+}
+
 void SyntaxSemanticAnalyzer::semantic_analysis() {
     spdlog::info("Starting semantic analysis...");
     // Start semantic analysis from the root of the AST
@@ -411,7 +587,7 @@ void SyntaxSemanticAnalyzer::semantic_analysis() {
         spdlog::error("AST tree is empty. Cannot perform semantic analysis.");
         throw std::runtime_error("AST tree is empty.");
     }
-    spdlog::debug("Iterating through the AST tree with {} nodes.", current_ast_tree.size());
+    LAB_LOG_DEBUG("Iterating through the AST tree with {} nodes.", current_ast_tree.size());
     // Prepair scope table and symbol table
     scope_table->reset(); // Reset the scope table
     // start iterating through the AST tree
@@ -454,19 +630,19 @@ void SyntaxSemanticAnalyzer::recursive_iterate_ast_tree(
     // The below comment is WRONG:
     // "IF THIS IS A LEAF NODE, IT MEANS THIS IS A TERMINAL NODE, AND WE SHOULD NOT CALL THE SEMANTIC ACTION" <-- this statement is not true, because nodes with epsilon productions are also leaf nodes, and they should not call the semantic action
     if (children == 0) {
-        spdlog::debug("Current node is a leaf node.");
+        LAB_LOG_DEBUG("Current node is a leaf node.");
         // perform semantic action for leaf nodes
     }
     // 1. subnode takein 2. semantic action
     // take in the subnodes for the current node
     current_node.node->data->subnode_takein(subnodes);
-    spdlog::debug("Taking in {} subnodes for node type: {}", subnodes.size(), ast_model::ast_node_type_to_string(current_node.node->data->node_type));
+    LAB_LOG_DEBUG("Taking in {} subnodes for node type: {}", subnodes.size(), ast_model::ast_node_type_to_string(current_node.node->data->node_type));
     current_node.node->data->semantic_action(
         scope_table->getCurrentScope(),
         symbol_table,
         scope_table
     );
-    spdlog::debug("Processed AST node: {}", current_node.node->data->to_string());
+    LAB_LOG_DEBUG("Processed AST node: {}", current_node.node->data->to_string());
 
     return;
 }
\ No newline at end of file
@@ -28,4 +28,12 @@ std::string ProductionInfoMapping::get_node_type(const cfg_model::symbol& lhs, c
         throw;
     }
 }
+
+const std::string& ProductionInfoMapping::get_node_type(cfg_model::production_id production) const {
+    if (production >= node_types.size() || node_types[production].empty()) {
+        spdlog::error("No node type found for production id {}", production);
+        throw std::runtime_error("No node type found for the given production id.");
+    }
+    return node_types[production];
+}
 } // namespace syntax_semantic_model
\ No newline at end of file
@@ -0,0 +1,103 @@
+// command-line tool for binary LR table files
+//   lr_table_tool generate <grammar.yml> <generator> <table file>
+//   lr_table_tool inspect <table file> [--cells]
+//   lr_table_tool check <grammar.yml> <generator> <table file>
+// generators: simple_lr, slr1, lr1, lr1_pager, lalr1
+#include "lr_table_file.h"
+#include "yaml_cfg_loader.h"
+#include "spdlog/spdlog.h"
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    int print_usage()
+    {
+        std::cerr << "usage:\n"
+                  << "  lr_table_tool generate <grammar.yml> <generator> <table file>\n"
+                  << "  lr_table_tool inspect <table file> [--cells]\n"
+                  << "  lr_table_tool check <grammar.yml> <generator> <table file>\n"
+                  << "generators: simple_lr, slr1, lr1, lr1_pager, lalr1\n";
+        return 2;
+    }
+
+    // generate from the grammar unconditionally and write the file
+    int generate(const std::string &grammar_path, const std::string &generator, const std::string &table_path)
+    {
+        lr_parsing_model::LRTableFileKey key;
+        key.generator = lr_table_file_helper::parse_generator_name(generator);
+        key.grammar_hash = lr_table_file_helper::hash_grammar_file(grammar_path);
+        YAML_CFG_Loader cfg_loader;
+        cfg_model::CFG cfg = cfg_loader.LoadCFG(grammar_path);
+        lr_parsing_model::LRParsingTable parsing_table = lr_table_file_helper::generate_parsing_table(cfg, key.generator);
+        size_t conflict_count = parsing_table.find_conflicts().size();
+        if (conflict_count > 0)
+        {
+            std::cerr << "warning: " << conflict_count << " conflicting cells, stored as errors\n";
+        }
+        lr_table_file_helper::write_table_file(table_path, key, parsing_table);
+        std::cout << lr_table_file_helper::describe_table(lr_table_file_helper::read_table_file(table_path));
+        return 0;
+    }
+
+    int inspect(const std::string &table_path, bool with_cells)
+    {
+        std::cout << lr_table_file_helper::describe_table(lr_table_file_helper::read_table_file(table_path), with_cells);
+        return 0;
+    }
+
+    // exit code 0 if the file is up to date with the grammar, 1 otherwise
+    int check(const std::string &grammar_path, const std::string &generator, const std::string &table_path)
+    {
+        lr_parsing_model::LRTableFileKey key;
+        key.generator = lr_table_file_helper::parse_generator_name(generator);
+        key.grammar_hash = lr_table_file_helper::hash_grammar_file(grammar_path);
+        try
+        {
+            lr_parsing_model::MappedLRTableFile mapped_file(table_path);
+            if (mapped_file.key() == key)
+            {
+                std::cout << table_path << " is up to date\n";
+                return 0;
+            }
+            std::cout << table_path << " is stale\n";
+        }
+        catch (const std::exception &e)
+        {
+            std::cout << table_path << " is unusable: " << e.what() << "\n";
+        }
+        return 1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    spdlog::set_level(spdlog::level::warn);
+    if (argc < 2)
+    {
+        return print_usage();
+    }
+    std::string command = argv[1];
+    try
+    {
+        if (command == "generate" && argc == 5)
+        {
+            return generate(argv[2], argv[3], argv[4]);
+        }
+        if (command == "inspect" && (argc == 3 || (argc == 4 && std::string(argv[3]) == "--cells")))
+        {
+            return inspect(argv[2], argc == 4);
+        }
+        if (command == "check" && argc == 5)
+        {
+            return check(argv[2], argv[3], argv[4]);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return print_usage();
+}
@@ -0,0 +1,121 @@
+// writes an LR table as a C++ header of constexpr arrays, to be driven by lr_parsing_model::StaticLRParser
+//   tablegen <grammar.yml> <generator> <struct name> <output.h> [--semantic <semantic.yml>] [--recursive-ascent]
+// generators: simple_lr, slr1, lr1, lr1_pager, lalr1
+// with --semantic the header also carries the AST node type of every production,
+// with --recursive-ascent it also holds <struct name>::RecursiveAscentParser, the table turned into code
+// the output is only rewritten when its contents change, so dependents are not rebuilt for nothing
+#include "lr_table_codegen.h"
+#include "lr_table_file.h"
+#include "compiled_lr_table.h"
+#include "yaml_cfg_loader.h"
+#include "semantic_loader.h"
+#include "ast_model.h"
+#include "spdlog/spdlog.h"
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+    int print_usage()
+    {
+        std::cerr << "usage:\n"
+                  << "  tablegen <grammar.yml> <generator> <struct name> <output.h> [--semantic <semantic.yml>] [--recursive-ascent]\n"
+                  << "generators: simple_lr, slr1, lr1, lr1_pager, lalr1\n";
+        return 2;
+    }
+
+    int generate(const std::string &grammar_path, const std::string &generator, const std::string &table_name,
+                 const std::string &output_path, const std::string &semantic_path, bool recursive_ascent)
+    {
+        lr_parsing_model::StoredLRTable table;
+        table.key.generator = lr_table_file_helper::parse_generator_name(generator);
+        table.key.grammar_hash = lr_table_file_helper::hash_grammar_file(grammar_path);
+        YAML_CFG_Loader cfg_loader;
+        cfg_model::CFG cfg = cfg_loader.LoadCFG(grammar_path);
+        lr_parsing_model::LRParsingTable parsing_table = lr_table_file_helper::generate_parsing_table(cfg, table.key.generator);
+        size_t conflict_count = parsing_table.find_conflicts().size();
+        if (conflict_count > 0)
+        {
+            std::cerr << "warning: " << conflict_count << " conflicting cells, stored as errors\n";
+        }
+        table.compiled_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+        table.production_table = parsing_table.production_table;
+
+        lr_table_codegen_helper::TableHeaderOptions options;
+        options.table_name = table_name;
+        options.source = std::filesystem::path(grammar_path).filename().string() + " (" + generator + ")";
+        if (!semantic_path.empty())
+        {
+            // production ids are the grammar's, the same for the semantic file's cfg
+            options.node_type_names = load_semantic_info(semantic_path, cfg).node_types;
+            for (const auto &node_type : options.node_type_names)
+            {
+                options.node_type_ids.push_back(node_type.empty() ? lr_table_codegen_helper::no_node_type
+                                                                  : static_cast<int32_t>(ast_model::string_to_ast_node_type(node_type)));
+            }
+        }
+        std::string header = recursive_ascent ? lr_table_codegen_helper::generate_recursive_ascent_header(parsing_table, table.key, options)
+                                              : lr_table_codegen_helper::generate_table_header(table, options);
+
+        std::ifstream existing_file(output_path, std::ios::binary);
+        if (existing_file && std::string(std::istreambuf_iterator<char>(existing_file), std::istreambuf_iterator<char>()) == header)
+        {
+            return 0;
+        }
+        existing_file.close();
+        std::filesystem::path output_dir = std::filesystem::path(output_path).parent_path();
+        if (!output_dir.empty())
+        {
+            std::filesystem::create_directories(output_dir);
+        }
+        std::ofstream output_file(output_path, std::ios::binary | std::ios::trunc);
+        output_file << header;
+        if (!output_file)
+        {
+            throw std::runtime_error("cannot write " + output_path);
+        }
+        std::cout << "wrote " << output_path << ": " << table.compiled_table.state_count << " states, "
+                  << table.compiled_table.productions.size() << " productions\n";
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    spdlog::set_level(spdlog::level::warn);
+    if (argc < 5)
+    {
+        return print_usage();
+    }
+    std::string semantic_path;
+    bool recursive_ascent = false;
+    for (int i = 5; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if (option == "--semantic" && i + 1 < argc)
+        {
+            semantic_path = argv[++i];
+        }
+        else if (option == "--recursive-ascent")
+        {
+            recursive_ascent = true;
+        }
+        else
+        {
+            return print_usage();
+        }
+    }
+    try
+    {
+        return generate(argv[1], argv[2], argv[3], argv[4], semantic_path, recursive_ascent);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+}
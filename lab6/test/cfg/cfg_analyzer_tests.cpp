@@ -6,6 +6,7 @@
 #include "spdlog/spdlog.h"
 #include "lr_parsing_model.h"
 #include "itemset_generator.h"
+#include <chrono>
 
 // create a fixture for log handling
 class CFGAnalyzerTests : public ::testing::Test
@@ -197,4 +198,256 @@ TEST_F(CFGAnalyzerTests, TestComputeFollowSet2)
     ASSERT_NO_THROW(cfg_analyzer.computeFollowSet());
     cfg_model::FollowSet follow_set = cfg_analyzer.getFollowSet();
     verify_follow_set(follow_set, cfg, filename);
-}
\ No newline at end of file
+}
+TEST_F(CFGAnalyzerTests, TestComputeFirstSet3)
+{
+    std::string filename = "test/data/cfg/cfg_analyzer/cfg_3.yml";
+
+    cfg_model::CFG cfg = load_test_cfg(filename);
+    cfg = itemset_generator_helper::expand_cfg(cfg);
+    CFGAnalyzer cfg_analyzer(cfg);
+    ASSERT_NO_THROW(cfg_analyzer.computeFirstSet());
+    cfg_model::FirstSet first_set = cfg_analyzer.getFirstSet();
+    verify_first_set(first_set, cfg, filename);
+    // S -> A B c can not vanish even though A and B can
+    cfg_model::symbol s_symbol{"S", false, ""};
+    EXPECT_EQ(first_set.symbols_with_epsilon.count(s_symbol), 0u);
+}
+
+TEST_F(CFGAnalyzerTests, TestComputeFollowSet3)
+{
+    std::string filename = "test/data/cfg/cfg_analyzer/cfg_3.yml";
+
+    cfg_model::CFG cfg = load_test_cfg(filename);
+    cfg = itemset_generator_helper::expand_cfg(cfg);
+    CFGAnalyzer cfg_analyzer(cfg);
+    cfg_analyzer.computeFirstSet();
+    ASSERT_NO_THROW(cfg_analyzer.computeFollowSet());
+    cfg_model::FollowSet follow_set = cfg_analyzer.getFollowSet();
+    verify_follow_set(follow_set, cfg, filename);
+}
+
+TEST_F(CFGAnalyzerTests, TestLongNullableCycle)
+{
+    // N_i -> N_{i+1} t_i | ε for i < n-1, N_{n-1} -> t_{n-1} | N_0 | ε
+    // all non-terminals form one cycle, so every FIRST set holds every terminal
+    const int n = 300;
+    cfg_model::CFG cfg;
+    std::vector<cfg_model::symbol> non_terminals, terminals;
+    for (int i = 0; i < n; ++i)
+    {
+        non_terminals.push_back({"N" + std::to_string(i), false, ""});
+        terminals.push_back({"t" + std::to_string(i), true, ""});
+        cfg.non_terminals.insert(non_terminals.back());
+        cfg.terminals.insert(terminals.back());
+        cfg.epsilon_production_symbols.insert(non_terminals.back());
+    }
+    cfg.start_symbol = non_terminals[0];
+    for (int i = 0; i + 1 < n; ++i)
+    {
+        cfg.production_rules[non_terminals[i]].insert({non_terminals[i + 1], terminals[i]});
+    }
+    cfg.production_rules[non_terminals[n - 1]].insert({terminals[n - 1]});
+    cfg.production_rules[non_terminals[n - 1]].insert({non_terminals[0]});
+    cfg = itemset_generator_helper::expand_cfg(cfg);
+
+    CFGAnalyzer cfg_analyzer(cfg);
+    cfg_analyzer.computeFirstSet();
+    cfg_analyzer.computeFollowSet();
+    const cfg_model::FirstSet &first_set = cfg_analyzer.getFirstSet();
+    const cfg_model::FollowSet &follow_set = cfg_analyzer.getFollowSet();
+    for (int i = 0; i < n; ++i)
+    {
+        EXPECT_EQ(first_set.first_set.at(non_terminals[i]).size(), static_cast<size_t>(n)) << "FIRST of N" << i;
+        EXPECT_EQ(first_set.symbols_with_epsilon.count(non_terminals[i]), 1u);
+    }
+    // N_{i+1} is always followed by t_i, N_0 only ends N_{n-1} and the start rule
+    for (int i = 0; i + 1 < n; ++i)
+    {
+        EXPECT_EQ(follow_set.follow_set.at(non_terminals[i + 1]), std::unordered_set<cfg_model::symbol>({terminals[i]}));
+    }
+    EXPECT_EQ(follow_set.follow_set.at(non_terminals[0]), std::unordered_set<cfg_model::symbol>({terminals[n - 2], follow_set.end_symbol}));
+}
+
+TEST_F(CFGAnalyzerTests, TestSuffixFirstSets)
+{
+    std::string filename = "test/data/cfg/cfg_analyzer/cfg_3.yml";
+
+    cfg_model::CFG cfg = load_test_cfg(filename);
+    cfg = itemset_generator_helper::expand_cfg(cfg);
+    CFGAnalyzer cfg_analyzer(cfg);
+    // suffix first sets need the first set
+    ASSERT_THROW(cfg_analyzer.computeSuffixFirstSets(), std::runtime_error);
+    cfg_analyzer.computeFirstSet();
+    ASSERT_NO_THROW(cfg_analyzer.computeSuffixFirstSets());
+
+    auto t = [](const std::string &name) { return cfg_model::symbol{name, true, ""}; };
+    auto nt = [](const std::string &name) { return cfg_model::symbol{name, false, ""}; };
+    auto names_of = [&](const cfg_model::TerminalSet &bits)
+    {
+        std::unordered_set<std::string> names;
+        bits.for_each([&](size_t bit) { names.insert(cfg_analyzer.getTerminalOfBit(bit).name); });
+        return names;
+    };
+
+    // S -> A B c
+    uint32_t s_production = cfg_analyzer.getProductionIndex(nt("S"), {nt("A"), nt("B"), t("c")});
+    ASSERT_NE(s_production, cfg_model::invalid_symbol_id);
+    EXPECT_EQ(names_of(cfg_analyzer.getSuffixFirst(s_production, 0)), (std::unordered_set<std::string>{"a", "c", "d", "e"}));
+    EXPECT_FALSE(cfg_analyzer.isSuffixNullable(s_production, 0));
+    EXPECT_EQ(names_of(cfg_analyzer.getSuffixFirst(s_production, 1)), (std::unordered_set<std::string>{"c", "d", "e"}));
+    EXPECT_EQ(names_of(cfg_analyzer.getSuffixFirst(s_production, 2)), (std::unordered_set<std::string>{"c"}));
+    EXPECT_TRUE(names_of(cfg_analyzer.getSuffixFirst(s_production, 3)).empty());
+    EXPECT_TRUE(cfg_analyzer.isSuffixNullable(s_production, 3));
+
+    // B -> C D can vanish entirely
+    uint32_t b_production = cfg_analyzer.getProductionIndex(nt("B"), {nt("C"), nt("D")});
+    ASSERT_NE(b_production, cfg_model::invalid_symbol_id);
+    EXPECT_EQ(names_of(cfg_analyzer.getSuffixFirst(b_production, 0)), (std::unordered_set<std::string>{"d", "e"}));
+    EXPECT_TRUE(cfg_analyzer.isSuffixNullable(b_production, 0));
+    EXPECT_TRUE(cfg_analyzer.isSuffixNullable(b_production, 1));
+
+    // epsilon productions have an empty rhs, unknown productions are reported as invalid
+    EXPECT_NE(cfg_analyzer.getProductionIndex(nt("A"), {}), cfg_model::invalid_symbol_id);
+    EXPECT_EQ(cfg_analyzer.getProductionIndex(nt("A"), {t("c")}), cfg_model::invalid_symbol_id);
+    EXPECT_EQ(cfg_analyzer.getTerminalBit(nt("A")), cfg_model::invalid_symbol_id);
+}
+
+namespace
+{
+    // synthetic grammar made of block_count blocks of block_size non-terminals
+    // productions mostly refer to their own block (cycles), sometimes to a later block (levels) and sometimes vanish
+    cfg_model::CFG make_synthetic_cfg(int block_count, int block_size, int terminal_count, uint32_t seed)
+    {
+        uint32_t state = seed;
+        auto next_random = [&state](uint32_t bound)
+        {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) % bound;
+        };
+        auto non_terminal = [](int block, int index)
+        {
+            return cfg_model::symbol{"N" + std::to_string(block) + "_" + std::to_string(index), false, ""};
+        };
+        cfg_model::CFG cfg;
+        std::vector<cfg_model::symbol> terminals;
+        for (int i = 0; i < terminal_count; ++i)
+        {
+            terminals.push_back({"t" + std::to_string(i), true, ""});
+            cfg.terminals.insert(terminals.back());
+        }
+        cfg.start_symbol = {"S", false, ""};
+        cfg.non_terminals.insert(cfg.start_symbol);
+        for (int block = 0; block < block_count; ++block)
+        {
+            cfg.production_rules[cfg.start_symbol].insert({non_terminal(block, 0), terminals[block % terminal_count]});
+            for (int index = 0; index < block_size; ++index)
+            {
+                cfg_model::symbol lhs = non_terminal(block, index);
+                cfg.non_terminals.insert(lhs);
+                if (next_random(4) == 0)
+                {
+                    cfg.epsilon_production_symbols.insert(lhs);
+                }
+                for (int p = 0; p < 3; ++p)
+                {
+                    std::vector<cfg_model::symbol> rhs;
+                    uint32_t length = 1 + next_random(3);
+                    for (uint32_t k = 0; k < length; ++k)
+                    {
+                        uint32_t kind = next_random(10);
+                        int later_block = (block * 7 + 1) % block_count;
+                        if (kind < 4)
+                        {
+                            rhs.push_back(terminals[next_random(terminal_count)]);
+                        }
+                        else if (kind == 4 && later_block > block)
+                        {
+                            rhs.push_back(non_terminal(later_block, static_cast<int>(next_random(block_size))));
+                        }
+                        else
+                        {
+                            rhs.push_back(non_terminal(block, static_cast<int>(next_random(block_size))));
+                        }
+                    }
+                    cfg.production_rules[lhs].insert(rhs);
+                }
+            }
+        }
+        return itemset_generator_helper::expand_cfg(cfg);
+    }
+
+    struct AnalysisRun
+    {
+        cfg_model::FirstSet first_set;
+        cfg_model::FollowSet follow_set;
+        double milliseconds = 0;
+    };
+
+    AnalysisRun run_analysis(const cfg_model::CFG &cfg, CFGAnalyzer::AnalysisMode mode, unsigned thread_count)
+    {
+        CFGAnalyzer cfg_analyzer(cfg);
+        cfg_analyzer.setAnalysisMode(mode, thread_count);
+        auto start = std::chrono::steady_clock::now();
+        cfg_analyzer.computeFirstSet();
+        cfg_analyzer.computeFollowSet();
+        auto end = std::chrono::steady_clock::now();
+        AnalysisRun run;
+        run.first_set = cfg_analyzer.getFirstSet();
+        run.follow_set = cfg_analyzer.getFollowSet();
+        run.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        return run;
+    }
+}
+
+TEST_F(CFGAnalyzerTests, TestCondensationLevels)
+{
+    // 0 -> 1 -> 2 <-> 3, 0 -> 4
+    std::vector<std::vector<uint32_t>> edges = {{1, 4}, {2}, {3}, {2}, {}};
+    cfg_analyzer_helper::Condensation condensation = cfg_analyzer_helper::condense_digraph(edges);
+    ASSERT_EQ(condensation.components.size(), 4u);
+    EXPECT_EQ(condensation.component_of[2], condensation.component_of[3]);
+    // successors always come first
+    for (uint32_t component = 0; component < condensation.components.size(); ++component)
+    {
+        for (const auto successor : condensation.successors[component])
+        {
+            EXPECT_LT(successor, component);
+        }
+    }
+    ASSERT_EQ(condensation.levels.size(), 3u);
+    EXPECT_EQ(condensation.levels[0].size(), 2u); // {2, 3} and {4}
+    EXPECT_EQ(condensation.levels[2], std::vector<uint32_t>{condensation.component_of[0]});
+}
+
+TEST_F(CFGAnalyzerTests, TestParallelModeMatchesSequential)
+{
+    for (const std::string filename : {"test/data/cfg/cfg_analyzer/cfg_1.yml", "test/data/cfg/cfg_analyzer/cfg_2.yml", "test/data/cfg/cfg_analyzer/cfg_3.yml"})
+    {
+        cfg_model::CFG cfg = itemset_generator_helper::expand_cfg(load_test_cfg(filename));
+        AnalysisRun sequential = run_analysis(cfg, CFGAnalyzer::AnalysisMode::SEQUENTIAL, 1);
+        AnalysisRun parallel = run_analysis(cfg, CFGAnalyzer::AnalysisMode::PARALLEL, 4);
+        EXPECT_EQ(parallel.first_set.first_set, sequential.first_set.first_set) << filename;
+        EXPECT_EQ(parallel.first_set.symbols_with_epsilon, sequential.first_set.symbols_with_epsilon) << filename;
+        EXPECT_EQ(parallel.follow_set.follow_set, sequential.follow_set.follow_set) << filename;
+    }
+}
+
+TEST_F(CFGAnalyzerTests, TestParallelScalingOnSyntheticGrammars)
+{
+    for (int block_count : {64, 256, 1024})
+    {
+        cfg_model::CFG cfg = make_synthetic_cfg(block_count, 8, 96, 12345u + block_count);
+        AnalysisRun sequential = run_analysis(cfg, CFGAnalyzer::AnalysisMode::SEQUENTIAL, 1);
+        spdlog::info("synthetic grammar with {} non-terminals: sequential {:.3f} ms", cfg.non_terminals.size(), sequential.milliseconds);
+        for (unsigned thread_count : {1u, 2u, 4u, 8u})
+        {
+            AnalysisRun parallel = run_analysis(cfg, CFGAnalyzer::AnalysisMode::PARALLEL, thread_count);
+            spdlog::info("synthetic grammar with {} non-terminals: parallel with {} thread(s) {:.3f} ms", cfg.non_terminals.size(), thread_count, parallel.milliseconds);
+            // results do not depend on the mode or the thread count
+            ASSERT_EQ(parallel.first_set.first_set, sequential.first_set.first_set);
+            ASSERT_EQ(parallel.first_set.symbols_with_epsilon, sequential.first_set.symbols_with_epsilon);
+            ASSERT_EQ(parallel.follow_set.follow_set, sequential.follow_set.follow_set);
+        }
+    }
+}
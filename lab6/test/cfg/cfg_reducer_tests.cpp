@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include "testing_utils.h"
+#include "cfg_reducer.h"
+#include "cfg_model.h"
+#include "yaml_cfg_loader.h"
+#include "lr1_parsing_table_generator.h"
+#include "slr1_parsing_table_generator.h"
+#include "spdlog/spdlog.h"
+
+// create a fixture for log handling
+class CFGReducerTests : public ::testing::Test
+{
+    protected:
+
+    // when setting up the fixture, init the logger
+    static void SetUpTestSuite() {
+        // create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "cfg_reducer_tests.log";
+        // init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // when tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite() {
+        release_fixture_logger();
+    }
+
+    // at the start of each test, log the test name
+    void SetUp() override {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+
+    // at the end of each test, log the test name
+    void TearDown() override {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+};
+
+namespace
+{
+    cfg_model::symbol t(const std::string &name) { return cfg_model::symbol{name, true, ""}; }
+    cfg_model::symbol nt(const std::string &name) { return cfg_model::symbol{name, false, ""}; }
+}
+
+TEST_F(CFGReducerTests, RemovesUselessSymbols)
+{
+    cfg_model::CFG cfg = load_test_cfg("test/data/cfg/cfg_reducer/useless_symbols.yml");
+    cfg_model::CFGReductionResult result = cfg_reducer_helper::reduce_cfg(cfg);
+    const cfg_model::CFG &reduced_cfg = result.reduced_cfg;
+
+    // only S -> A b and A -> a survive
+    EXPECT_EQ(reduced_cfg.start_symbol, nt("S"));
+    EXPECT_EQ(reduced_cfg.non_terminals, (std::unordered_set<cfg_model::symbol>{nt("S"), nt("A")}));
+    EXPECT_EQ(reduced_cfg.terminals, (std::unordered_set<cfg_model::symbol>{t("a"), t("b")}));
+    ASSERT_EQ(reduced_cfg.production_rules.size(), 2u);
+    EXPECT_EQ(reduced_cfg.production_rules.at(nt("S")), (std::unordered_set<std::vector<cfg_model::symbol>>{{nt("A"), t("b")}}));
+    EXPECT_EQ(reduced_cfg.production_rules.at(nt("A")), (std::unordered_set<std::vector<cfg_model::symbol>>{{t("a")}}));
+    EXPECT_TRUE(reduced_cfg.epsilon_production_symbols.empty());
+
+    // the report lists everything that was dropped
+    EXPECT_EQ(result.report.unproductive_non_terminals, (std::unordered_set<cfg_model::symbol>{nt("B")}));
+    EXPECT_EQ(result.report.unreachable_non_terminals, (std::unordered_set<cfg_model::symbol>{nt("C"), nt("D")}));
+    EXPECT_EQ(result.report.unreachable_terminals, (std::unordered_set<cfg_model::symbol>{t("c"), t("d"), t("e")}));
+    EXPECT_EQ(result.report.removed_production_count, 4u);
+
+    // surviving symbols keep their relative id order
+    EXPECT_EQ(reduced_cfg.symbol_interner.size(), 4u);
+    EXPECT_LT(reduced_cfg.symbol_interner.id_of(t("a")), reduced_cfg.symbol_interner.id_of(t("b")));
+    EXPECT_LT(reduced_cfg.symbol_interner.id_of(nt("S")), reduced_cfg.symbol_interner.id_of(nt("A")));
+    // surviving productions keep their ids
+    EXPECT_EQ(reduced_cfg.production_numbering.id_of(nt("S"), {nt("A"), t("b")}), cfg.production_numbering.id_of(nt("S"), {nt("A"), t("b")}));
+    EXPECT_EQ(reduced_cfg.production_numbering.id_of(nt("A"), {t("a")}), cfg.production_numbering.id_of(nt("A"), {t("a")}));
+
+    // reducing again changes nothing
+    cfg_model::CFGReductionResult second_result = cfg_reducer_helper::reduce_cfg(reduced_cfg);
+    EXPECT_TRUE(second_result.report.empty());
+    EXPECT_EQ(second_result.reduced_cfg.production_rules, reduced_cfg.production_rules);
+}
+
+TEST_F(CFGReducerTests, ReducedGrammarIsUnchanged)
+{
+    cfg_model::CFG cfg = load_test_cfg("test/data/cfg/yaml_cfg_loader/minimal_correct_cfg.yml");
+    cfg_model::CFGReductionResult result = cfg_reducer_helper::reduce_cfg(cfg);
+    EXPECT_TRUE(result.report.empty()) << cfg_reducer_helper::describe_reduction(result.report);
+    EXPECT_EQ(result.reduced_cfg.production_rules, cfg.production_rules);
+    EXPECT_EQ(result.reduced_cfg.epsilon_production_symbols, cfg.epsilon_production_symbols);
+    EXPECT_EQ(result.reduced_cfg.terminals, cfg.terminals);
+    EXPECT_EQ(result.reduced_cfg.non_terminals, cfg.non_terminals);
+}
+
+TEST_F(CFGReducerTests, UnproductiveStartSymbolThrows)
+{
+    cfg_model::CFG cfg;
+    cfg.start_symbol = nt("S");
+    cfg.non_terminals = {nt("S")};
+    cfg.terminals = {t("a")};
+    cfg.production_rules[nt("S")].insert({nt("S"), t("a")});
+    EXPECT_THROW(cfg_reducer_helper::reduce_cfg(cfg), std::runtime_error);
+}
+
+TEST_F(CFGReducerTests, GeneratorsReduceByDefault)
+{
+    cfg_model::CFG cfg = load_test_cfg("test/data/cfg/cfg_reducer/useless_symbols.yml");
+
+    // the useless symbols never reach the parsing table
+    LR1ParsingTableGenerator lr1_generator;
+    EXPECT_TRUE(lr1_generator.get_reduce_cfg());
+    lr_parsing_model::LRParsingTable lr1_table = lr1_generator.generate_parsing_table(cfg);
+    EXPECT_EQ(lr1_table.all_symbols.count(nt("B")), 0u);
+    EXPECT_EQ(lr1_table.all_symbols.count(t("e")), 0u);
+    EXPECT_EQ(lr1_generator.get_last_reduction_report().removed_production_count, 4u);
+
+    SLR1ParsingTableGenerator slr1_generator;
+    lr_parsing_model::LRParsingTable slr1_table = slr1_generator.generate_parsing_table(cfg);
+    EXPECT_EQ(slr1_table.all_states.size(), lr1_table.all_states.size());
+    EXPECT_EQ(slr1_table.all_symbols, lr1_table.all_symbols);
+
+    // with the reduction disabled the grammar is used as is
+    SLR1ParsingTableGenerator unreduced_generator;
+    unreduced_generator.set_reduce_cfg(false);
+    lr_parsing_model::ItemSet item_set = unreduced_generator.generate_item_set(cfg);
+    EXPECT_EQ(item_set.symbol_set.count(nt("B")), 1u);
+    EXPECT_TRUE(unreduced_generator.get_last_reduction_report().empty());
+}
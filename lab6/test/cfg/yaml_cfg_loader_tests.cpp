@@ -60,4 +60,58 @@ TEST_F(YamlCfgLoaderTests, LoadAndCheckMinimalCorrectCFG)
     cfg_model::CFG cfg = YAML_CFG_Loader_Helper::ParseYAMLFile(filename);
     // check the validity of the CFG
     ASSERT_NO_THROW(YAML_CFG_Loader_Helper::CheckCFG(cfg));
-}
\ No newline at end of file
+}
+TEST_F(YamlCfgLoaderTests, SymbolIdsFollowDeclarationOrder)
+{
+    std::string filename = "test/data/cfg/yaml_cfg_loader/minimal_correct_cfg.yml";
+    cfg_model::CFG cfg = YAML_CFG_Loader_Helper::ParseYAMLFile(filename);
+    // terminals first, then non-terminals, both in declaration order
+    std::vector<std::string> expected_names = {"id", "+", "*", "(", ")", "S", "E", "T", "F"};
+    ASSERT_EQ(cfg.symbol_interner.size(), expected_names.size());
+    for (size_t i = 0; i < expected_names.size(); ++i)
+    {
+        const cfg_model::symbol &s = cfg.symbol_interner.symbol_of(static_cast<cfg_model::symbol_id>(i));
+        EXPECT_EQ(s.name, expected_names[i]);
+        EXPECT_EQ(s.is_terminal, i < 5);
+        EXPECT_EQ(cfg.symbol_interner.id_of(s), i);
+    }
+
+    // the indexed grammar keeps the ids and encodes the epsilon production as an empty rhs
+    cfg_model::IndexedGrammar grammar = cfg_model_helper::build_indexed_grammar(cfg);
+    ASSERT_EQ(grammar.interner.size(), expected_names.size());
+    EXPECT_EQ(grammar.start_symbol, 5u);
+    EXPECT_EQ(grammar.end_symbol, cfg_model::invalid_symbol_id);
+    EXPECT_EQ(grammar.productions.size(), 8u);
+    cfg_model::symbol_id e_id = 6;
+    ASSERT_EQ(grammar.productions_by_lhs[e_id].size(), 3u);
+    // productions are ordered by rhs, so the epsilon production comes first
+    EXPECT_TRUE(grammar.productions[grammar.productions_by_lhs[e_id][0]].rhs.empty());
+    EXPECT_EQ(grammar.productions[grammar.productions_by_lhs[e_id][1]].rhs, (std::vector<cfg_model::symbol_id>{6, 1, 7}));
+}
+TEST_F(YamlCfgLoaderTests, ProductionIdsFollowDeclarationOrder)
+{
+    std::string filename = "test/data/cfg/yaml_cfg_loader/minimal_correct_cfg.yml";
+    cfg_model::CFG cfg = YAML_CFG_Loader_Helper::ParseYAMLFile(filename);
+    cfg_model::symbol s{"S", false, ""}, e{"E", false, ""}, t{"T", false, ""}, f{"F", false, ""};
+    cfg_model::symbol id{"id", true, ""}, plus{"+", true, ""}, times{"*", true, ""}, lpa{"(", true, ""}, rpa{")", true, ""};
+    // every production in the order of the file, the epsilon production with an empty rhs
+    std::vector<std::pair<cfg_model::symbol, std::vector<cfg_model::symbol>>> expected_productions = {
+        {e, {}}, {s, {e}}, {e, {e, plus, t}}, {e, {t}}, {t, {t, times, f}}, {t, {f}}, {f, {lpa, e, rpa}}, {f, {id}}};
+    ASSERT_EQ(cfg.production_numbering.size(), expected_productions.size());
+    for (cfg_model::production_id production = 0; production < expected_productions.size(); ++production)
+    {
+        EXPECT_EQ(cfg.production_numbering.lhs_of(production), expected_productions[production].first);
+        EXPECT_EQ(cfg.production_numbering.rhs_of(production), expected_productions[production].second);
+        EXPECT_EQ(cfg.production_numbering.id_of(expected_productions[production].first, expected_productions[production].second), production);
+    }
+    EXPECT_EQ(cfg.production_numbering.id_of(s, {t}), cfg_model::invalid_production_id);
+
+    // numbering again keeps the ids, productions added later are numbered after them
+    cfg_model_helper::number_cfg_productions(cfg);
+    EXPECT_EQ(cfg.production_numbering.size(), expected_productions.size());
+    cfg.production_rules[f].insert({id, plus, id});
+    cfg.production_rules[s].insert({t});
+    cfg_model_helper::number_cfg_productions(cfg);
+    EXPECT_EQ(cfg.production_numbering.id_of(f, {id, plus, id}), 8u);
+    EXPECT_EQ(cfg.production_numbering.id_of(s, {t}), 9u);
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "testing_utils.h"
+#include "compact_conflict_tolerant_dfa.h"
+#include "dfa_model.h"
+
+class CompactConflictTolerantDFATests : public ::testing::Test
+{
+protected:
+    dfa_model::ConflictTolerantDFA<std::string> conflict_tolerant_dfa;
+
+    // when setting up the fixture, init the logger
+    static void SetUpTestSuite() {
+        // create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "compact_conflict_tolerant_dfa_tests.log";
+        // init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // when tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite() {
+        release_fixture_logger();
+    }
+
+    // at the start of each test, log the test name
+    void SetUp() override {
+        // a small automaton with a shift/shift style conflict on "x" in state s0
+        conflict_tolerant_dfa.character_set = {"x", "y"};
+        conflict_tolerant_dfa.states_set = {"s0", "s1", "s2"};
+        conflict_tolerant_dfa.initial_state = "s0";
+        conflict_tolerant_dfa.accepting_states = {"s2"};
+        conflict_tolerant_dfa.add_transition("s0", "x", "s1");
+        conflict_tolerant_dfa.add_transition("s0", "x", "s2");
+        conflict_tolerant_dfa.add_transition("s0", "y", "s0");
+        conflict_tolerant_dfa.add_transition("s1", "y", "s2");
+
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+    // at the end of each test, log the test name
+    void TearDown() override {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+};
+
+TEST_F(CompactConflictTolerantDFATests, EqualRangeAndConflicts) {
+    auto compact_dfa = compact_conflict_tolerant_dfa_helper::to_compact(conflict_tolerant_dfa);
+    ASSERT_EQ(compact_dfa.count_transitions(), 4);
+
+    uint32_t s0 = compact_dfa.find_state("s0");
+    uint32_t s1 = compact_dfa.find_state("s1");
+    uint32_t x = compact_dfa.find_symbol("x");
+    uint32_t y = compact_dfa.find_symbol("y");
+    ASSERT_EQ(compact_dfa.initial_state, s0);
+
+    auto range = compact_dfa.equal_range(s0, x);
+    std::unordered_set<std::string> targets;
+    for (auto it = range.first; it != range.second; ++it) {
+        targets.insert(compact_dfa.state_names[it->second]);
+    }
+    ASSERT_EQ(targets, std::unordered_set<std::string>({"s1", "s2"}));
+    ASSERT_EQ(std::distance(compact_dfa.equal_range(s1, x).first, compact_dfa.equal_range(s1, x).second), 0);
+
+    ASSERT_EQ(compact_dfa.conflicting_symbols(s0), std::vector<uint32_t>({x}));
+    ASSERT_TRUE(compact_dfa.conflicting_symbols(s1).empty());
+
+    // exact duplicates are refused, new targets are kept sorted
+    ASSERT_FALSE(compact_dfa.add_transition(s0, y, s0));
+    ASSERT_TRUE(compact_dfa.add_transition(s1, y, s0));
+    ASSERT_TRUE(std::is_sorted(compact_dfa.transitions[s1].begin(), compact_dfa.transitions[s1].end()));
+    ASSERT_EQ(compact_dfa.conflicting_symbols(s1), std::vector<uint32_t>({y}));
+}
+
+TEST_F(CompactConflictTolerantDFATests, RoundTripConversion) {
+    auto compact_dfa = compact_conflict_tolerant_dfa_helper::to_compact(conflict_tolerant_dfa);
+    auto restored_dfa = compact_conflict_tolerant_dfa_helper::from_compact(compact_dfa);
+
+    ASSERT_NO_THROW(dfa_model_helper::check_conflict_tolerant_dfa_configuration(restored_dfa));
+    ASSERT_EQ(restored_dfa.states_set, conflict_tolerant_dfa.states_set);
+    ASSERT_EQ(restored_dfa.character_set, conflict_tolerant_dfa.character_set);
+    ASSERT_EQ(restored_dfa.initial_state, conflict_tolerant_dfa.initial_state);
+    ASSERT_EQ(restored_dfa.accepting_states, conflict_tolerant_dfa.accepting_states);
+    ASSERT_EQ(restored_dfa.count_transitions(), conflict_tolerant_dfa.count_transitions());
+    for (const auto &state_transitions : conflict_tolerant_dfa.transitions) {
+        for (const auto &transition : state_transitions.second) {
+            ASSERT_TRUE(restored_dfa.check_transition(state_transitions.first, transition.first, transition.second));
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include "testing_utils.h"
+#include "dfa_builder.h"
+#include "dfa_model.h"
+#include "compiled_dfa.h"
+
+class DFABuilderTests : public ::testing::Test
+{
+protected:
+    // when setting up the fixture, init the logger
+    static void SetUpTestSuite() {
+        // create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "dfa_builder_tests.log";
+        // init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // when tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite() {
+        release_fixture_logger();
+    }
+
+    // at the start of each test, log the test name
+    void SetUp() override {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+    // at the end of each test, log the test name
+    void TearDown() override {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+
+    // strings over {a, b} ending with 'a'
+    static dfa_model::DFABuilder<char> make_ends_with_a_builder() {
+        dfa_model::DFABuilder<char> builder;
+        uint32_t q0 = builder.add_state("q0");
+        uint32_t q1 = builder.add_state("q1", true);
+        uint32_t a = builder.add_symbol('a');
+        uint32_t b = builder.add_symbol('b');
+        builder.set_initial_state(q0);
+        builder.add_transition(q0, a, q1);
+        builder.add_transition(q0, b, q0);
+        builder.add_transition(q1, a, q1);
+        builder.add_transition(q1, b, q0);
+        // duplicates are tolerated and dropped
+        builder.add_transition(q1, b, q0);
+        return builder;
+    }
+};
+
+TEST_F(DFABuilderTests, BuildProducesValidDFA) {
+    dfa_model::DFABuilder<char> builder = make_ends_with_a_builder();
+    ASSERT_EQ(builder.state_count(), 2);
+    ASSERT_EQ(builder.add_state("q0"), builder.find_state("q0"));
+
+    dfa_model::DFA<char> dfa = builder.build();
+    ASSERT_NO_THROW(dfa_model_helper::check_dfa_configuration(dfa));
+    ASSERT_EQ(dfa.initial_state, "q0");
+    ASSERT_EQ(dfa.accepting_states, std::unordered_set<std::string>({"q1"}));
+    ASSERT_EQ(dfa.count_transitions(), 4);
+    ASSERT_TRUE(dfa.check_transition("q1", 'b', "q0"));
+
+    // the compiled DFA behaves the same as compiling the built DFA
+    dfa_model::CompiledDFA<char> compiled_dfa = builder.build_compiled();
+    dfa_model::CompiledDFA<char> reference = compiled_dfa_helper::compile_dfa(dfa);
+    for (const std::vector<char> &input : std::vector<std::vector<char>>{{'a'}, {'b'}, {'a', 'b'}, {'b', 'b', 'a'}, {'c'}}) {
+        ASSERT_EQ(compiled_dfa_helper::simulate(compiled_dfa, input), compiled_dfa_helper::simulate(reference, input));
+    }
+}
+
+TEST_F(DFABuilderTests, BuildDetectsConflictsAndInvalidReferences) {
+    dfa_model::DFABuilder<char> conflicting = make_ends_with_a_builder();
+    conflicting.add_transition(conflicting.find_state("q0"), conflicting.find_symbol('a'), conflicting.find_state("q0"));
+    ASSERT_THROW(conflicting.build(), std::runtime_error);
+    ASSERT_THROW(conflicting.build_compiled(), std::runtime_error);
+
+    dfa_model::DFABuilder<char> dangling = make_ends_with_a_builder();
+    dangling.add_transition(0, 0, 7);
+    ASSERT_THROW(dangling.build(), std::runtime_error);
+
+    dfa_model::DFABuilder<char> no_initial_state;
+    no_initial_state.add_state("q0", true);
+    no_initial_state.add_symbol('a');
+    ASSERT_THROW(no_initial_state.build(), std::runtime_error);
+}
@@ -47,4 +47,63 @@ TEST_F(DFASimulatorTest, UpdateDFAValid) {
     std::vector<char> unacceptable = {'c'};
     ASSERT_TRUE(standard_dfa_simulator.SimulateString(acceptable)); // Assumes UpdateDFA worked
     ASSERT_FALSE(standard_dfa_simulator.SimulateString(unacceptable)); // Assumes "b" is not accepted
-}
\ No newline at end of file
+}
+TEST_F(DFASimulatorTest, SimulateBatchMatchesSingleSimulation) {
+    ASSERT_TRUE(standard_dfa_simulator.UpdateDFA(minimalDFA));
+    std::vector<std::vector<char>> inputs = {
+        {'a'}, {'b'}, {}, {'c'}, {'a', 'b'}, {'b', 'b', 'a'}, {'a', 'c', 'a'}, {'b', 'a', 'b', 'a'}
+    };
+    // repeat the inputs so that the batch spans several interleaved groups and threads
+    std::vector<std::vector<char>> batch;
+    for (int i = 0; i < 50; ++i) {
+        batch.insert(batch.end(), inputs.begin(), inputs.end());
+    }
+
+    for (unsigned thread_count : {1u, 4u, 0u}) {
+        std::vector<bool> accepted = standard_dfa_simulator.SimulateBatch(batch, thread_count);
+        ASSERT_EQ(accepted.size(), batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            ASSERT_EQ(accepted[i], standard_dfa_simulator.SimulateString(batch[i])) << "Mismatch at input " << i << " with " << thread_count << " threads";
+        }
+    }
+    // an empty batch gives an empty bitmap
+    ASSERT_TRUE(standard_dfa_simulator.SimulateBatch({}).empty());
+}
+
+TEST_F(DFASimulatorTest, CountEnumerateAndSampleAcceptedStrings) {
+    // minimalDFA accepts exactly the non-empty strings over {a, b} ending with 'a'
+    ASSERT_TRUE(standard_dfa_simulator.UpdateDFA(minimalDFA));
+
+    // k-length accepted strings: 2^(k-1), saturating once it no longer fits
+    std::vector<uint64_t> counts = standard_dfa_simulator.CountAcceptedStrings(70);
+    ASSERT_EQ(counts.size(), 71);
+    ASSERT_EQ(counts[0], 0);
+    ASSERT_EQ(counts[1], 1);
+    ASSERT_EQ(counts[10], 512);
+    ASSERT_EQ(counts[64], uint64_t(1) << 63);
+    ASSERT_EQ(counts[70], std::numeric_limits<uint64_t>::max());
+
+    // shortlex order: by length, then by character
+    std::vector<std::string> expected_prefix = {"a", "aa", "ba", "aaa", "aba", "baa", "bba"};
+    auto enumerator = standard_dfa_simulator.EnumerateAcceptedStrings(3);
+    std::vector<std::string> enumerated;
+    for (const auto &accepted_string : enumerator) {
+        enumerated.emplace_back(accepted_string.begin(), accepted_string.end());
+    }
+    ASSERT_EQ(enumerated, expected_prefix);
+
+    // the set-based generator agrees with the counts
+    std::set<std::string> generated = standard_dfa_simulator.GenerateAcceptedStrings(12);
+    ASSERT_EQ(generated.size(), (uint64_t(1) << 12) - 1);
+
+    // samples have the requested length and are accepted
+    std::mt19937_64 random_engine(42);
+    for (int i = 0; i < 20; ++i) {
+        auto sampled = standard_dfa_simulator.SampleAcceptedString(16, random_engine);
+        ASSERT_TRUE(sampled.has_value());
+        ASSERT_EQ(sampled->size(), 16);
+        ASSERT_TRUE(standard_dfa_simulator.SimulateString(std::vector<char>(sampled->begin(), sampled->end())));
+    }
+    // nothing of length 0 is accepted
+    ASSERT_FALSE(standard_dfa_simulator.SampleAcceptedString(0, random_engine).has_value());
+}
@@ -51,4 +51,29 @@ TEST_F(MultiTypeDFASimulatorTests, TestUpdateDFA) {
     ASSERT_TRUE(sim.UpdateDFA(dfa));
     ASSERT_TRUE(sim.SimulateString({'3', '.', '4', '5', '6'})) << "Failed to simulate string in simulator";
     ASSERT_FALSE(sim.SimulateString({'1', '9', '2', '.', '1', '6', '8', '.', '0', '.', '1'}));
-}
\ No newline at end of file
+}
+TEST_F(MultiTypeDFASimulatorTests, TestSimulateBatch) {
+    std::string filename = "test/data/fsm/multitype_dfa_simulator/dfa_config_real.yml";
+    YAMLDFAConfigFrontend yaml_config;
+    ASSERT_TRUE(yaml_config.LoadConfig(filename)) << "Failed to load config from " << filename;
+    ASSERT_TRUE(yaml_config.CheckConfig()) << "Failed to check config from " << filename;
+    dfa_model::DFA<char> dfa = yaml_config.ConstructDFA();
+
+    MultiTypeDFASimulator<char> sim = MultiTypeDFASimulator<char>();
+    ASSERT_TRUE(sim.UpdateDFA(dfa));
+    std::vector<std::vector<char>> batch = {
+        {'3', '.', '4', '5', '6'},
+        {'1', '9', '2', '.', '1', '6', '8', '.', '0', '.', '1'},
+        {'4', '2'},
+        {'.'},
+        {},
+        {'0', '.', '5'}
+    };
+    std::vector<bool> accepted = sim.SimulateBatch(batch, 2);
+    ASSERT_EQ(accepted.size(), batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ASSERT_EQ(accepted[i], sim.SimulateString(batch[i])) << "Mismatch at input " << i;
+    }
+    ASSERT_TRUE(accepted[0]);
+    ASSERT_FALSE(accepted[1]);
+}
@@ -0,0 +1,197 @@
+#include "gtest/gtest.h"
+#include "compiled_lr_table.h"
+#include "lr1_parsing_table_generator.h"
+#include "simple_lr_parsing_table_generator.h"
+#include "testing_utils.h"
+#include "yaml_cfg_loader.h"
+#include "spdlog/spdlog.h"
+#include <string>
+
+// Test fixture for compiled LR tables
+class CompiledLRTableTests : public ::testing::Test
+{
+protected:
+    std::string test_data_dir = "test/data/parsing_table/compiled_lr_table/";
+    // When setting up the fixture, init the logger
+    static void SetUpTestSuite()
+    {
+        // Create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "compiled_lr_table_tests.log";
+        // Init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // When tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite()
+    {
+        release_fixture_logger();
+    }
+
+    // At the start of each test, log the test name
+    void SetUp() override
+    {
+        // Separate line
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+
+    // At the end of each test, log the test name
+    void TearDown() override
+    {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+};
+
+namespace
+{
+    using lr_parsing_model::CompiledLRTable;
+
+    // the compiled action of a source cell, as compile_lr_table should have encoded it
+    bool same_action(const lr_parsing_model::LRParsingTable &parsing_table, const CompiledLRTable &compiled_table, int32_t compiled_action, const lr_parsing_model::Action &action)
+    {
+        switch (CompiledLRTable::action_kind(compiled_action))
+        {
+        case CompiledLRTable::SHIFT:
+            return action.action_type == "shift" && compiled_table.state_names[CompiledLRTable::action_value(compiled_action)] == action.target_state;
+        case CompiledLRTable::REDUCE:
+        {
+            // the compiled table keeps the production ids of the source table
+            uint32_t production_id = CompiledLRTable::action_value(compiled_action);
+            if (action.action_type != "reduce" || production_id != action.reduce_production)
+            {
+                return false;
+            }
+            const CompiledLRTable::Production &production = compiled_table.productions[production_id];
+            const lr_parsing_model::Production &source = parsing_table.production_table->production(production_id);
+            return compiled_table.non_terminals[production.lhs] == source.lhs && production.rhs_length == source.rhs.size();
+        }
+        case CompiledLRTable::ACCEPT:
+            return action.action_type == "accept";
+        default:
+            return compiled_action == CompiledLRTable::error_action && action.action_type == "empty";
+        }
+    }
+
+    // every cell of the source table against the compiled lookups
+    // with default reductions an error cell may read as the state's default reduce instead
+    void expect_same_table(const lr_parsing_model::LRParsingTable &parsing_table, const CompiledLRTable &compiled_table, bool default_reductions)
+    {
+        ASSERT_EQ(compiled_table.state_count, parsing_table.all_states.size());
+        ASSERT_NE(parsing_table.production_table, nullptr);
+        ASSERT_EQ(compiled_table.productions.size(), parsing_table.production_table->size());
+        EXPECT_EQ(compiled_table.state_names[compiled_table.start_state], parsing_table.start_state);
+        for (uint32_t state = 0; state < compiled_table.state_count; ++state)
+        {
+            const std::string &state_name = compiled_table.state_names[state];
+            for (uint32_t terminal = 0; terminal < compiled_table.terminals.size(); ++terminal)
+            {
+                const cfg_model::symbol &symbol = compiled_table.terminals[terminal];
+                int32_t compiled_action = compiled_table.action(state, terminal);
+                std::unordered_set<lr_parsing_model::Action> actions = parsing_table.get_actions(state_name, symbol);
+                if (actions.size() > 1)
+                {
+                    EXPECT_EQ(compiled_action, CompiledLRTable::conflict_action) << state_name << " " << symbol.name;
+                    continue;
+                }
+                bool is_error = actions.empty() || actions.begin()->action_type == "empty";
+                if (is_error)
+                {
+                    int32_t expected_action = default_reductions ? compiled_table.default_actions[state] : CompiledLRTable::error_action;
+                    EXPECT_EQ(compiled_action, expected_action) << state_name << " " << symbol.name;
+                    EXPECT_NE(CompiledLRTable::action_kind(compiled_action), CompiledLRTable::SHIFT) << state_name << " " << symbol.name;
+                    continue;
+                }
+                EXPECT_TRUE(same_action(parsing_table, compiled_table, compiled_action, *actions.begin())) << state_name << " " << symbol.name;
+            }
+            for (uint32_t non_terminal = 0; non_terminal < compiled_table.non_terminals.size(); ++non_terminal)
+            {
+                std::unordered_set<std::string> targets = parsing_table.get_gotos(state_name, compiled_table.non_terminals[non_terminal]);
+                targets.erase("");
+                if (targets.size() == 1)
+                {
+                    EXPECT_EQ(compiled_table.state_names[compiled_table.goto_state(state, non_terminal)], *targets.begin())
+                        << state_name << " " << compiled_table.non_terminals[non_terminal].name;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(CompiledLRTableTests, TestLookupsMatchSourceTable)
+{
+    for (const std::string name : {"canonical_cc_cfg.yml", "complicated_cfg_1_with_conflict.yml", "final_semantic_correction.yml"})
+    {
+        SCOPED_TRACE(name);
+        cfg_model::CFG cfg = load_test_cfg(test_data_dir + name);
+        LR1ParsingTableGenerator generator;
+        lr_parsing_model::LRParsingTable parsing_table = generator.generate_parsing_table(cfg);
+
+        CompiledLRTable exact_table = compiled_lr_table_helper::compile_lr_table(parsing_table, false);
+        expect_same_table(parsing_table, exact_table, false);
+        CompiledLRTable defaulted_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+        expect_same_table(parsing_table, defaulted_table, true);
+        ASSERT_NE(defaulted_table.end_terminal, CompiledLRTable::invalid_id);
+        EXPECT_EQ(defaulted_table.terminals[defaulted_table.end_terminal].special_property, "END");
+        // defaults only ever remove cells
+        EXPECT_LE(defaulted_table.action_rows.values.size(), exact_table.action_rows.values.size());
+    }
+}
+
+// cells with several actions stay visible as conflicts instead of picking one of them
+TEST_F(CompiledLRTableTests, TestConflictingCells)
+{
+    cfg_model::CFG cfg = load_test_cfg(test_data_dir + "complicated_cfg_1_with_conflict.yml");
+    SimpleLRParsingTableGenerator generator;
+    lr_parsing_model::LRParsingTable parsing_table = generator.generate_parsing_table(cfg);
+    ASSERT_FALSE(parsing_table.find_conflicts().empty());
+
+    CompiledLRTable compiled_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+    expect_same_table(parsing_table, compiled_table, true);
+}
+
+// the final grammar's table is mostly errors and single reduces, the comb vector keeps a fraction of the dense cells
+TEST_F(CompiledLRTableTests, TestCompression)
+{
+    cfg_model::CFG cfg = load_test_cfg(test_data_dir + "final_semantic_correction.yml");
+    LR1ParsingTableGenerator generator;
+    lr_parsing_model::LRParsingTable parsing_table = generator.generate_parsing_table(cfg);
+    CompiledLRTable compiled_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+
+    size_t dense_action_cells = static_cast<size_t>(compiled_table.state_count) * compiled_table.terminals.size();
+    size_t dense_goto_cells = static_cast<size_t>(compiled_table.state_count) * compiled_table.non_terminals.size();
+    spdlog::info("Action table: {} dense cells, {} comb slots; goto table: {} dense cells, {} comb slots",
+                 dense_action_cells, compiled_table.action_rows.values.size(), dense_goto_cells, compiled_table.goto_columns.values.size());
+    EXPECT_LT(compiled_table.action_rows.values.size() * 2, dense_action_cells);
+    EXPECT_LT(compiled_table.goto_columns.values.size() * 4, dense_goto_cells);
+}
+
+TEST_F(CompiledLRTableTests, TestPackCombVector)
+{
+    // overlapping rows must interleave without sharing a slot, the empty row gets no slot
+    std::vector<std::vector<std::pair<uint32_t, int32_t>>> rows = {
+        {{0, 10}, {2, 12}, {4, 14}},
+        {{1, 21}, {3, 23}},
+        {},
+        {{0, 40}, {1, 41}, {2, 42}, {3, 43}, {4, 44}, {5, 45}},
+        {{5, 55}},
+    };
+    const uint32_t column_count = 6;
+    lr_parsing_model::CombVector comb_vector = compiled_lr_table_helper::pack_comb_vector(rows, column_count);
+    ASSERT_EQ(comb_vector.base.size(), rows.size());
+    for (uint32_t row = 0; row < rows.size(); ++row)
+    {
+        std::vector<int32_t> expected(column_count, -1);
+        for (const auto &cell : rows[row])
+        {
+            expected[cell.first] = cell.second;
+        }
+        for (uint32_t column = 0; column < column_count; ++column)
+        {
+            EXPECT_EQ(comb_vector.find(row, column, -1), expected[column]) << row << " " << column;
+        }
+    }
+    // 12 cells in far fewer slots than 5 dense rows of 6
+    EXPECT_LT(comb_vector.values.size(), 20u);
+    EXPECT_EQ(comb_vector.values.size(), comb_vector.check.size());
+}
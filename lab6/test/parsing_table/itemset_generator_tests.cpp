@@ -91,4 +91,72 @@ TEST_F(ItemSetGeneratorTests, TestGenerateComplicatedCFGItems)
     ASSERT_NO_THROW(item_set = item_set_generator.generate_item_set(cfg));
     
     ASSERT_EQ(item_set.items.size(), 20);// 18 items + 2 initial and final items
-}
\ No newline at end of file
+}
+TEST_F(ItemSetGeneratorTests, TestItemsShareProductionTable)
+{
+    // load the CFG from the YAML file
+    std::string filename = "test/data/parsing_table/itemset_generator/minimal_correct_cfg.yml";
+    cfg_model::CFG cfg = YAML_CFG_Loader_Helper::ParseYAMLFile(filename);
+
+    ItemSetGenerator item_set_generator;
+    lr_parsing_model::ItemSet item_set = item_set_generator.generate_item_set(cfg);
+    ASSERT_NE(item_set.production_table, nullptr);
+
+    // one item per dot position of every production, all pointing into the one table
+    size_t expected_item_count = 0;
+    for (uint32_t production_id = 0; production_id < item_set.production_table->size(); ++production_id)
+    {
+        expected_item_count += item_set.production_table->production(production_id).rhs.size() + 1;
+    }
+    ASSERT_EQ(item_set.items.size(), expected_item_count);
+    for (const auto &item : item_set.items)
+    {
+        ASSERT_EQ(item->production_table, item_set.production_table);
+        const lr_parsing_model::Production &production = item->production();
+        ASSERT_EQ(item->sequence_already_parsed().size() + item->sequence_to_parse().size(), production.rhs.size());
+        ASSERT_EQ(item->sequence_already_parsed().size(), item->dot());
+        if (item->is_accepting())
+        {
+            ASSERT_THROW(item->advanced(), std::runtime_error);
+            continue;
+        }
+        // moving the dot keeps the production and hashes like the generated item
+        lr_parsing_model::Item next_item = item->advanced();
+        ASSERT_EQ(next_item.production_id(), item->production_id());
+        ASSERT_EQ(next_item.dot(), item->dot() + 1);
+        ASSERT_EQ(next_item.sequence_already_parsed().size(), item->dot() + 1);
+        ASSERT_EQ(next_item.sequence_already_parsed()[item->dot()], item->sequence_to_parse()[0]);
+        size_t matches = 0;
+        for (const auto &other_item : item_set.items)
+        {
+            if (*other_item == next_item)
+            {
+                ASSERT_EQ(std::hash<lr_parsing_model::Item>()(*other_item), std::hash<lr_parsing_model::Item>()(next_item));
+                matches++;
+            }
+        }
+        ASSERT_EQ(matches, 1u);
+    }
+
+    // the table is seeded from the grammar's numbering, the augmented start production comes last
+    ASSERT_EQ(item_set.production_table->size(), cfg.production_numbering.size() + 1);
+    for (const auto &item : item_set.items)
+    {
+        if (item->left_side_symbol() == item_set.start_item->left_side_symbol())
+        {
+            ASSERT_EQ(item->production_id(), cfg.production_numbering.size());
+            continue;
+        }
+        ASSERT_EQ(item->production_id(), cfg.production_numbering.id_of(item->left_side_symbol(), item->production().rhs));
+    }
+
+    // the same production in another table compares and hashes by content
+    auto other_table = std::make_shared<lr_parsing_model::ProductionTable>();
+    const lr_parsing_model::Item &start_item = *item_set.start_item;
+    uint32_t other_id = other_table->add_production(start_item.left_side_symbol(), start_item.production().rhs);
+    lr_parsing_model::Item copied_item(other_table, other_id, start_item.dot());
+    ASSERT_EQ(copied_item, start_item);
+    ASSERT_EQ(std::hash<lr_parsing_model::Item>()(copied_item), std::hash<lr_parsing_model::Item>()(start_item));
+    ASSERT_EQ(other_table->add_production(start_item.left_side_symbol(), start_item.production().rhs), other_id);
+    ASSERT_THROW(lr_parsing_model::Item(other_table, other_id, 2), std::runtime_error);
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include "lalr1_parsing_table_generator.h"
+#include "lr1_parsing_table_generator.h"
+#include "slr1_parsing_table_generator.h"
+#include "visualization_helper.h"
+#include "testing_utils.h"
+#include "yaml_cfg_loader.h"
+#include "spdlog/spdlog.h"
+#include <fstream>
+#include <string>
+
+// Test fixture for LALR1ParsingTableGenerator
+class LALR1ParsingTableGeneratorTests : public ::testing::Test
+{
+protected:
+    std::string test_data_dir = "test/data/parsing_table/lalr1_parsing_table_generator/";
+    // When setting up the fixture, init the logger
+    static void SetUpTestSuite()
+    {
+        // Create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "lalr1_parsing_table_generator_tests.log";
+        // Init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // When tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite()
+    {
+        release_fixture_logger();
+    }
+
+    // At the start of each test, log the test name
+    void SetUp() override
+    {
+        // Separate line
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+
+    // At the end of each test, log the test name
+    void TearDown() override
+    {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+};
+
+// S -> C C, C -> c C | d: 10 canonical LR(1) states merge into the 7 LR(0) states
+TEST_F(LALR1ParsingTableGeneratorTests, TestStateCountMatchesLR0)
+{
+    std::string filename = test_data_dir + "canonical_cc_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    LALR1ParsingTableGenerator generator;
+    lr_parsing_model::LR1ItemSetDFAGenerationResult result = generator.generate_item_set_dfa(cfg);
+    SLR1ParsingTableGenerator lr0_generator;
+    lr_parsing_model::ItemSetDFAGenerationResult lr0_result = lr0_generator.generate_item_set_dfa(cfg);
+    EXPECT_EQ(result.dfa.states_set.size(), 7u);
+    EXPECT_EQ(result.dfa.states_set.size(), lr0_result.dfa.states_set.size());
+    EXPECT_EQ(result.dfa.count_transitions(), lr0_result.dfa.count_transitions());
+
+    lr_parsing_model::LRParsingTable parsing_table = generator.generate_parsing_table(cfg);
+    EXPECT_EQ(parsing_table.all_states.size(), 7u);
+    ASSERT_TRUE(parsing_table.filling_check()) << "Parsing table filling check failed";
+    EXPECT_TRUE(parsing_table.find_conflicts().empty());
+
+    visualization_helper::pretty_print_parsing_table(parsing_table, true, "canonical_cc_cfg_parsing_table_lalr1.md");
+}
+
+// S -> L = R | R, L -> * R | id, R -> L is not SLR(1), the state with S -> L · = R only reduces R -> L on END
+TEST_F(LALR1ParsingTableGeneratorTests, TestAssignmentGrammarLookaheads)
+{
+    std::string filename = test_data_dir + "assignment_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    SLR1ParsingTableGenerator slr1_generator;
+    EXPECT_THROW(slr1_generator.generate_parsing_table(cfg), std::runtime_error);
+
+    LALR1ParsingTableGenerator generator;
+    lr_parsing_model::LR1ItemSetDFAGenerationResult result = generator.generate_item_set_dfa(cfg);
+    bool found_state = false;
+    for (const auto &state_items : result.item_set_dfa_mapping.dfa_state_to_item_set)
+    {
+        bool has_assignment_item = false;
+        std::shared_ptr<lr_parsing_model::LR1Item> reduce_item;
+        for (const auto &item : state_items.second)
+        {
+            auto lr1_item = std::static_pointer_cast<lr_parsing_model::LR1Item>(item);
+            if (lr1_item->left_side_symbol().name == "S" && lr1_item->sequence_already_parsed().size() == 1 && lr1_item->sequence_already_parsed()[0].name == "L")
+            {
+                has_assignment_item = true;
+            }
+            if (lr1_item->left_side_symbol().name == "R" && lr1_item->sequence_to_parse().empty())
+            {
+                reduce_item = lr1_item;
+            }
+        }
+        if (!has_assignment_item)
+        {
+            continue;
+        }
+        found_state = true;
+        ASSERT_NE(reduce_item, nullptr);
+        ASSERT_EQ(reduce_item->lookahead_symbols().size(), 1u);
+        EXPECT_EQ(reduce_item->lookahead_symbols().begin()->special_property, "END");
+    }
+    EXPECT_TRUE(found_state);
+
+    lr_parsing_model::LRParsingTable parsing_table;
+    ASSERT_NO_THROW(parsing_table = generator.generate_parsing_table(cfg));
+    ASSERT_TRUE(parsing_table.filling_check()) << "Parsing table filling check failed";
+    EXPECT_TRUE(parsing_table.find_conflicts().empty());
+}
+
+// the grammar SLR(1) cannot handle, with an epsilon production and left recursion
+TEST_F(LALR1ParsingTableGeneratorTests, TestSLR1NonSolveableCFG)
+{
+    std::string filename = test_data_dir + "slr1_non_solveable_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    LALR1ParsingTableGenerator generator;
+    lr_parsing_model::LRParsingTable parsing_table;
+    ASSERT_NO_THROW(parsing_table = generator.generate_parsing_table(cfg));
+    ASSERT_TRUE(parsing_table.filling_check()) << "Parsing table filling check failed";
+    EXPECT_TRUE(parsing_table.find_conflicts().empty());
+
+    SLR1ParsingTableGenerator lr0_generator;
+    EXPECT_EQ(parsing_table.all_states.size(), lr0_generator.generate_item_set_dfa(cfg).dfa.states_set.size());
+
+    visualization_helper::pretty_print_parsing_table(parsing_table, true, "slr1_non_solveable_cfg_parsing_table_lalr1.md");
+}
+
+// LR(1) but not LALR(1), the merged state reduces both A -> c and B -> c on d and e
+TEST_F(LALR1ParsingTableGeneratorTests, TestReduceReduceConflictAfterMerge)
+{
+    std::string filename = test_data_dir + "not_lalr1_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    LR1ParsingTableGenerator lr1_generator;
+    EXPECT_NO_THROW(lr1_generator.generate_parsing_table(cfg));
+
+    LALR1ParsingTableGenerator generator;
+    EXPECT_THROW(generator.generate_parsing_table(cfg), std::runtime_error);
+}
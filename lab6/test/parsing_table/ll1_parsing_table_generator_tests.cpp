@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "ll1_parsing_table_generator.h"
+#include "ll_parsing_model.h"
+#include "testing_utils.h"
+#include "yaml_cfg_loader.h"
+#include "spdlog/spdlog.h"
+#include <string>
+#include <vector>
+
+// Test fixture for LL1ParsingTableGenerator
+class LL1ParsingTableGeneratorTests : public ::testing::Test
+{
+protected:
+    std::string test_data_dir = "test/data/parsing_table/ll1_parsing_table_generator/";
+    // When setting up the fixture, init the logger
+    static void SetUpTestSuite()
+    {
+        // Create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "ll1_parsing_table_generator_tests.log";
+        // Init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // When tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite()
+    {
+        release_fixture_logger();
+    }
+
+    // At the start of each test, log the test name
+    void SetUp() override
+    {
+        // Separate line
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+
+    // At the end of each test, log the test name
+    void TearDown() override
+    {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+
+    static cfg_model::symbol terminal(const std::string &name)
+    {
+        return {name, true, ""};
+    }
+
+    static cfg_model::symbol non_terminal(const std::string &name)
+    {
+        return {name, false, ""};
+    }
+};
+
+// the classic expression grammar is LL(1), check every cell of the table
+TEST_F(LL1ParsingTableGeneratorTests, TestExpressionGrammarTable)
+{
+    cfg_model::CFG cfg = load_test_cfg(test_data_dir + "expression_cfg.yml");
+
+    LL1ParsingTableGenerator generator;
+    ll_parsing_model::LL1ParsingTable table = generator.generate_parsing_table(cfg);
+
+    ASSERT_TRUE(generator.get_last_conflicts().empty());
+    ASSERT_TRUE(table.find_conflicts().empty());
+    EXPECT_EQ(table.start_symbol, non_terminal("E"));
+    EXPECT_EQ(table.end_symbol.special_property, "END");
+
+    auto expect_prediction = [&](const std::string &lhs, const cfg_model::symbol &lookahead, const std::vector<cfg_model::symbol> &rhs) {
+        const auto *predictions = table.get_predictions(non_terminal(lhs), lookahead);
+        ASSERT_NE(predictions, nullptr) << "M[" << lhs << ", " << lookahead.name << "] is empty";
+        ASSERT_EQ(predictions->size(), 1u);
+        EXPECT_EQ(*predictions->begin(), rhs) << "M[" << lhs << ", " << lookahead.name << "]";
+    };
+    auto expect_empty = [&](const std::string &lhs, const cfg_model::symbol &lookahead) {
+        EXPECT_EQ(table.get_predictions(non_terminal(lhs), lookahead), nullptr) << "M[" << lhs << ", " << lookahead.name << "] is not empty";
+    };
+
+    const cfg_model::symbol plus = terminal("+"), times = terminal("*"), lpa = terminal("("), rpa = terminal(")"), id = terminal("id");
+    const cfg_model::symbol end = table.end_symbol;
+    const std::vector<cfg_model::symbol> epsilon;
+
+    expect_prediction("E", lpa, {non_terminal("T"), non_terminal("E'")});
+    expect_prediction("E", id, {non_terminal("T"), non_terminal("E'")});
+    expect_empty("E", plus);
+    expect_prediction("E'", plus, {plus, non_terminal("T"), non_terminal("E'")});
+    expect_prediction("E'", rpa, epsilon);
+    expect_prediction("E'", end, epsilon);
+    expect_empty("E'", id);
+    expect_prediction("T", lpa, {non_terminal("F"), non_terminal("T'")});
+    expect_prediction("T", id, {non_terminal("F"), non_terminal("T'")});
+    expect_prediction("T'", times, {times, non_terminal("F"), non_terminal("T'")});
+    expect_prediction("T'", plus, epsilon);
+    expect_prediction("T'", rpa, epsilon);
+    expect_prediction("T'", end, epsilon);
+    expect_prediction("F", lpa, {lpa, non_terminal("E"), rpa});
+    expect_prediction("F", id, {id});
+    expect_empty("F", times);
+}
+
+// left recursion is never LL(1), the conflicts are reported but the table is still produced
+TEST_F(LL1ParsingTableGeneratorTests, TestLeftRecursionConflicts)
+{
+    cfg_model::CFG cfg = load_test_cfg(test_data_dir + "left_recursive_cfg.yml");
+
+    LL1ParsingTableGenerator generator;
+    ll_parsing_model::LL1ParsingTable table;
+    ASSERT_NO_THROW(table = generator.generate_parsing_table(cfg));
+
+    const auto &conflicts = generator.get_last_conflicts();
+    ASSERT_EQ(conflicts.size(), 2u);
+    // reported in (non-terminal, lookahead) name order
+    EXPECT_EQ(conflicts[0].non_terminal, non_terminal("E"));
+    EXPECT_EQ(conflicts[0].lookahead, terminal("("));
+    EXPECT_EQ(conflicts[1].non_terminal, non_terminal("E"));
+    EXPECT_EQ(conflicts[1].lookahead, terminal("id"));
+    for (const auto &conflict : conflicts)
+    {
+        ASSERT_EQ(conflict.candidate_rhs.size(), 2u);
+        EXPECT_EQ(conflict.candidate_rhs[0], (std::vector<cfg_model::symbol>{non_terminal("E"), terminal("+"), non_terminal("T")}));
+        EXPECT_EQ(conflict.candidate_rhs[1], (std::vector<cfg_model::symbol>{non_terminal("T")}));
+        spdlog::info("Reported conflict: {}", std::string(conflict));
+    }
+    EXPECT_EQ(table.find_conflicts().size(), conflicts.size());
+}
@@ -4,8 +4,13 @@
 #include "testing_utils.h"
 #include "yaml_cfg_loader.h"
 #include "spdlog/spdlog.h"
+#include <algorithm>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <chrono>
+#include <map>
+#include <set>
 
 // Test fixture for LR1ParsingTableGenerator
 class LR1ParsingTableGeneratorTests : public ::testing::Test
@@ -149,6 +154,398 @@ TEST_F(LR1ParsingTableGeneratorTests, TestResolveConflictsInSpecialCFG)
     visualization_helper::pretty_print_parsing_table(parsing_table, true, "slr1_non_solveable_cfg_parsing_table_lr1.md");
 }
 
+// the canonical LR(1) collection of S -> C C, C -> c C | d, every state only has transitions on the symbols after its dots
+TEST_F(LR1ParsingTableGeneratorTests, TestCanonicalCollectionShape)
+{
+    std::string filename = test_data_dir + "canonical_cc_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    LR1ParsingTableGenerator generator;
+    lr_parsing_model::LR1ItemSetDFAGenerationResult result = generator.generate_item_set_dfa(cfg);
+
+    ASSERT_EQ(result.dfa.states_set.size(), 10u);
+    size_t transition_count = 0;
+    for (const auto &state : result.dfa.states_set)
+    {
+        std::unordered_set<std::string> symbols_after_dot;
+        for (const auto &item : result.item_set_dfa_mapping.dfa_state_to_item_set.at(state))
+        {
+            if (!item->sequence_to_parse().empty())
+            {
+                symbols_after_dot.insert(result.item_set_dfa_mapping.item_set_symbol_to_dfa_character.at(item->sequence_to_parse()[0]));
+            }
+        }
+        std::unordered_set<std::string> transition_symbols;
+        auto row = result.dfa.transitions.find(state);
+        if (row != result.dfa.transitions.end())
+        {
+            for (const auto &transition : row->second)
+            {
+                transition_symbols.insert(transition.first);
+            }
+        }
+        EXPECT_EQ(transition_symbols, symbols_after_dot);
+        transition_count += transition_symbols.size();
+    }
+    // 4 out of the initial state, 3 out of each state that reads C, c or d next
+    EXPECT_EQ(transition_count, 13u);
+}
+
+// with Pager merging the same-core states of S -> C C, C -> c C | d all merge, as in LALR(1)
+TEST_F(LR1ParsingTableGeneratorTests, TestPagerMergingStateCount)
+{
+    std::string filename = test_data_dir + "canonical_cc_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    LR1ParsingTableGenerator generator;
+    generator.set_state_merging(LR1ParsingTableGenerator::StateMerging::PAGER_WEAK_COMPATIBILITY);
+    lr_parsing_model::LR1ItemSetDFAGenerationResult result = generator.generate_item_set_dfa(cfg);
+    EXPECT_EQ(result.dfa.states_set.size(), 7u);
+    EXPECT_GT(generator.get_last_merge_count(), 0u);
+
+    lr_parsing_model::LRParsingTable parsing_table = generator.generate_parsing_table(cfg);
+    EXPECT_EQ(parsing_table.all_states.size(), 7u);
+    ASSERT_TRUE(parsing_table.filling_check()) << "Parsing table filling check failed";
+    EXPECT_TRUE(parsing_table.find_conflicts().empty());
+
+    // canonical construction does not merge
+    generator.set_state_merging(LR1ParsingTableGenerator::StateMerging::CANONICAL);
+    EXPECT_EQ(generator.generate_item_set_dfa(cfg).dfa.states_set.size(), 10u);
+    EXPECT_EQ(generator.get_last_merge_count(), 0u);
+}
+
+// the two states reducing A -> c and B -> c are not weakly compatible, so they stay apart and no conflict appears
+TEST_F(LR1ParsingTableGeneratorTests, TestPagerMergingKeepsLR1Power)
+{
+    std::string filename = test_data_dir + "not_lalr1_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    LR1ParsingTableGenerator canonical_generator;
+    size_t canonical_state_count = canonical_generator.generate_parsing_table(cfg).all_states.size();
+
+    LR1ParsingTableGenerator generator;
+    generator.set_state_merging(LR1ParsingTableGenerator::StateMerging::PAGER_WEAK_COMPATIBILITY);
+    lr_parsing_model::LRParsingTable parsing_table;
+    ASSERT_NO_THROW(parsing_table = generator.generate_parsing_table(cfg));
+    EXPECT_EQ(parsing_table.all_states.size(), canonical_state_count);
+    EXPECT_EQ(generator.get_last_merge_count(), 0u);
+    ASSERT_TRUE(parsing_table.filling_check()) << "Parsing table filling check failed";
+    EXPECT_TRUE(parsing_table.find_conflicts().empty());
+
+    // the weak compatibility test itself: {d}, {e} against {e}, {d} meet across but never within
+    enum : size_t { d, e, f, terminal_count };
+    auto bits = [](std::initializer_list<size_t> terminals) {
+        cfg_model::TerminalSet result(terminal_count);
+        for (const auto terminal : terminals)
+        {
+            result.set(terminal);
+        }
+        return result;
+    };
+    EXPECT_FALSE(lr1_parsing_table_generator_helper::weakly_compatible({bits({d}), bits({e})}, {bits({e}), bits({d})}));
+    EXPECT_TRUE(lr1_parsing_table_generator_helper::weakly_compatible({bits({d}), bits({e})}, {bits({d, f}), bits({e})}));
+}
+
+// states are numbered in discovery order and identified by their kernels, item names are only built for display
+TEST_F(LR1ParsingTableGeneratorTests, TestKernelStateIdentity)
+{
+    std::string filename = test_data_dir + "canonical_cc_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+
+    LR1ParsingTableGenerator generator;
+    lr_parsing_model::LR1ItemSetDFAGenerationResult result = generator.generate_item_set_dfa(cfg);
+    EXPECT_EQ(result.dfa.initial_state, lr1_parsing_table_generator_helper::generate_lr1_state_name(0));
+    for (uint32_t state_id = 0; state_id < result.dfa.states_set.size(); ++state_id)
+    {
+        std::string state_name = lr1_parsing_table_generator_helper::generate_lr1_state_name(state_id);
+        ASSERT_EQ(result.dfa.states_set.count(state_name), 1u);
+        std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> closure;
+        // closures are core-merged, one item per LR(0) core, all sharing one lookahead set table
+        std::unordered_set<uint32_t> cores;
+        for (const auto &item : result.item_set_dfa_mapping.dfa_state_to_item_set.at(state_name))
+        {
+            auto lr1_item = std::static_pointer_cast<lr_parsing_model::LR1Item>(item);
+            EXPECT_TRUE(cores.insert(lr1_item->packed).second) << std::string(*lr1_item);
+            EXPECT_EQ(lr1_item->lookahead_table, std::static_pointer_cast<lr_parsing_model::LR1Item>(result.lr1_item_set.start_item)->lookahead_table);
+            closure.insert(lr1_item);
+        }
+        EXPECT_FALSE(lr1_parsing_table_generator_helper::generate_lr1_closure_name(closure).empty());
+    }
+
+    // equal lookahead sets intern to the same id whatever order they were filled in
+    cfg_model::CFG expanded_cfg = itemset_generator_helper::expand_cfg(cfg);
+    CFGAnalyzer analyzer(expanded_cfg);
+    auto lookahead_table = lr1_parsing_table_generator_helper::make_lookahead_set_table(analyzer);
+    std::vector<cfg_model::symbol> terminals(expanded_cfg.terminals.begin(), expanded_cfg.terminals.end());
+    std::unordered_set<cfg_model::symbol> forward(terminals.begin(), terminals.end());
+    std::unordered_set<cfg_model::symbol> backward(terminals.rbegin(), terminals.rend());
+    uint32_t all_terminals = lookahead_table->intern(forward);
+    EXPECT_EQ(all_terminals, lookahead_table->intern(backward));
+    EXPECT_EQ(lookahead_table->intern(std::unordered_set<cfg_model::symbol>{}), lr_parsing_model::LookaheadSetTable::empty_set);
+    EXPECT_EQ(lookahead_table->hash(all_terminals), lookahead_table->hash(lookahead_table->intern(backward)));
+    EXPECT_EQ(lookahead_table->symbols(all_terminals), forward);
+    EXPECT_EQ(lookahead_table->size(), 2u);
+    // union is a bitwise or of interned sets
+    uint32_t first_only = lookahead_table->intern(std::unordered_set<cfg_model::symbol>{terminals.front()});
+    uint32_t rest = lookahead_table->intern(std::unordered_set<cfg_model::symbol>(terminals.begin() + 1, terminals.end()));
+    EXPECT_EQ(lookahead_table->unite(first_only, rest), all_terminals);
+    EXPECT_EQ(lookahead_table->unite(all_terminals, first_only), all_terminals);
+    EXPECT_THROW(lookahead_table->intern(std::unordered_set<cfg_model::symbol>{expanded_cfg.start_symbol}), std::runtime_error);
+}
+
+TEST_F(LR1ParsingTableGeneratorTests, TestItemPoolHandles)
+{
+    std::string filename = test_data_dir + "complicated_cfg_1_with_conflict.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+    ItemSetGenerator item_set_generator;
+    lr_parsing_model::ItemSet lr0_item_set = item_set_generator.generate_item_set(cfg);
+    CFGAnalyzer analyzer(itemset_generator_helper::expand_cfg(cfg));
+
+    LR1ItemPool pool;
+    EXPECT_THROW(pool.intern(*lr0_item_set.start_item, lr_parsing_model::LookaheadSetTable::empty_set), std::runtime_error);
+    pool.reset(lr1_parsing_table_generator_helper::make_lookahead_set_table(analyzer));
+    std::vector<std::shared_ptr<lr_parsing_model::Item>> cores(lr0_item_set.items.begin(), lr0_item_set.items.end());
+    std::vector<uint32_t> lookahead_sets;
+    for (size_t bit = 0; bit < analyzer.getTerminalCount(); ++bit)
+    {
+        cfg_model::TerminalSet bits(analyzer.getTerminalCount());
+        bits.set(bit);
+        lookahead_sets.push_back(pool.get_lookahead_table()->intern(bits));
+    }
+
+    // every thread interns every (core, lookahead set) pair, starting at a different pair
+    const size_t thread_count = 4;
+    const size_t pair_count = cores.size() * lookahead_sets.size();
+    std::vector<std::vector<LR1ItemPool::Handle>> handles(thread_count, std::vector<LR1ItemPool::Handle>(pair_count));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (size_t n = 0; n < pair_count; ++n)
+            {
+                size_t pair = (n + t * pair_count / thread_count) % pair_count;
+                handles[t][pair] = pool.intern(*cores[pair / lookahead_sets.size()], lookahead_sets[pair % lookahead_sets.size()]);
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(pool.size(), pair_count);
+    std::unordered_set<LR1ItemPool::Handle> distinct_handles;
+    for (size_t pair = 0; pair < pair_count; ++pair)
+    {
+        for (size_t t = 1; t < thread_count; ++t)
+        {
+            ASSERT_EQ(handles[t][pair], handles[0][pair]);
+        }
+        distinct_handles.insert(handles[0][pair]);
+        const lr_parsing_model::LR1Item &item = pool.item(handles[0][pair]);
+        EXPECT_EQ(static_cast<const lr_parsing_model::Item &>(item), *cores[pair / lookahead_sets.size()]);
+        EXPECT_EQ(item.lookahead_set_id, lookahead_sets[pair % lookahead_sets.size()]);
+        // the shared_ptr API hands out the arena slot itself
+        EXPECT_EQ(pool.get_or_create(item).get(), &item);
+        EXPECT_EQ(pool.item_ptr(handles[0][pair]).get(), &item);
+    }
+    EXPECT_EQ(distinct_handles.size(), pair_count);
+
+    // items outlive a reset of the pool
+    std::shared_ptr<lr_parsing_model::LR1Item> kept = pool.item_ptr(handles[0][0]);
+    std::string kept_name = std::string(*kept);
+    pool.reset(lr1_parsing_table_generator_helper::make_lookahead_set_table(analyzer));
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(std::string(*kept), kept_name);
+}
+
+TEST_F(LR1ParsingTableGeneratorTests, TestClosureTemplates)
+{
+    std::string filename = test_data_dir + "canonical_cc_cfg.yml";
+    cfg_model::CFG cfg = load_test_cfg(filename);
+    ItemSetGenerator item_set_generator;
+    lr_parsing_model::ItemSet lr0_item_set = item_set_generator.generate_item_set(cfg);
+    CFGAnalyzer analyzer(itemset_generator_helper::expand_cfg(cfg));
+    analyzer.computeFirstSet();
+    analyzer.computeSuffixFirstSets();
+    lr1_parsing_table_generator_helper::LR0ItemIndex lr0_item_index(lr0_item_set);
+    lr1_parsing_table_generator_helper::LR1ClosureTemplates closure_templates(lr0_item_index, analyzer);
+    auto names = [&analyzer](const cfg_model::TerminalSet &bits) {
+        std::set<std::string> result;
+        bits.for_each([&](size_t bit) { result.insert(analyzer.getTerminalOfBit(bit).name); });
+        return result;
+    };
+    // item (as text) -> (spontaneous lookaheads, propagated)
+    auto describe = [&names](const std::vector<lr1_parsing_table_generator_helper::LR1ClosureTemplates::Entry> &entries) {
+        std::map<std::string, std::pair<std::set<std::string>, bool>> result;
+        for (const auto &entry : entries)
+        {
+            result[std::string(*entry.core)] = {names(entry.spontaneous), entry.propagated};
+        }
+        return result;
+    };
+    const cfg_model::symbol s{"S", false, ""};
+    const cfg_model::symbol c{"C", false, ""};
+    const cfg_model::symbol d{"d", true, ""};
+
+    // C -> · c C and C -> · d only ever see the lookaheads C was introduced with
+    auto c_template = describe(closure_templates.closure_template(c));
+    ASSERT_EQ(c_template.size(), 2u);
+    for (const auto &entry : c_template)
+    {
+        EXPECT_TRUE(entry.second.first.empty()) << entry.first;
+        EXPECT_TRUE(entry.second.second) << entry.first;
+    }
+    // S -> · C C propagates, the C items it introduces get FIRST(C) = {c, d} whatever S was introduced with
+    auto s_template = describe(closure_templates.closure_template(s));
+    ASSERT_EQ(s_template.size(), 3u);
+    size_t propagated_count = 0;
+    for (const auto &entry : s_template)
+    {
+        if (entry.second.second)
+        {
+            EXPECT_TRUE(entry.second.first.empty()) << entry.first;
+            propagated_count++;
+        }
+        else
+        {
+            EXPECT_EQ(entry.second.first, (std::set<std::string>{"c", "d"})) << entry.first;
+        }
+    }
+    EXPECT_EQ(propagated_count, 1u);
+    EXPECT_TRUE(closure_templates.closure_template(d).empty());
+    EXPECT_EQ(closure_templates.rule(*lr0_item_set.end_item), nullptr);
+
+    // closing S' -> · S with {d}: the template of S instantiated once
+    LR1ItemPool pool;
+    pool.reset(lr1_parsing_table_generator_helper::make_lookahead_set_table(analyzer));
+    cfg_model::TerminalSet d_only(analyzer.getTerminalCount());
+    d_only.set(pool.get_lookahead_table()->terminal_bit(d));
+    auto closure = lr1_parsing_table_generator_helper::grow_closure({pool.get_or_create(*lr0_item_set.start_item, d_only)}, closure_templates, pool);
+    ASSERT_EQ(closure.size(), 4u);
+    for (const auto &item : closure)
+    {
+        std::set<std::string> expected = item->left_side_symbol() == c ? std::set<std::string>{"c", "d"} : std::set<std::string>{"d"};
+        EXPECT_EQ(names(item->lookahead_bits()), expected) << std::string(*item);
+    }
+    // the overload over the LR(0) item set builds the same templates for the call
+    EXPECT_EQ(lr1_parsing_table_generator_helper::grow_closure({pool.get_or_create(*lr0_item_set.start_item, d_only)}, lr0_item_set, analyzer, pool), closure);
+    // the generator's own overload keeps closures as ascending pool handles
+    lr1_parsing_table_generator_helper::LR1ItemHandles kernel = {pool.intern(*lr0_item_set.start_item, d_only)};
+    lr1_parsing_table_generator_helper::LR1ItemHandles closure_handles = lr1_parsing_table_generator_helper::grow_closure(kernel, closure_templates, pool);
+    EXPECT_TRUE(std::is_sorted(closure_handles.begin(), closure_handles.end()));
+    std::unordered_set<std::shared_ptr<lr_parsing_model::LR1Item>> closure_items;
+    for (const auto handle : closure_handles)
+    {
+        closure_items.insert(pool.item_ptr(handle));
+    }
+    EXPECT_EQ(closure_items, closure);
+}
+
+namespace
+{
+    // statements over an expression grammar with level_count binary precedence levels
+    // expressions occur in many contexts (parentheses, argument lists, context_count bracket pairs), each with its own
+    // follow terminal, so the canonical automaton has many states sharing a core with different lookaheads
+    cfg_model::CFG make_precedence_cfg(int level_count, int context_count)
+    {
+        auto t = [](const std::string &name) { return cfg_model::symbol{name, true, ""}; };
+        auto nt = [](const std::string &name) { return cfg_model::symbol{name, false, ""}; };
+        auto level = [&nt](int i) { return nt("E" + std::to_string(i)); };
+        cfg_model::CFG cfg;
+        cfg.start_symbol = nt("S");
+        std::vector<std::vector<cfg_model::symbol>> productions_of_s = {{nt("S"), t(";"), nt("T")}, {nt("T")}};
+        cfg.production_rules[nt("S")] = {productions_of_s.begin(), productions_of_s.end()};
+        cfg.production_rules[nt("T")] = {
+            {t("id"), t("="), level(0)},
+            {t("if"), level(0), t("then"), nt("S"), t("end")},
+            {t("print"), t("("), nt("L"), t(")")},
+        };
+        cfg.production_rules[nt("L")] = {{level(0)}, {nt("L"), t(","), level(0)}};
+        for (int j = 0; j < context_count; ++j)
+        {
+            cfg.production_rules[nt("T")].insert({t("open" + std::to_string(j)), level(0), t("close" + std::to_string(j))});
+            cfg.terminals.insert(t("open" + std::to_string(j)));
+            cfg.terminals.insert(t("close" + std::to_string(j)));
+        }
+        for (int i = 0; i < level_count; ++i)
+        {
+            cfg.production_rules[level(i)] = {{level(i), t("op" + std::to_string(i)), level(i + 1)}, {level(i + 1)}};
+            cfg.terminals.insert(t("op" + std::to_string(i)));
+        }
+        cfg.production_rules[level(level_count)] = {{t("("), level(0), t(")")}, {t("id")}, {t("num")}, {t("-"), level(level_count)}};
+        for (const auto &rule : cfg.production_rules)
+        {
+            cfg.non_terminals.insert(rule.first);
+        }
+        for (const std::string name : {";", "id", "=", "if", "then", "end", "print", "(", ")", ",", "num", "-"})
+        {
+            cfg.terminals.insert(t(name));
+        }
+        cfg_model_helper::intern_cfg_symbols(cfg);
+        return cfg;
+    }
+
+    // states by name -> sorted item strings, transitions as they are
+    std::map<std::string, std::vector<std::string>> describe_states(const lr_parsing_model::LR1ItemSetDFAGenerationResult &result)
+    {
+        std::map<std::string, std::vector<std::string>> states;
+        for (const auto &state_items : result.item_set_dfa_mapping.dfa_state_to_item_set)
+        {
+            std::vector<std::string> &items = states[state_items.first];
+            for (const auto &item : state_items.second)
+            {
+                items.push_back(std::string(*std::static_pointer_cast<lr_parsing_model::LR1Item>(item)));
+            }
+            std::sort(items.begin(), items.end());
+        }
+        return states;
+    }
+}
+
+TEST_F(LR1ParsingTableGeneratorTests, TestParallelConstructionMatchesSequential)
+{
+    for (const std::string name : {"complicated_cfg_1_with_conflict.yml", "complicated_cfg_2_with_conflict.yml", "not_lalr1_cfg.yml"})
+    {
+        cfg_model::CFG cfg = load_test_cfg(test_data_dir + name);
+        LR1ParsingTableGenerator sequential_generator;
+        lr_parsing_model::LR1ItemSetDFAGenerationResult sequential = sequential_generator.generate_item_set_dfa(cfg);
+        LR1ParsingTableGenerator parallel_generator;
+        parallel_generator.set_thread_count(4);
+        lr_parsing_model::LR1ItemSetDFAGenerationResult parallel = parallel_generator.generate_item_set_dfa(cfg);
+        // same ids, same items, same edges
+        EXPECT_EQ(parallel.dfa.initial_state, sequential.dfa.initial_state) << name;
+        EXPECT_EQ(parallel.dfa.transitions, sequential.dfa.transitions) << name;
+        EXPECT_EQ(parallel.dfa.accepting_states, sequential.dfa.accepting_states) << name;
+        EXPECT_EQ(describe_states(parallel), describe_states(sequential)) << name;
+    }
+}
+
+TEST_F(LR1ParsingTableGeneratorTests, TestParallelConstructionScaling)
+{
+    cfg_model::CFG cfg = make_precedence_cfg(12, 48);
+    std::map<std::string, std::vector<std::string>> reference_states;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> reference_transitions;
+    for (unsigned thread_count : {1u, 2u, 4u, 8u, 16u})
+    {
+        LR1ParsingTableGenerator generator;
+        generator.set_thread_count(thread_count);
+        auto start = std::chrono::steady_clock::now();
+        lr_parsing_model::LR1ItemSetDFAGenerationResult result = generator.generate_item_set_dfa(cfg);
+        auto end = std::chrono::steady_clock::now();
+        spdlog::info("canonical LR(1) automaton of {} states: {} thread(s) {:.3f} ms", result.dfa.states_set.size(), thread_count,
+                     std::chrono::duration<double, std::milli>(end - start).count());
+        // the state ids do not depend on the thread count
+        if (thread_count == 1)
+        {
+            reference_states = describe_states(result);
+            reference_transitions = result.dfa.transitions;
+            continue;
+        }
+        ASSERT_EQ(result.dfa.transitions, reference_transitions) << thread_count << " thread(s)";
+        ASSERT_EQ(describe_states(result), reference_states) << thread_count << " thread(s)";
+    }
+}
+
 // // test solving final_semantic_correction
 // TEST_F(LR1ParsingTableGeneratorTests, TestResolveConflictsInFinalSemanticCorrection)
 // {
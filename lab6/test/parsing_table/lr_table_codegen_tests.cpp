@@ -0,0 +1,242 @@
+#include "gtest/gtest.h"
+#include "lr_table_codegen.h"
+#include "static_lr_parser.h"
+#include "ast_model.h"
+#include "final_semantic_lr1_table.h" // generated by tablegen at build time
+#include "testing_utils.h"
+#include "token_loader.h"
+#include "spdlog/spdlog.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Test fixture for LR tables generated as C++ headers
+class LRTableCodegenTests : public ::testing::Test
+{
+protected:
+    std::string test_data_dir = "test/data/parsing_table/lr_table_codegen/";
+    // When setting up the fixture, init the logger
+    static void SetUpTestSuite()
+    {
+        // Create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "lr_table_codegen_tests.log";
+        // Init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // When tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite()
+    {
+        release_fixture_logger();
+    }
+
+    // At the start of each test, log the test name
+    void SetUp() override
+    {
+        // Separate line
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+
+    // At the end of each test, log the test name
+    void TearDown() override
+    {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+};
+
+namespace
+{
+    using GeneratedTable = generated_lr_tables::FinalSemanticLR1Table;
+    using GeneratedParser = lr_parsing_model::StaticLRParser<GeneratedTable>;
+
+    lr_parsing_model::StoredLRTable stored_table(const std::string &grammar_path, lr_parsing_model::TableGeneratorKind generator)
+    {
+        lr_parsing_model::StoredLRTable table;
+        table.key.generator = generator;
+        table.key.grammar_hash = lr_table_file_helper::hash_grammar_file(grammar_path);
+        lr_parsing_model::LRParsingTable parsing_table = lr_table_file_helper::generate_parsing_table(load_test_cfg(grammar_path), generator);
+        table.compiled_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+        table.production_table = parsing_table.production_table;
+        return table;
+    }
+
+    // every shift and reduce a parser drives, in order
+    struct RecordingListener
+    {
+        std::vector<int64_t> events; // token index for a shift, -1 - production id for a reduce
+
+        void shift(size_t index) { events.push_back(static_cast<int64_t>(index)); }
+        void reduce(uint32_t production) { events.push_back(-1 - static_cast<int64_t>(production)); }
+    };
+
+    struct CountingListener
+    {
+        size_t shifts = 0, reduces = 0;
+
+        void shift(size_t) { shifts++; }
+        void reduce(uint32_t) { reduces++; }
+    };
+
+    // the terminals of a program with <copies> times the functions of complicated_tokens.txt, the end terminal included
+    std::vector<uint32_t> large_terminal_stream(size_t copies)
+    {
+        TokenLoader token_loader;
+        token_loader.load_from_file("test/data/syntax_semantic_analyzer/syntax_semantic_analyzer/complicated_tokens.txt");
+        const std::vector<Token> &tokens = token_loader.get_tokens();
+        // the file is one function declaration followed by a 3 token statement
+        std::vector<uint32_t> declaration, statement;
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            (i + 3 < tokens.size() ? declaration : statement).push_back(GeneratedParser::find_terminal(tokens[i].type));
+        }
+        std::vector<uint32_t> terminals;
+        terminals.reserve(copies * declaration.size() + statement.size() + 1);
+        for (size_t copy = 0; copy < copies; ++copy)
+        {
+            terminals.insert(terminals.end(), declaration.begin(), declaration.end());
+        }
+        terminals.insert(terminals.end(), statement.begin(), statement.end());
+        terminals.push_back(GeneratedTable::end_terminal);
+        return terminals;
+    }
+}
+
+// the header compiled into the tests holds the table the runtime generator builds from the same grammar
+TEST_F(LRTableCodegenTests, TestGeneratedTableMatchesRuntimeTable)
+{
+    std::string grammar_path = "test/data/syntax_semantic_analyzer/syntax_semantic_analyzer/final_semantic_correction.yml";
+    lr_parsing_model::StoredLRTable runtime_table = stored_table(grammar_path, lr_parsing_model::TableGeneratorKind::LR1);
+    const lr_parsing_model::CompiledLRTable &compiled_table = runtime_table.compiled_table;
+
+    EXPECT_EQ(std::string(GeneratedTable::generator), "lr1");
+    EXPECT_EQ(GeneratedTable::grammar_hash, runtime_table.key.grammar_hash);
+    ASSERT_EQ(GeneratedTable::state_count, compiled_table.state_count);
+    ASSERT_EQ(GeneratedTable::terminal_count, compiled_table.terminals.size());
+    ASSERT_EQ(GeneratedTable::non_terminal_count, compiled_table.non_terminals.size());
+    ASSERT_EQ(GeneratedTable::production_count, compiled_table.productions.size());
+    EXPECT_EQ(GeneratedTable::start_state, compiled_table.start_state);
+    EXPECT_EQ(GeneratedTable::end_terminal, compiled_table.end_terminal);
+
+    for (uint32_t state = 0; state < compiled_table.state_count; ++state)
+    {
+        for (uint32_t terminal = 0; terminal < compiled_table.terminals.size(); ++terminal)
+        {
+            EXPECT_EQ(GeneratedParser::action(state, terminal), compiled_table.action(state, terminal)) << state << " " << terminal;
+        }
+        for (uint32_t non_terminal = 0; non_terminal < compiled_table.non_terminals.size(); ++non_terminal)
+        {
+            EXPECT_EQ(GeneratedParser::goto_state(state, non_terminal), compiled_table.goto_state(state, non_terminal)) << state << " " << non_terminal;
+        }
+    }
+    for (uint32_t terminal = 0; terminal < compiled_table.terminals.size(); ++terminal)
+    {
+        EXPECT_EQ(GeneratedParser::find_terminal(compiled_table.terminals[terminal].name), terminal);
+    }
+    EXPECT_EQ(GeneratedParser::find_terminal("no such terminal"), lr_parsing_model::CompiledLRTable::invalid_id);
+
+    // every production but S' -> S builds an AST node, the names and ids agree
+    size_t productions_without_node = 0;
+    for (uint32_t id = 0; id < GeneratedTable::production_count; ++id)
+    {
+        EXPECT_EQ(GeneratedTable::production_lengths[id], compiled_table.productions[id].rhs_length) << id;
+        EXPECT_EQ(GeneratedTable::production_lhs[id], compiled_table.productions[id].lhs) << id;
+        std::string node_type = GeneratedTable::production_node_type_names[id];
+        if (node_type.empty())
+        {
+            EXPECT_EQ(GeneratedTable::production_node_types[id], lr_table_codegen_helper::no_node_type) << id;
+            productions_without_node++;
+        }
+        else
+        {
+            EXPECT_EQ(GeneratedTable::production_node_types[id], static_cast<int32_t>(ast_model::string_to_ast_node_type(node_type))) << id;
+        }
+    }
+    EXPECT_EQ(productions_without_node, 1u);
+
+    // the lookups are usable in constant expressions
+    static_assert(GeneratedParser::action(GeneratedTable::start_state, GeneratedTable::end_terminal) !=
+                      lr_parsing_model::CompiledLRTable::make_shift(0),
+                  "the start state cannot shift the end terminal");
+}
+
+TEST_F(LRTableCodegenTests, TestHeaderGeneration)
+{
+    lr_parsing_model::StoredLRTable table = stored_table(test_data_dir + "canonical_cc_cfg.yml", lr_parsing_model::TableGeneratorKind::LALR1);
+    lr_table_codegen_helper::TableHeaderOptions options;
+    options.table_name = "CanonicalCCTable";
+    options.node_type_names = {"ROOT"};
+    options.node_type_ids = {7};
+
+    // the same table gives the same text, so tablegen can skip rewriting an unchanged header
+    std::string header = lr_table_codegen_helper::generate_table_header(table, options);
+    EXPECT_EQ(lr_table_codegen_helper::generate_table_header(stored_table(test_data_dir + "canonical_cc_cfg.yml", lr_parsing_model::TableGeneratorKind::LALR1), options), header);
+    EXPECT_NE(header.find("#ifndef GENERATED_LR_TABLE_CANONICALCCTABLE_H"), std::string::npos);
+    EXPECT_NE(header.find("namespace generated_lr_tables"), std::string::npos);
+    EXPECT_NE(header.find("struct CanonicalCCTable"), std::string::npos);
+    EXPECT_NE(header.find("static constexpr uint32_t state_count = 7;"), std::string::npos);
+    EXPECT_NE(header.find("static constexpr const char *generator = \"lalr1\";"), std::string::npos);
+    EXPECT_NE(header.find("\"C -> c C\""), std::string::npos);
+    // productions past the given node types get none
+    EXPECT_NE(header.find("production_node_types[] = {\n        7, -1, -1, -1,\n"), std::string::npos);
+
+    options.table_name = "2Table";
+    EXPECT_THROW(lr_table_codegen_helper::generate_table_header(table, options), std::runtime_error);
+    options.table_name = "Canonical CC";
+    EXPECT_THROW(lr_table_codegen_helper::generate_table_header(table, options), std::runtime_error);
+    options.table_name = "CanonicalCCTable";
+    options.namespace_name = "";
+    EXPECT_THROW(lr_table_codegen_helper::generate_table_header(table, options), std::runtime_error);
+    options.namespace_name = "generated_lr_tables";
+    options.node_type_ids.assign(table.compiled_table.productions.size() + 1, 0);
+    EXPECT_THROW(lr_table_codegen_helper::generate_table_header(table, options), std::runtime_error);
+}
+
+// the generated recursive ascent code drives the parse of the table driver, shift for shift and reduce for reduce
+TEST_F(LRTableCodegenTests, TestRecursiveAscentMatchesTableDriver)
+{
+    using RecursiveAscentParser = GeneratedTable::RecursiveAscentParser;
+    std::vector<uint32_t> terminals = large_terminal_stream(20);
+    RecordingListener table_events, recursive_ascent_events;
+    GeneratedParser::parse(terminals, table_events);
+    RecursiveAscentParser::parse(terminals, recursive_ascent_events);
+    EXPECT_EQ(recursive_ascent_events.events, table_events.events);
+
+    // errors where the table driver has them
+    std::vector<uint32_t> bad_terminals = terminals;
+    bad_terminals.erase(bad_terminals.begin() + 3);
+    RecordingListener listener;
+    EXPECT_THROW(GeneratedParser::parse(bad_terminals, listener), std::runtime_error);
+    EXPECT_THROW(RecursiveAscentParser::parse(bad_terminals, listener), std::runtime_error);
+    bad_terminals = terminals;
+    bad_terminals.pop_back();
+    EXPECT_THROW(RecursiveAscentParser::parse(bad_terminals, listener), std::runtime_error);
+    bad_terminals = {GeneratedTable::end_terminal};
+    EXPECT_THROW(RecursiveAscentParser::parse(bad_terminals, listener), std::runtime_error);
+}
+
+// benchmark: the same large stream through the table driver and the recursive ascent code, parse only
+TEST_F(LRTableCodegenTests, TestRecursiveAscentBenchmark)
+{
+    using RecursiveAscentParser = GeneratedTable::RecursiveAscentParser;
+    std::vector<uint32_t> terminals = large_terminal_stream(5000);
+    const int runs = 5;
+    CountingListener table_counts, recursive_ascent_counts;
+    double table_ms = 0, recursive_ascent_ms = 0;
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        GeneratedParser::parse(terminals, table_counts);
+        auto middle = std::chrono::steady_clock::now();
+        RecursiveAscentParser::parse(terminals, recursive_ascent_counts);
+        auto end = std::chrono::steady_clock::now();
+        table_ms += std::chrono::duration<double, std::milli>(middle - start).count();
+        recursive_ascent_ms += std::chrono::duration<double, std::milli>(end - middle).count();
+    }
+    EXPECT_EQ(recursive_ascent_counts.shifts, table_counts.shifts);
+    EXPECT_EQ(recursive_ascent_counts.reduces, table_counts.reduces);
+    EXPECT_EQ(table_counts.shifts, runs * (terminals.size() - 1));
+    spdlog::info("{} terminals, {} reduces: table driver {:.3f} ms, recursive ascent {:.3f} ms (mean of {} runs)", terminals.size(),
+                 table_counts.reduces / runs, table_ms / runs, recursive_ascent_ms / runs, runs);
+}
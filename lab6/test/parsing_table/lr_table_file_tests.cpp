@@ -0,0 +1,274 @@
+#include "gtest/gtest.h"
+#include "lr_table_file.h"
+#include "testing_utils.h"
+#include "spdlog/spdlog.h"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Test fixture for binary LR table files
+class LRTableFileTests : public ::testing::Test
+{
+protected:
+    std::string test_data_dir = "test/data/parsing_table/lr_table_file/";
+    // When setting up the fixture, init the logger
+    static void SetUpTestSuite()
+    {
+        // Create a basic file logger, for now just store the logs in the current directory
+        std::string log_filename = "lr_table_file_tests.log";
+        // Init the logger
+        LoggingEnvironment::logger = init_fixture_logger(log_filename);
+    }
+
+    // When tearing down the fixture, flush and drop the logger
+    static void TearDownTestSuite()
+    {
+        release_fixture_logger();
+    }
+
+    // At the start of each test, log the test name
+    void SetUp() override
+    {
+        // Separate line
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_start_log(test_name);
+    }
+
+    // At the end of each test, log the test name
+    void TearDown() override
+    {
+        std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        add_test_end_log(test_name);
+    }
+};
+
+namespace
+{
+    void expect_same_comb_vector(const lr_parsing_model::CombVector &a, const lr_parsing_model::CombVector &b)
+    {
+        EXPECT_EQ(a.base, b.base);
+        EXPECT_EQ(a.values, b.values);
+        EXPECT_EQ(a.check, b.check);
+    }
+
+    void expect_same_table(const lr_parsing_model::StoredLRTable &a, const lr_parsing_model::StoredLRTable &b)
+    {
+        EXPECT_EQ(a.key, b.key);
+        const lr_parsing_model::CompiledLRTable &x = a.compiled_table, &y = b.compiled_table;
+        EXPECT_EQ(x.state_count, y.state_count);
+        EXPECT_EQ(x.start_state, y.start_state);
+        EXPECT_EQ(x.end_terminal, y.end_terminal);
+        EXPECT_EQ(x.state_names, y.state_names);
+        EXPECT_EQ(x.terminals, y.terminals);
+        EXPECT_EQ(x.terminal_ids_by_name, y.terminal_ids_by_name);
+        EXPECT_EQ(x.non_terminals, y.non_terminals);
+        EXPECT_EQ(x.non_terminal_ids, y.non_terminal_ids);
+        ASSERT_EQ(x.productions.size(), y.productions.size());
+        for (size_t id = 0; id < x.productions.size(); ++id)
+        {
+            EXPECT_EQ(x.productions[id].lhs, y.productions[id].lhs) << id;
+            EXPECT_EQ(x.productions[id].rhs_length, y.productions[id].rhs_length) << id;
+        }
+        EXPECT_EQ(x.default_actions, y.default_actions);
+        expect_same_comb_vector(x.action_rows, y.action_rows);
+        EXPECT_EQ(x.default_gotos, y.default_gotos);
+        expect_same_comb_vector(x.goto_columns, y.goto_columns);
+        ASSERT_NE(a.production_table, nullptr);
+        ASSERT_NE(b.production_table, nullptr);
+        ASSERT_EQ(a.production_table->size(), b.production_table->size());
+        for (uint32_t id = 0; id < a.production_table->size(); ++id)
+        {
+            EXPECT_EQ(a.production_table->production(id).lhs, b.production_table->production(id).lhs) << id;
+            EXPECT_EQ(a.production_table->production(id).rhs, b.production_table->production(id).rhs) << id;
+        }
+    }
+
+    void write_bytes(const std::string &path, const std::string &bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    std::string read_bytes(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+TEST_F(LRTableFileTests, TestRoundTrip)
+{
+    cfg_model::CFG cfg = load_test_cfg(test_data_dir + "canonical_cc_cfg.yml");
+    for (const std::string generator : {"simple_lr", "slr1", "lr1", "lr1_pager", "lalr1"})
+    {
+        SCOPED_TRACE(generator);
+        lr_parsing_model::LRTableFileKey key;
+        key.generator = lr_table_file_helper::parse_generator_name(generator);
+        key.grammar_hash = lr_table_file_helper::hash_grammar_file(test_data_dir + "canonical_cc_cfg.yml");
+        EXPECT_EQ(lr_table_file_helper::generator_name(key.generator), generator);
+
+        lr_parsing_model::LRParsingTable parsing_table = lr_table_file_helper::generate_parsing_table(cfg, key.generator);
+        lr_parsing_model::StoredLRTable expected;
+        expected.key = key;
+        expected.compiled_table = compiled_lr_table_helper::compile_lr_table(parsing_table);
+        expected.production_table = parsing_table.production_table;
+
+        std::string path = "lr_table_file_tests_" + generator + ".lrtable";
+        lr_table_file_helper::write_table_file(path, key, parsing_table);
+        lr_parsing_model::StoredLRTable loaded = lr_table_file_helper::read_table_file(path);
+        expect_same_table(expected, loaded);
+        // the mapped sections are the compiled arrays themselves
+        lr_parsing_model::MappedLRTableFile mapped_file(path);
+        size_t count = 0;
+        const int32_t *action_values = mapped_file.section<int32_t>(lr_parsing_model::ACTION_VALUES, count);
+        ASSERT_EQ(count, expected.compiled_table.action_rows.values.size());
+        EXPECT_TRUE(std::equal(action_values, action_values + count, expected.compiled_table.action_rows.values.begin()));
+    }
+    EXPECT_THROW(lr_table_file_helper::parse_generator_name("lr2"), std::runtime_error);
+}
+
+TEST_F(LRTableFileTests, TestLoadOrGenerate)
+{
+    std::string grammar_path = "lr_table_file_tests_grammar.yml";
+    std::string table_path = "lr_table_file_tests_cache/grammar.lrtable";
+    std::filesystem::remove_all("lr_table_file_tests_cache");
+    std::string grammar = read_bytes(test_data_dir + "canonical_cc_cfg.yml");
+    write_bytes(grammar_path, grammar);
+
+    // the first run generates and writes the file, the second one only reads it
+    lr_parsing_model::StoredLRTable generated = lr_table_file_helper::load_or_generate(grammar_path, lr_parsing_model::TableGeneratorKind::LR1, table_path);
+    ASSERT_TRUE(std::filesystem::exists(table_path));
+    std::string written = read_bytes(table_path);
+    lr_parsing_model::StoredLRTable loaded = lr_table_file_helper::load_or_generate(grammar_path, lr_parsing_model::TableGeneratorKind::LR1, table_path);
+    expect_same_table(generated, loaded);
+    EXPECT_EQ(read_bytes(table_path), written);
+    EXPECT_EQ(loaded.compiled_table.state_count, 10u);
+
+    // another generator is another key
+    lr_parsing_model::StoredLRTable lalr1 = lr_table_file_helper::load_or_generate(grammar_path, lr_parsing_model::TableGeneratorKind::LALR1, table_path);
+    EXPECT_EQ(lalr1.key.generator, lr_parsing_model::TableGeneratorKind::LALR1);
+    EXPECT_EQ(lalr1.compiled_table.state_count, 7u);
+    EXPECT_EQ(lr_table_file_helper::read_table_file(table_path).key, lalr1.key);
+
+    // so is any edit of the grammar file, even one that does not change the grammar
+    write_bytes(grammar_path, grammar + "# edited\n");
+    lr_parsing_model::StoredLRTable edited = lr_table_file_helper::load_or_generate(grammar_path, lr_parsing_model::TableGeneratorKind::LALR1, table_path);
+    EXPECT_NE(edited.key.grammar_hash, lalr1.key.grammar_hash);
+    EXPECT_EQ(lr_table_file_helper::read_table_file(table_path).key, edited.key);
+
+    // and a file written by generators of another version
+    std::string current = read_bytes(table_path);
+    std::string older = current;
+    uint32_t older_version = lr_parsing_model::table_generator_version - 1;
+    std::memcpy(&older[offsetof(lr_parsing_model::LRTableFileHeader, generator_version)], &older_version, sizeof(older_version));
+    write_bytes(table_path, older);
+    EXPECT_EQ(lr_table_file_helper::read_table_file(table_path).key.generator_version, older_version);
+    lr_table_file_helper::load_or_generate(grammar_path, lr_parsing_model::TableGeneratorKind::LALR1, table_path);
+    EXPECT_EQ(read_bytes(table_path), current);
+}
+
+TEST_F(LRTableFileTests, TestFailedWriteLeavesNoTemporaryFile)
+{
+    // a non-empty directory in place of the table file, the rename over it fails
+    std::string table_dir = "lr_table_file_tests_blocked";
+    std::filesystem::remove_all(table_dir);
+    std::string table_path = table_dir + "/grammar.lrtable";
+    std::filesystem::create_directories(table_path + "/occupied");
+    EXPECT_THROW(lr_table_file_helper::load_or_generate(test_data_dir + "canonical_cc_cfg.yml", lr_parsing_model::TableGeneratorKind::SLR1, table_path),
+                 std::runtime_error);
+    size_t entry_count = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(table_dir))
+    {
+        EXPECT_EQ(entry.path().filename().string(), "grammar.lrtable");
+        entry_count++;
+    }
+    EXPECT_EQ(entry_count, 1u);
+    std::filesystem::remove_all(table_dir);
+}
+
+TEST_F(LRTableFileTests, TestRejectsDamagedFiles)
+{
+    std::string grammar_path = test_data_dir + "canonical_cc_cfg.yml";
+    std::string table_path = "lr_table_file_tests_damaged.lrtable";
+    lr_parsing_model::StoredLRTable generated = lr_table_file_helper::load_or_generate(grammar_path, lr_parsing_model::TableGeneratorKind::SLR1, table_path);
+    std::string bytes = read_bytes(table_path);
+
+    std::string truncated = bytes.substr(0, bytes.size() - 8);
+    write_bytes(table_path, truncated);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+
+    std::string wrong_magic = bytes;
+    wrong_magic[0] = 'X';
+    write_bytes(table_path, wrong_magic);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+
+    std::string wrong_version = bytes;
+    wrong_version[offsetof(lr_parsing_model::LRTableFileHeader, format_version)] += 1;
+    write_bytes(table_path, wrong_version);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+
+    // a comb vector base past the padding would make lookups read out of bounds
+    std::string bad_base = bytes;
+    lr_parsing_model::LRTableFileSection action_base;
+    std::memcpy(&action_base, bytes.data() + sizeof(lr_parsing_model::LRTableFileHeader) + sizeof(action_base) * lr_parsing_model::ACTION_BASE, sizeof(action_base));
+    uint32_t huge_base = 1u << 20;
+    std::memcpy(&bad_base[action_base.offset], &huge_base, sizeof(huge_base));
+    write_bytes(table_path, bad_base);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+
+    // a valid layout with out-of-range targets would make the driver index past its tables
+    auto read_section = [&bytes](lr_parsing_model::LRTableFileSectionId id) {
+        lr_parsing_model::LRTableFileSection entry;
+        std::memcpy(&entry, bytes.data() + sizeof(lr_parsing_model::LRTableFileHeader) + sizeof(entry) * id, sizeof(entry));
+        return entry;
+    };
+    auto write_word = [&](lr_parsing_model::LRTableFileSectionId id, size_t index, uint32_t value) {
+        std::string damaged = bytes;
+        std::memcpy(&damaged[read_section(id).offset + index * sizeof(uint32_t)], &value, sizeof(value));
+        write_bytes(table_path, damaged);
+    };
+    const lr_parsing_model::CompiledLRTable &compiled_table = generated.compiled_table;
+    uint32_t bad_shift = static_cast<uint32_t>(lr_parsing_model::CompiledLRTable::make_shift(compiled_table.state_count));
+    uint32_t bad_reduce = static_cast<uint32_t>(lr_parsing_model::CompiledLRTable::make_reduce(static_cast<uint32_t>(compiled_table.productions.size())));
+    write_word(lr_parsing_model::DEFAULT_ACTIONS, 0, bad_shift);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+    write_word(lr_parsing_model::DEFAULT_ACTIONS, 0, bad_reduce);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+    size_t used_action_slot = 0;
+    while (compiled_table.action_rows.check[used_action_slot] == lr_parsing_model::CombVector::empty_slot)
+    {
+        used_action_slot++;
+    }
+    write_word(lr_parsing_model::ACTION_VALUES, used_action_slot, bad_shift);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+    // a reduced production whose lhs is gone, the reduces of this table are all default actions
+    uint32_t reduce_state = 0;
+    while (reduce_state < compiled_table.state_count &&
+           lr_parsing_model::CompiledLRTable::action_kind(compiled_table.default_actions[reduce_state]) != lr_parsing_model::CompiledLRTable::REDUCE)
+    {
+        reduce_state++;
+    }
+    ASSERT_LT(reduce_state, compiled_table.state_count);
+    uint32_t reduced_production = lr_parsing_model::CompiledLRTable::action_value(compiled_table.default_actions[reduce_state]);
+    write_word(lr_parsing_model::PRODUCTIONS, reduced_production * 3, lr_parsing_model::CompiledLRTable::invalid_id);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+    write_word(lr_parsing_model::DEFAULT_GOTOS, 0, compiled_table.state_count);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+    size_t used_goto_slot = 0;
+    while (compiled_table.goto_columns.check[used_goto_slot] == lr_parsing_model::CombVector::empty_slot)
+    {
+        used_goto_slot++;
+    }
+    write_word(lr_parsing_model::GOTO_VALUES, used_goto_slot, compiled_table.state_count);
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+
+    write_bytes(table_path, "");
+    EXPECT_THROW(lr_table_file_helper::read_table_file(table_path), std::runtime_error);
+
+    // a damaged file is regenerated instead of failing the run
+    lr_parsing_model::StoredLRTable regenerated = lr_table_file_helper::load_or_generate(grammar_path, lr_parsing_model::TableGeneratorKind::SLR1, table_path);
+    expect_same_table(generated, regenerated);
+    EXPECT_EQ(read_bytes(table_path), bytes);
+}
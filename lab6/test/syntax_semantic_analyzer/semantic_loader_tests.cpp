@@ -45,3 +45,17 @@ TEST_F(SemanticLoaderTest, BasicLoadTest) {
     ASSERT_NO_THROW(load_semantic_info(test_data_path, cfg));
 };
 
+
+// node types by production id are the ones of the hashed lookup
+TEST_F(SemanticLoaderTest, NodeTypesByProductionId) {
+    std::string test_data_path = test_data_dir + "final_semantic.yml";
+    cfg_model::CFG cfg = load_test_cfg(test_data_path);
+    syntax_semantic_model::ProductionInfoMapping production_info_mapping = load_semantic_info(test_data_path, cfg);
+    ASSERT_EQ(production_info_mapping.node_types.size(), cfg.production_numbering.size());
+    for (cfg_model::production_id production = 0; production < cfg.production_numbering.size(); ++production) {
+        const cfg_model::symbol& lhs = cfg.production_numbering.lhs_of(production);
+        const std::vector<cfg_model::symbol>& rhs = cfg.production_numbering.rhs_of(production);
+        EXPECT_EQ(production_info_mapping.get_node_type(production), production_info_mapping.get_node_type(lhs, rhs)) << lhs.name;
+    }
+    EXPECT_THROW(production_info_mapping.get_node_type(static_cast<cfg_model::production_id>(cfg.production_numbering.size())), std::runtime_error);
+}
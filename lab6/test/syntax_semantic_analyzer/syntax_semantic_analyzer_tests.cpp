@@ -9,8 +9,12 @@
 #include "cfg/cfg_model.h"
 #include "parsing_table/simple_lr_parsing_table_generator.h"
 #include "parsing_table/lr1_parsing_table_generator.h"
+#include "parsing_table/lalr1_parsing_table_generator.h"
+#include "parsing_table/ll1_parsing_table_generator.h"
 #include "syntax_semantic_analyzer/interm_code_generator.h"
+#include "final_semantic_lr1_table.h" // generated by tablegen at build time
 #include "spdlog/spdlog.h"
+#include <chrono>
 
 // Fixture for SyntaxSemanticAnalyzer tests
 class SyntaxSemanticAnalyzerTest : public ::testing::Test
@@ -390,4 +394,209 @@ TEST_F(SyntaxSemanticAnalyzerTest, IntegrationTestHw8ComplicatedTokens)
         visualization_helper::generate_ast_tree_dot_file(result.ast_tree, ast_tree_result_file_name, true);
     }
 
-}
\ No newline at end of file
+}
+
+// the LL(1) driver must build the same AST as the LR(1) driver on an LL(1) grammar
+TEST_F(SyntaxSemanticAnalyzerTest, LL1DriverBuildsSameASTAsLR1Driver)
+{
+    std::string ll1_cfg_file = test_data_dir + "ll1_decl_stat.yml";
+    cfg_model::CFG ll1_cfg = load_test_cfg(ll1_cfg_file);
+    syntax_semantic_model::ProductionInfoMapping production_info_mapping = load_semantic_info(ll1_cfg_file, ll1_cfg);
+
+    TokenLoader token_loader;
+    token_loader.load_from_file(test_data_dir + "ll1_decl_stat_tokens.txt");
+
+    LL1ParsingTableGenerator ll1_generator;
+    ll_parsing_model::LL1ParsingTable ll1_parsing_table = ll1_generator.generate_parsing_table(ll1_cfg);
+    ASSERT_TRUE(ll1_generator.get_last_conflicts().empty());
+    LR1ParsingTableGenerator lr1_generator;
+    lr_parsing_model::LRParsingTable ll1_grammar_lr1_table = lr1_generator.generate_parsing_table(ll1_cfg);
+
+    SyntaxSemanticAnalyzer lr_analyzer;
+    lr_analyzer.prepair_new_analysis(ll1_grammar_lr1_table, production_info_mapping, token_loader.get_tokens());
+    auto lr_ast_tree = lr_analyzer.get_blank_ast_tree();
+
+    SyntaxSemanticAnalyzer ll_analyzer;
+    ll_analyzer.prepair_new_ll1_analysis(ll1_parsing_table, production_info_mapping, token_loader.get_tokens());
+    ll_analyzer.ll1_syntax_analysis();
+    auto ll_ast_tree = ll_analyzer.current_ast_tree;
+
+    // same shape and node types in pre-order
+    ASSERT_EQ(lr_ast_tree.size(), ll_ast_tree.size());
+    auto lr_it = lr_ast_tree.begin();
+    auto ll_it = ll_ast_tree.begin();
+    for (; lr_it != lr_ast_tree.end() && ll_it != ll_ast_tree.end(); ++lr_it, ++ll_it) {
+        EXPECT_EQ(lr_ast_tree.depth(lr_it), ll_ast_tree.depth(ll_it));
+        EXPECT_EQ((*lr_it)->node_type, (*ll_it)->node_type);
+        EXPECT_EQ((*lr_it)->to_string(), (*ll_it)->to_string());
+    }
+    visualization_helper::generate_ast_tree_dot_file(ll_ast_tree, "integration_ll1_decl_stat_ast_tree_blank", true);
+
+    // an unexpected token is reported instead of silently recovering
+    std::vector<Token> bad_tokens = token_loader.get_tokens();
+    bad_tokens.erase(bad_tokens.begin() + 2); // drop the first SCO
+    ll_analyzer.prepair_new_ll1_analysis(ll1_parsing_table, production_info_mapping, bad_tokens);
+    EXPECT_THROW(ll_analyzer.ll1_syntax_analysis(), std::runtime_error);
+}
+
+// both tables parse the tokens into the same blank AST, node by node in pre-order
+static void expect_same_blank_ast(const lr_parsing_model::LRParsingTable &expected_table,
+                                  const lr_parsing_model::LRParsingTable &actual_table,
+                                  const syntax_semantic_model::ProductionInfoMapping &production_info_mapping,
+                                  const std::vector<Token> &tokens)
+{
+    SyntaxSemanticAnalyzer expected_analyzer;
+    expected_analyzer.prepair_new_analysis(expected_table, production_info_mapping, tokens);
+    auto expected_ast_tree = expected_analyzer.get_blank_ast_tree();
+
+    SyntaxSemanticAnalyzer actual_analyzer;
+    actual_analyzer.prepair_new_analysis(actual_table, production_info_mapping, tokens);
+    auto actual_ast_tree = actual_analyzer.get_blank_ast_tree();
+
+    ASSERT_EQ(expected_ast_tree.size(), actual_ast_tree.size());
+    auto expected_it = expected_ast_tree.begin();
+    auto actual_it = actual_ast_tree.begin();
+    for (; expected_it != expected_ast_tree.end() && actual_it != actual_ast_tree.end(); ++expected_it, ++actual_it) {
+        EXPECT_EQ(expected_ast_tree.depth(expected_it), actual_ast_tree.depth(actual_it));
+        EXPECT_EQ((*expected_it)->node_type, (*actual_it)->node_type);
+        EXPECT_EQ((*expected_it)->to_string(), (*actual_it)->to_string());
+    }
+}
+
+// the LALR(1) table of the full grammar has fewer states but drives the same parse as the LR(1) one
+TEST_F(SyntaxSemanticAnalyzerTest, LALR1TableBuildsSameASTAsLR1Table)
+{
+    TokenLoader token_loader;
+    token_loader.load_from_file(test_data_dir + "complicated_tokens.txt");
+    syntax_semantic_model::ProductionInfoMapping production_info_mapping = load_semantic_info(cfg_semantic_file, cfg);
+
+    LALR1ParsingTableGenerator lalr1_generator;
+    lr_parsing_model::LRParsingTable lalr1_parsing_table = lalr1_generator.generate_parsing_table(cfg);
+    EXPECT_LT(lalr1_parsing_table.all_states.size(), lr1_parsing_table.all_states.size());
+
+    expect_same_blank_ast(lr1_parsing_table, lalr1_parsing_table, production_info_mapping, token_loader.get_tokens());
+}
+
+// same for the LR(1) table with Pager merging, no larger than canonical and no smaller than LALR(1)
+TEST_F(SyntaxSemanticAnalyzerTest, PagerMergedTableBuildsSameASTAsLR1Table)
+{
+    TokenLoader token_loader;
+    token_loader.load_from_file(test_data_dir + "complicated_tokens.txt");
+    syntax_semantic_model::ProductionInfoMapping production_info_mapping = load_semantic_info(cfg_semantic_file, cfg);
+
+    LR1ParsingTableGenerator merging_generator;
+    merging_generator.set_state_merging(LR1ParsingTableGenerator::StateMerging::PAGER_WEAK_COMPATIBILITY);
+    lr_parsing_model::LRParsingTable merged_parsing_table = merging_generator.generate_parsing_table(cfg);
+    LALR1ParsingTableGenerator lalr1_generator;
+    size_t lalr1_state_count = lalr1_generator.generate_parsing_table(cfg).all_states.size();
+    EXPECT_LT(merged_parsing_table.all_states.size(), lr1_parsing_table.all_states.size());
+    EXPECT_GE(merged_parsing_table.all_states.size(), lalr1_state_count);
+    EXPECT_GT(merging_generator.get_last_merge_count(), 0u);
+
+    expect_same_blank_ast(lr1_parsing_table, merged_parsing_table, production_info_mapping, token_loader.get_tokens());
+}
+
+// a table compiled once drives any number of parses, default reductions still stop at a syntax error
+TEST_F(SyntaxSemanticAnalyzerTest, CompiledTableDrivesParses)
+{
+    TokenLoader token_loader;
+    token_loader.load_from_file(test_data_dir + "complicated_tokens.txt");
+    syntax_semantic_model::ProductionInfoMapping production_info_mapping = load_semantic_info(cfg_semantic_file, cfg);
+    lr_parsing_model::CompiledLRTable compiled_table = compiled_lr_table_helper::compile_lr_table(lr1_parsing_table);
+
+    SyntaxSemanticAnalyzer expected_analyzer;
+    expected_analyzer.prepair_new_analysis(lr1_parsing_table, production_info_mapping, token_loader.get_tokens());
+    auto expected_ast_tree = expected_analyzer.get_blank_ast_tree();
+    SyntaxSemanticAnalyzer compiled_analyzer;
+    for (int run = 0; run < 2; ++run) {
+        compiled_analyzer.prepair_new_analysis(compiled_table, production_info_mapping, token_loader.get_tokens());
+        auto compiled_ast_tree = compiled_analyzer.get_blank_ast_tree();
+        ASSERT_EQ(expected_ast_tree.size(), compiled_ast_tree.size());
+        auto expected_it = expected_ast_tree.begin();
+        auto compiled_it = compiled_ast_tree.begin();
+        for (; expected_it != expected_ast_tree.end(); ++expected_it, ++compiled_it) {
+            EXPECT_EQ((*expected_it)->to_string(), (*compiled_it)->to_string());
+        }
+        EXPECT_EQ(compiled_analyzer.current_state_stack.size(), 2u);
+    }
+
+    std::vector<Token> bad_tokens = token_loader.get_tokens();
+    bad_tokens.erase(bad_tokens.begin() + 3);
+    compiled_analyzer.prepair_new_analysis(compiled_table, production_info_mapping, bad_tokens);
+    EXPECT_THROW(compiled_analyzer.syntax_anlaysis(), std::runtime_error);
+}
+
+// the table generated into a header at build time builds the same AST as the runtime table, and the same symbols
+TEST_F(SyntaxSemanticAnalyzerTest, GeneratedTableBuildsSameASTAsRuntimeTable)
+{
+    TokenLoader token_loader;
+    token_loader.load_from_file(test_data_dir + "complicated_tokens.txt");
+    syntax_semantic_model::ProductionInfoMapping production_info_mapping = load_semantic_info(cfg_semantic_file, cfg);
+
+    SyntaxSemanticAnalyzer expected_analyzer;
+    syntax_semantic_analyzer::analysis_result expected = expected_analyzer.analyze_syntax_semantics(lr1_parsing_table, production_info_mapping, token_loader.get_tokens());
+    SyntaxSemanticAnalyzer generated_analyzer;
+    syntax_semantic_analyzer::analysis_result generated = generated_analyzer.analyze_syntax_semantics_static<generated_lr_tables::FinalSemanticLR1Table>(token_loader.get_tokens());
+
+    ASSERT_EQ(expected.ast_tree.size(), generated.ast_tree.size());
+    auto expected_it = expected.ast_tree.begin();
+    auto generated_it = generated.ast_tree.begin();
+    for (; expected_it != expected.ast_tree.end(); ++expected_it, ++generated_it) {
+        EXPECT_EQ(expected.ast_tree.depth(expected_it), generated.ast_tree.depth(generated_it));
+        EXPECT_EQ((*expected_it)->node_type, (*generated_it)->node_type);
+        EXPECT_EQ((*expected_it)->to_string(), (*generated_it)->to_string());
+    }
+    EXPECT_EQ(expected.symbol_table.symbols.size(), generated.symbol_table.symbols.size());
+
+    std::vector<Token> bad_tokens = token_loader.get_tokens();
+    bad_tokens.erase(bad_tokens.begin() + 3);
+    EXPECT_THROW(generated_analyzer.static_syntax_analysis<generated_lr_tables::FinalSemanticLR1Table>(bad_tokens), std::runtime_error);
+}
+
+// the recursive ascent parser generated from the same table builds the same AST as syntax_anlaysis,
+// benchmarked against it on a large token stream
+TEST_F(SyntaxSemanticAnalyzerTest, RecursiveAscentBuildsSameASTAsTableDriver)
+{
+    using GeneratedTable = generated_lr_tables::FinalSemanticLR1Table;
+    TokenLoader token_loader;
+    token_loader.load_from_file(test_data_dir + "complicated_tokens.txt");
+    syntax_semantic_model::ProductionInfoMapping production_info_mapping = load_semantic_info(cfg_semantic_file, cfg);
+    lr_parsing_model::CompiledLRTable compiled_table = compiled_lr_table_helper::compile_lr_table(lr1_parsing_table);
+
+    // many copies of the function declaration, then the closing statement (the last 3 tokens)
+    // kept to a hundred: grafting the ever growing declaration list copies it, AST building is quadratic in its length
+    const std::vector<Token> &tokens = token_loader.get_tokens();
+    std::vector<Token> large_tokens;
+    for (int copy = 0; copy < 100; ++copy) {
+        large_tokens.insert(large_tokens.end(), tokens.begin(), tokens.end() - 3);
+    }
+    large_tokens.insert(large_tokens.end(), tokens.end() - 3, tokens.end());
+
+    SyntaxSemanticAnalyzer table_analyzer;
+    table_analyzer.prepair_new_analysis(compiled_table, production_info_mapping, large_tokens);
+    auto start = std::chrono::steady_clock::now();
+    table_analyzer.syntax_anlaysis();
+    auto middle = std::chrono::steady_clock::now();
+    SyntaxSemanticAnalyzer recursive_ascent_analyzer;
+    recursive_ascent_analyzer.static_syntax_analysis<GeneratedTable, GeneratedTable::RecursiveAscentParser>(large_tokens);
+    auto end = std::chrono::steady_clock::now();
+    spdlog::info("{} tokens to AST: table driver {:.3f} ms, recursive ascent {:.3f} ms", large_tokens.size(),
+                 std::chrono::duration<double, std::milli>(middle - start).count(), std::chrono::duration<double, std::milli>(end - middle).count());
+
+    const auto &expected_ast_tree = table_analyzer.current_ast_tree;
+    const auto &actual_ast_tree = recursive_ascent_analyzer.current_ast_tree;
+    ASSERT_EQ(expected_ast_tree.size(), actual_ast_tree.size());
+    auto expected_it = expected_ast_tree.begin();
+    auto actual_it = actual_ast_tree.begin();
+    for (; expected_it != expected_ast_tree.end(); ++expected_it, ++actual_it) {
+        ASSERT_EQ(expected_ast_tree.depth(expected_it), actual_ast_tree.depth(actual_it));
+        ASSERT_EQ((*expected_it)->to_string(), (*actual_it)->to_string());
+    }
+
+    // and the whole analysis on the original program
+    syntax_semantic_analyzer::analysis_result result = recursive_ascent_analyzer.analyze_syntax_semantics_static<GeneratedTable, GeneratedTable::RecursiveAscentParser>(tokens);
+    EXPECT_FALSE(result.symbol_table.symbols.empty());
+    std::vector<Token> bad_tokens = tokens;
+    bad_tokens.erase(bad_tokens.begin() + 3);
+    EXPECT_THROW((recursive_ascent_analyzer.static_syntax_analysis<GeneratedTable, GeneratedTable::RecursiveAscentParser>(bad_tokens)), std::runtime_error);
+}